@@ -24,6 +24,9 @@
 
 #include "sigcxx/macros.hpp"
 
+#include <cstddef>
+#include <type_traits>
+
 namespace sigcxx {
 
 /**
@@ -97,6 +100,12 @@ class WIZTK_EXPORT BinodeBase {
     */
   BinodeBase() = default;
 
+  /**
+   * @brief Constructor with the neighbours already known, usable in a constant expression.
+   */
+  constexpr BinodeBase(BinodeBase *previous, BinodeBase *next)
+      : previous_(previous), next_(next) {}
+
   BinodeBase *previous_ = nullptr;
   BinodeBase *next_ = nullptr;
 
@@ -132,6 +141,12 @@ class WIZTK_EXPORT Binode : public BinodeBase {
    */
   Binode(Binode &&) noexcept = default;
 
+  /**
+   * @brief Constructor with the neighbours already known, usable in a constant expression.
+   */
+  constexpr Binode(T *previous, T *next)
+      : BinodeBase(previous, next) {}
+
   /**
    * @brief Destructor.
    */
@@ -180,6 +195,640 @@ class WIZTK_EXPORT Binode : public BinodeBase {
 
 };
 
+/**
+ * @ingroup base
+ * @brief An intrusive double-ended queue.
+ * @tparam T The node type, derived from BinodeBase, e.g. a subclass of Binode<T>
+ *
+ * The deque links the nodes it's given, it never allocates or deletes them.
+ * A node is in one deque at most: pushing it unlinks it from where it was,
+ * and a node unlinked with Binode::unlink() or destroyed leaves its deque by
+ * itself. Nodes left in the deque when it's destroyed are unlinked.
+ *
+ * A node can be unlinked or destroyed during an iteration once the iterator
+ * has moved past it, erase() returns the iterator to the next node:
+ * @code
+ * for (auto it = deque.begin(); it != deque.end();) {
+ *   if (it->done()) {
+ *     it = deque.erase(it);
+ *   } else {
+ *     ++it;
+ *   }
+ * }
+ * @endcode
+ */
+template<typename T>
+class WIZTK_EXPORT Deque {
+
+ public:
+
+  /**
+   * @brief Declare this class is non-copyable and non-movable.
+   */
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Deque);
+
+  /**
+   * @brief Iterator.
+   */
+  class Iterator {
+
+    friend class Deque;
+
+   public:
+
+    Iterator() = delete;
+
+    explicit Iterator(BinodeBase *node)
+        : current_(node) {}
+
+    ~Iterator() = default;
+
+    Iterator &operator++() {
+      current_ = current_->next_;
+      return *this;
+    }
+
+    Iterator &operator--() {
+      current_ = current_->previous_;
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const { return current_ == other.current_; }
+    bool operator!=(const Iterator &other) const { return current_ != other.current_; }
+
+    T *get() const {
+      return static_cast<T *>(current_);
+    }
+
+    T *operator->() const { return get(); }
+
+    T &operator*() const { return *get(); }
+
+    /**
+     * @brief Returns true if this iterator is on a node, not on an end of the deque
+     */
+    explicit operator bool() const {
+      return nullptr == current_ ?
+             false : (nullptr == current_->previous_ ?
+                      false : (nullptr != current_->next_));
+    }
+
+   private:
+
+    BinodeBase *current_ = nullptr;
+
+  };
+
+  /**
+   * @brief Const iterator.
+   */
+  class ConstIterator {
+
+   public:
+
+    ConstIterator() = delete;
+
+    explicit ConstIterator(const BinodeBase *node)
+        : current_(node) {}
+
+    ~ConstIterator() = default;
+
+    ConstIterator &operator++() {
+      current_ = current_->next_;
+      return *this;
+    }
+
+    ConstIterator &operator--() {
+      current_ = current_->previous_;
+      return *this;
+    }
+
+    bool operator==(const ConstIterator &other) const { return current_ == other.current_; }
+    bool operator!=(const ConstIterator &other) const { return current_ != other.current_; }
+
+    const T *get() const {
+      return static_cast<const T *>(current_);
+    }
+
+    const T *operator->() const { return get(); }
+
+    const T &operator*() const { return *get(); }
+
+    explicit operator bool() const {
+      return nullptr == current_ ?
+             false : (nullptr == current_->previous_ ?
+                      false : (nullptr != current_->next_));
+    }
+
+   private:
+
+    const BinodeBase *current_ = nullptr;
+
+  };
+
+  /**
+   * @brief Reverse iterator.
+   */
+  class ReverseIterator {
+
+    friend class Deque;
+
+   public:
+
+    ReverseIterator() = delete;
+
+    explicit ReverseIterator(BinodeBase *node)
+        : current_(node) {}
+
+    ~ReverseIterator() = default;
+
+    ReverseIterator &operator++() {
+      current_ = current_->previous_;
+      return *this;
+    }
+
+    ReverseIterator &operator--() {
+      current_ = current_->next_;
+      return *this;
+    }
+
+    bool operator==(const ReverseIterator &other) const { return current_ == other.current_; }
+    bool operator!=(const ReverseIterator &other) const { return current_ != other.current_; }
+
+    T *get() const {
+      return static_cast<T *>(current_);
+    }
+
+    T *operator->() const { return get(); }
+
+    T &operator*() const { return *get(); }
+
+    explicit operator bool() const {
+      return nullptr == current_ ?
+             false : (nullptr == current_->previous_ ?
+                      false : (nullptr != current_->next_));
+    }
+
+   private:
+
+    BinodeBase *current_ = nullptr;
+
+  };
+
+  /**
+   * @brief Const reverse iterator.
+   */
+  class ConstReverseIterator {
+
+   public:
+
+    ConstReverseIterator() = delete;
+
+    explicit ConstReverseIterator(const BinodeBase *node)
+        : current_(node) {}
+
+    ~ConstReverseIterator() = default;
+
+    ConstReverseIterator &operator++() {
+      current_ = current_->previous_;
+      return *this;
+    }
+
+    ConstReverseIterator &operator--() {
+      current_ = current_->next_;
+      return *this;
+    }
+
+    bool operator==(const ConstReverseIterator &other) const { return current_ == other.current_; }
+    bool operator!=(const ConstReverseIterator &other) const { return current_ != other.current_; }
+
+    const T *get() const {
+      return static_cast<const T *>(current_);
+    }
+
+    const T *operator->() const { return get(); }
+
+    const T &operator*() const { return *get(); }
+
+    explicit operator bool() const {
+      return nullptr == current_ ?
+             false : (nullptr == current_->previous_ ?
+                      false : (nullptr != current_->next_));
+    }
+
+   private:
+
+    const BinodeBase *current_ = nullptr;
+
+  };
+
+  /**
+   * @brief Default constructor.
+   *
+   * The end points are linked in the initializers, which are constant
+   * expressions for a deque with static storage duration.
+   */
+  constexpr Deque()
+      : head_(nullptr, &tail_), tail_(&head_, nullptr) {}
+
+  /**
+   * @brief Destructor, unlinks the nodes left.
+   */
+  ~Deque() {
+    clear();
+  }
+
+  /**
+   * @brief Add a node at the end.
+   */
+  void push_back(T *node) {
+    static_assert(std::is_base_of<BinodeBase, T>::value, "The node type must be derived from BinodeBase");
+    PushFront(&tail_, node);
+  }
+
+  /**
+   * @brief Insert a node at the beginning.
+   */
+  void push_front(T *node) {
+    static_assert(std::is_base_of<BinodeBase, T>::value, "The node type must be derived from BinodeBase");
+    PushBack(&head_, node);
+  }
+
+  /**
+   * @brief Insert a node at the given position.
+   * @param node
+   * @param index The position from the beginning, or from the end if negative (-1 is the end)
+   */
+  void insert(T *node, int index = 0) {
+    static_assert(std::is_base_of<BinodeBase, T>::value, "The node type must be derived from BinodeBase");
+    if (index >= 0) {
+      BinodeBase *p = head_.next_;
+      while ((p != &tail_) && (index > 0)) {
+        p = p->next_;
+        index--;
+      }
+      PushFront(p, node);
+    } else {
+      BinodeBase *p = tail_.previous_;
+      while ((p != &head_) && (index < -1)) {
+        p = p->previous_;
+        index++;
+      }
+      PushBack(p, node);
+    }
+  }
+
+  /**
+   * @brief Unlink the node of an iterator.
+   * @return The iterator to the next node
+   */
+  Iterator erase(Iterator it) {
+    BinodeBase *next = it.current_->next_;
+    Unlink(it.current_);
+    return Iterator(next);
+  }
+
+  /**
+   * @brief Unlink the node of a reverse iterator.
+   * @return The reverse iterator to the previous node
+   */
+  ReverseIterator erase(ReverseIterator it) {
+    BinodeBase *previous = it.current_->previous_;
+    Unlink(it.current_);
+    return ReverseIterator(previous);
+  }
+
+  /**
+   * @brief Unlink and return the first node, or nullptr if empty.
+   */
+  T *pop_front() {
+    T *node = front();
+    if (nullptr != node) Unlink(node);
+    return node;
+  }
+
+  /**
+   * @brief Unlink and return the last node, or nullptr if empty.
+   */
+  T *pop_back() {
+    T *node = back();
+    if (nullptr != node) Unlink(node);
+    return node;
+  }
+
+  /**
+   * @brief Move all nodes of another deque at the end of this one, in constant time.
+   */
+  void splice(Deque &other) {
+    if ((&other == this) || other.is_empty()) return;
+
+    BinodeBase *first = other.head_.next_;
+    BinodeBase *last = other.tail_.previous_;
+    other.reset();
+
+    first->previous_ = tail_.previous_;
+    tail_.previous_->next_ = first;
+    last->next_ = &tail_;
+    tail_.previous_ = last;
+  }
+
+  /**
+   * @brief Unlink all nodes.
+   */
+  void clear() {
+    while (head_.next_ != &tail_) Unlink(head_.next_);
+  }
+
+  /**
+   * @brief The first node, or nullptr if empty.
+   */
+  T *front() const {
+    return is_empty() ? nullptr : static_cast<T *>(head_.next_);
+  }
+
+  /**
+   * @brief The last node, or nullptr if empty.
+   */
+  T *back() const {
+    return is_empty() ? nullptr : static_cast<T *>(tail_.previous_);
+  }
+
+  bool is_empty() const { return head_.next_ == &tail_; }
+
+  /**
+   * @brief Count the nodes, in linear time (see CountedDeque).
+   */
+  size_t count() const {
+    size_t n = 0;
+    for (const BinodeBase *p = head_.next_; p != &tail_; p = p->next_) n++;
+    return n;
+  }
+
+  Iterator begin() const { return Iterator(head_.next_); }
+
+  ConstIterator cbegin() const { return ConstIterator(head_.next_); }
+
+  Iterator end() const { return Iterator(const_cast<Endpoint *>(&tail_)); }
+
+  ConstIterator cend() const { return ConstIterator(&tail_); }
+
+  ReverseIterator rbegin() const { return ReverseIterator(tail_.previous_); }
+
+  ConstReverseIterator crbegin() const { return ConstReverseIterator(tail_.previous_); }
+
+  ReverseIterator rend() const { return ReverseIterator(const_cast<Endpoint *>(&head_)); }
+
+  ConstReverseIterator crend() const { return ConstReverseIterator(&head_); }
+
+ protected:
+
+  /**
+   * @brief Forget all nodes at once.
+   *
+   * The nodes are not unlinked, the caller takes care of them.
+   */
+  void reset() {
+    head_.next_ = &tail_;
+    tail_.previous_ = &head_;
+  }
+
+ private:
+
+  static void PushFront(BinodeBase *node, BinodeBase *other) { BinodeBase::PushFront(node, other); }
+
+  static void PushBack(BinodeBase *node, BinodeBase *other) { BinodeBase::PushBack(node, other); }
+
+  static void Unlink(BinodeBase *node) { BinodeBase::Unlink(node); }
+
+  class Endpoint : public BinodeBase {
+   public:
+    constexpr Endpoint(BinodeBase *previous, BinodeBase *next)
+        : BinodeBase(previous, next) {}
+  };
+
+  Endpoint head_;
+  Endpoint tail_;
+
+};
+
+class CountedDequeBase;
+
+/**
+ * @ingroup base
+ * @brief Base class of a node of a CountedDeque.
+ */
+class WIZTK_EXPORT CountedDequeNodeBase : public BinodeBase {
+
+  friend class CountedDequeBase;
+
+  template<typename T> friend
+  class CountedDeque;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(CountedDequeNodeBase);
+
+  /**
+   * @brief Destructor, leaves the deque.
+   */
+  ~CountedDequeNodeBase() override;
+
+ protected:
+
+  CountedDequeNodeBase() = default;
+
+  /**
+   * @brief Unlink this node and decrease the count of its deque.
+   */
+  void Leave();
+
+  CountedDequeBase *deque_ = nullptr;
+
+};
+
+/**
+ * @ingroup base
+ * @brief The count of a CountedDeque, updated by the nodes leaving it.
+ */
+class WIZTK_EXPORT CountedDequeBase {
+
+  friend class CountedDequeNodeBase;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(CountedDequeBase);
+
+  /**
+   * @brief The number of nodes, in constant time.
+   */
+  size_t size() const { return count_; }
+
+  bool is_empty() const { return 0 == count_; }
+
+ protected:
+
+  CountedDequeBase() = default;
+
+  ~CountedDequeBase() = default;
+
+  /**
+   * @brief Make a node leave its deque and count it in this one, before linking it.
+   */
+  void Adopt(CountedDequeNodeBase *node) {
+    node->Leave();
+    node->deque_ = this;
+    count_++;
+  }
+
+  size_t count_ = 0;
+
+};
+
+/**
+ * @ingroup base
+ * @brief A node of a CountedDeque.
+ * @tparam T Usually a type of subclass
+ */
+template<typename T>
+class WIZTK_EXPORT CountedDequeNode : public CountedDequeNodeBase {
+
+ public:
+
+  CountedDequeNode() = default;
+
+  ~CountedDequeNode() override = default;
+
+  /**
+   * @brief Unlink this node from its deque.
+   */
+  inline void unlink() { Leave(); }
+
+  inline bool is_linked() const { return IsLinked(this); }
+
+  /**
+   * @brief The deque this node is in, or nullptr.
+   */
+  inline CountedDequeBase *deque() const { return deque_; }
+
+};
+
+/**
+ * @ingroup base
+ * @brief An intrusive double-ended queue which knows its size.
+ * @tparam T The node type, a subclass of CountedDequeNode<T>
+ *
+ * Works like Deque, and each node keeps a pointer to its deque to update
+ * the count when it's unlinked or destroyed. splice() has to update these
+ * pointers, it takes linear time.
+ */
+template<typename T>
+class WIZTK_EXPORT CountedDeque : public CountedDequeBase {
+
+ public:
+
+  typedef typename Deque<T>::Iterator Iterator;
+  typedef typename Deque<T>::ConstIterator ConstIterator;
+  typedef typename Deque<T>::ReverseIterator ReverseIterator;
+  typedef typename Deque<T>::ConstReverseIterator ConstReverseIterator;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(CountedDeque);
+
+  CountedDeque() = default;
+
+  /**
+   * @brief Destructor, unlinks the nodes left.
+   */
+  ~CountedDeque() {
+    clear();
+  }
+
+  void push_back(T *node) {
+    Adopt(node);
+    deque_.push_back(node);
+  }
+
+  void push_front(T *node) {
+    Adopt(node);
+    deque_.push_front(node);
+  }
+
+  /**
+   * @brief Insert a node at the given position, see Deque::insert().
+   */
+  void insert(T *node, int index = 0) {
+    Adopt(node);
+    deque_.insert(node, index);
+  }
+
+  Iterator erase(Iterator it) {
+    T *node = it.get();
+    ++it;
+    node->Leave();
+    return it;
+  }
+
+  ReverseIterator erase(ReverseIterator it) {
+    T *node = it.get();
+    ++it;
+    node->Leave();
+    return it;
+  }
+
+  T *pop_front() {
+    T *node = deque_.front();
+    if (nullptr != node) node->Leave();
+    return node;
+  }
+
+  T *pop_back() {
+    T *node = deque_.back();
+    if (nullptr != node) node->Leave();
+    return node;
+  }
+
+  /**
+   * @brief Move all nodes of another deque at the end of this one.
+   */
+  void splice(CountedDeque &other) {
+    if (&other == this) return;
+
+    for (Iterator it = other.begin(); it != other.end(); ++it) it->deque_ = this;
+    count_ += other.count_;
+    other.count_ = 0;
+    deque_.splice(other.deque_);
+  }
+
+  void clear() {
+    T *node = nullptr;
+    while (nullptr != (node = deque_.front())) node->Leave();
+  }
+
+  T *front() const { return deque_.front(); }
+
+  T *back() const { return deque_.back(); }
+
+  Iterator begin() const { return deque_.begin(); }
+
+  ConstIterator cbegin() const { return deque_.cbegin(); }
+
+  Iterator end() const { return deque_.end(); }
+
+  ConstIterator cend() const { return deque_.cend(); }
+
+  ReverseIterator rbegin() const { return deque_.rbegin(); }
+
+  ConstReverseIterator crbegin() const { return deque_.crbegin(); }
+
+  ReverseIterator rend() const { return deque_.rend(); }
+
+  ConstReverseIterator crend() const { return deque_.crend(); }
+
+ private:
+
+  Deque<T> deque_;
+
+};
+
 } // namespace sigcxx
 
 #endif // WIZTK_BASE_BINODE_HPP_
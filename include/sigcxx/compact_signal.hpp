@@ -0,0 +1,384 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file compact_signal.hpp
+ * @brief Header file for signals with 32-byte connections linked by 32-bit indices.
+ */
+
+#ifndef WIZTK_BASE_COMPACT_SIGNAL_HPP_
+#define WIZTK_BASE_COMPACT_SIGNAL_HPP_
+
+#include "sigcxx/delegate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief Memory statistics of the compact connection arena.
+ */
+struct WIZTK_EXPORT CompactArenaStats {
+
+  /**
+   * @brief Number of live nodes, connections and list heads
+   */
+  size_t node_count = 0;
+
+  /**
+   * @brief Number of nodes the allocated chunks can hold
+   */
+  size_t capacity = 0;
+
+  /**
+   * @brief Bytes of the live nodes
+   */
+  size_t used_bytes = 0;
+
+  /**
+   * @brief Bytes of the allocated chunks
+   */
+  size_t reserved_bytes = 0;
+
+};
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief A slot method of compact connections, shared by all connections to it.
+ */
+struct WIZTK_NO_EXPORT CompactMethod {
+  void (*stub)();   // cast back to the stub of the signal parameter types
+  GenericMethodPointer method;
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A compact connection, in the list of its signal and the list of its receiver.
+ *
+ * A list head is a node too, with a null method.
+ */
+struct WIZTK_NO_EXPORT CompactNode {
+  void *object;   // null in a list head, or once disconnected during an emission
+  const CompactMethod *method;
+  uint32_t signal_previous;
+  uint32_t signal_next;
+  uint32_t receiver_previous;
+  uint32_t receiver_next;
+};
+
+static_assert(sizeof(CompactNode) == 32, "A compact connection takes 32 bytes");
+
+/**
+ * @ingroup base_intern
+ * @brief The process-wide arena of compact nodes.
+ *
+ * Nodes are allocated in chunks which never move, so an index is turned
+ * into an address with two loads and a node can be read while another
+ * thread allocates.
+ */
+class WIZTK_EXPORT CompactArena {
+
+ public:
+
+  static const uint32_t kNull = 0;   // index 0 is never allocated
+
+  static const unsigned int kChunkBits = 16;
+
+  static const uint32_t kChunkSize = 1u << kChunkBits;
+
+  static const uint32_t kMaxChunks = 1u << (32 - kChunkBits);
+
+  CompactArena() = delete;
+
+  static CompactNode *Node(uint32_t index) {
+    return &chunks_[index >> kChunkBits][index & (kChunkSize - 1)];
+  }
+
+  /**
+   * @brief Link a new connection at the end of both lists, allocating the heads if needed
+   */
+  static void Connect(uint32_t *signal_head, uint32_t *receiver_head, void *object, const CompactMethod *method);
+
+  /**
+   * @brief Break a connection, its node is kept until the outermost emission in this thread ends
+   */
+  static void Disconnect(uint32_t index);
+
+  /**
+   * @brief Free the head of an empty list, kept like a connection if emitting
+   */
+  static void ReleaseHead(uint32_t index);
+
+  /**
+   * @brief The unique entry of a slot method
+   */
+  static const CompactMethod *RegisterMethod(void (*stub)(), GenericMethodPointer method);
+
+  static void BeginEmit();
+
+  static void EndEmit();
+
+  static CompactArenaStats GetStats();
+
+ private:
+
+  static uint32_t Allocate();
+
+  static void Free(uint32_t index);
+
+  static void UnlinkFromSignal(CompactNode *node);
+
+  static void FreePending();
+
+  static CompactNode *chunks_[kMaxChunks];
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A helper class to begin and end an emission in a scope, even if a slot throws.
+ */
+class WIZTK_NO_EXPORT CompactEmitGuard {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(CompactEmitGuard);
+
+  CompactEmitGuard() { CompactArena::BeginEmit(); }
+
+  ~CompactEmitGuard() { CompactArena::EndEmit(); }
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief The base class of an object with slot methods for CompactSignal.
+ *
+ * Takes 16 bytes, the connections are broken when it's destroyed. A class
+ * can derive from both Trackable and CompactTrackable.
+ */
+class WIZTK_EXPORT CompactTrackable {
+
+  template<typename ... ParamTypes> friend
+  class CompactSignal;
+
+ public:
+
+  CompactTrackable() = default;
+
+  /**
+   * @brief Copy constructor, does not copy the connections
+   */
+  CompactTrackable(const CompactTrackable &) {}
+
+  virtual ~CompactTrackable();
+
+  CompactTrackable &operator=(const CompactTrackable &) {
+    return *this;
+  }
+
+  size_t CountCompactBindings() const;
+
+ protected:
+
+  void UnbindAllCompactSignals();
+
+ private:
+
+  uint32_t head_ = internal::CompactArena::kNull;
+
+};
+
+/**
+ * @ingroup base
+ * @brief A signal for very large connection graphs.
+ *
+ * A connection is one 32-byte node in a process-wide arena, linked in the
+ * list of its signal and in the list of its receiver by 32-bit indices,
+ * instead of a token and a binding linked by pointers. The slot methods
+ * are shared entries, and emitting walks nodes allocated close together.
+ *
+ * The price is a narrower feature set than Signal: slot methods take the
+ * signal parameters without a Slot, connections are appended and can't be
+ * chained to another signal, queued or awaited. A slot may connect,
+ * disconnect or destroy any object, nodes of broken connections are reused
+ * once the outermost emission in the thread is done.
+ *
+ * Like Signal, a CompactSignal and its receivers must be used in one
+ * thread, several threads can use the arena at once.
+ *
+ * @code
+ * class Cell : public sigcxx::CompactTrackable {
+ *  public:
+ *   void OnChanged(int value);
+ * };
+ *
+ * sigcxx::CompactSignal<int> changed;
+ * changed.Connect(&cell, &Cell::OnChanged);
+ * changed.Emit(42);
+ * @endcode
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT CompactSignal {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(CompactSignal);
+
+  CompactSignal() = default;
+
+  ~CompactSignal() {
+    if (internal::CompactArena::kNull == head_) return;
+
+    DisconnectAll();
+    internal::CompactArena::ReleaseHead(head_);
+  }
+
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes...)) {
+    static_assert(std::is_base_of<CompactTrackable, T>::value, "The receiver must be a sigcxx::CompactTrackable");
+
+    internal::CompactArena::Connect(&head_, &static_cast<CompactTrackable *>(obj)->head_, obj, Register(method));
+  }
+
+  /**
+   * @brief Disconnect all connections to the given method of the given object
+   */
+  template<typename T>
+  void Disconnect(T *obj, void (T::*method)(ParamTypes...));
+
+  void DisconnectAll();
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes...)) const;
+
+  size_t CountConnections() const;
+
+  void Emit(ParamTypes ... Args);
+
+  void operator()(ParamTypes ... Args) {
+    Emit(Args...);
+  }
+
+ private:
+
+  typedef void (*StubType)(void *object, internal::GenericMethodPointer method, ParamTypes ... Args);
+
+  template<typename T>
+  static void Stub(void *object, internal::GenericMethodPointer method, ParamTypes ... Args) {
+    typedef void (T::*MethodType)(ParamTypes...);
+    (static_cast<T *>(object)->*reinterpret_cast<MethodType>(method))(Args...);
+  }
+
+  template<typename T>
+  static const internal::CompactMethod *Register(void (T::*method)(ParamTypes...)) {
+    static_assert(sizeof(method) <= sizeof(internal::GenericMethodPointer), "Unsupported method pointer");
+
+    return internal::CompactArena::RegisterMethod(reinterpret_cast<void (*)()>(&Stub<T>),
+                                                  reinterpret_cast<internal::GenericMethodPointer>(method));
+  }
+
+  uint32_t head_ = internal::CompactArena::kNull;
+
+};
+
+// Implementation:
+
+template<typename ... ParamTypes>
+template<typename T>
+void CompactSignal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes...)) {
+  if (internal::CompactArena::kNull == head_) return;
+
+  const internal::CompactMethod *entry = Register(method);
+  uint32_t index = internal::CompactArena::Node(head_)->signal_next;
+  while (index != head_) {
+    internal::CompactNode *node = internal::CompactArena::Node(index);
+    uint32_t next = node->signal_next;
+    if ((static_cast<void *>(obj) == node->object) && (entry == node->method)) {
+      internal::CompactArena::Disconnect(index);
+    }
+    index = next;
+  }
+}
+
+template<typename ... ParamTypes>
+void CompactSignal<ParamTypes...>::DisconnectAll() {
+  if (internal::CompactArena::kNull == head_) return;
+
+  uint32_t index = internal::CompactArena::Node(head_)->signal_next;
+  while (index != head_) {
+    internal::CompactNode *node = internal::CompactArena::Node(index);
+    uint32_t next = node->signal_next;
+    if (nullptr != node->object) internal::CompactArena::Disconnect(index);
+    index = next;
+  }
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+bool CompactSignal<ParamTypes...>::IsConnectedTo(T *obj, void (T::*method)(ParamTypes...)) const {
+  if (internal::CompactArena::kNull == head_) return false;
+
+  const internal::CompactMethod *entry = Register(method);
+  for (uint32_t index = internal::CompactArena::Node(head_)->signal_next; index != head_;) {
+    const internal::CompactNode *node = internal::CompactArena::Node(index);
+    if ((static_cast<void *>(obj) == node->object) && (entry == node->method)) return true;
+    index = node->signal_next;
+  }
+  return false;
+}
+
+template<typename ... ParamTypes>
+size_t CompactSignal<ParamTypes...>::CountConnections() const {
+  if (internal::CompactArena::kNull == head_) return 0;
+
+  size_t count = 0;
+  for (uint32_t index = internal::CompactArena::Node(head_)->signal_next; index != head_;) {
+    const internal::CompactNode *node = internal::CompactArena::Node(index);
+    if (nullptr != node->object) count++;
+    index = node->signal_next;
+  }
+  return count;
+}
+
+template<typename ... ParamTypes>
+void CompactSignal<ParamTypes...>::Emit(ParamTypes ... Args) {
+  // Kept in a local, this signal may be destroyed in a slot:
+  const uint32_t head = head_;
+  if (internal::CompactArena::kNull == head) return;
+
+  internal::CompactEmitGuard guard;
+
+  uint32_t index = internal::CompactArena::Node(head)->signal_next;
+  while (index != head) {
+    const internal::CompactNode *node = internal::CompactArena::Node(index);
+    if (nullptr != node->object) {
+      reinterpret_cast<StubType>(node->method->stub)(node->object, node->method->method, Args...);
+    }
+    index = node->signal_next;
+  }
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_COMPACT_SIGNAL_HPP_
@@ -0,0 +1,451 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file concurrent_signal.hpp
+ * @brief Header file for a signal emitted in many threads while receivers are destroyed.
+ */
+
+#ifndef WIZTK_BASE_CONCURRENT_SIGNAL_HPP_
+#define WIZTK_BASE_CONCURRENT_SIGNAL_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+#include "sigcxx/epoch.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief A token in the lock-free list of a ConcurrentSignal.
+ *
+ * When the receiver is destroyed the token is not deleted at once, it's
+ * unlinked and retired to the EpochDomain, because other threads may still be
+ * walking through it.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT ConcurrentToken : public SignalTokenNode {
+
+ public:
+
+  typedef Delegate<void(ParamTypes..., SLOT)> DelegateType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ConcurrentToken);
+  ConcurrentToken() = delete;
+
+  ConcurrentToken(ConcurrentSignal<ParamTypes...> *signal, const DelegateType &d)
+      : delegate(d), signal_(signal) {}
+
+  ~ConcurrentToken() final = default;
+
+  void Dispose() final {
+    signal_->Remove(this);
+  }
+
+  DelegateType delegate;
+
+  std::atomic<bool> alive{true};
+
+  std::atomic<ConcurrentToken *> next{nullptr};
+
+ private:
+
+  ConcurrentSignal<ParamTypes...> *signal_;
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief A signal which can be emitted in many threads at the same time.
+ *
+ * Emit() takes no lock: it enters an epoch (see internal::EpochDomain), walks
+ * an atomic list of tokens and calls the ones still connected. Connecting and
+ * disconnecting take a mutex of this signal.
+ *
+ * A receiver can be destroyed in any thread while the signal is being emitted
+ * in others, ~Trackable() unlinks its tokens immediately and waits for the
+ * emissions in progress in other threads, so no invocation is running or
+ * starts after the destructor returns. The token memory is reclaimed once all
+ * emitting threads have left the epoch. A receiver destroyed in its own slot
+ * does not wait for itself. Two threads destroying each other's receivers in
+ * their slots would wait for each other forever, one of them doesn't wait:
+ * the slot running in the other thread may still be on the stack.
+ *
+ * @code
+ * sigcxx::ConcurrentSignal<int> progress;
+ *
+ * progress.Connect(&view, &View::OnProgress);
+ * // in any thread:
+ * progress.Emit(50);
+ * @endcode
+ *
+ * The slot parameter is nullptr when called by this signal. A receiver must
+ * not be connected, disconnected or destroyed in two threads at the same time,
+ * and the signal itself must not be destroyed while being emitted.
+ *
+ * A signal which is only used in one thread for a while can be confined with
+ * SetThreadAffinity(): it then takes no lock and enters no epoch, tokens
+ * removed during an emission are freed when it returns. Debug builds assert
+ * that connections, emissions and the destruction of receivers happen in the
+ * owner thread, MoveToThread() hands the signal over to another one.
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT ConcurrentSignal {
+
+  friend class internal::ConcurrentToken<ParamTypes...>;
+
+ public:
+
+  typedef internal::ConcurrentToken<ParamTypes...> TokenType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ConcurrentSignal);
+
+  ConcurrentSignal() = default;
+
+  ~ConcurrentSignal() {
+    DisconnectAll();
+  }
+
+  /**
+   * @brief Connect this signal to a slot method in a observer
+   */
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes..., SLOT));
+
+  /**
+   * @brief Disconnect all delegates to a method
+   * @return Number of connections broken
+   */
+  template<typename T>
+  int DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT));
+
+  /**
+   * @brief Disconnect all
+   */
+  int DisconnectAll();
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT)) const;
+
+  int CountConnections() const;
+
+  void Emit(ParamTypes ... Args);
+
+  void operator()(ParamTypes ... Args) {
+    Emit(Args...);
+  }
+
+  /**
+   * @brief Confine this signal to the current thread and use the unsynchronized path
+   *
+   * Must not be called while other threads use this signal.
+   */
+  void SetThreadAffinity() {
+    confined_ = true;
+    MoveToThread(std::this_thread::get_id());
+  }
+
+  /**
+   * @brief Hand a confined signal over to another thread, called in the owner thread
+   */
+  void MoveToThread(std::thread::id owner) {
+    _ASSERT(IsOnOwnerThread() && (0 == emitting_));
+    owner_ = owner;
+  }
+
+  /**
+   * @brief Go back to the thread-safe path, called in the owner thread
+   */
+  void ClearThreadAffinity() {
+    MoveToThread(std::thread::id());
+    confined_ = false;
+  }
+
+  bool IsThreadConfined() const { return confined_; }
+
+  /**
+   * @brief Returns false if this signal is confined to another thread, always true in a release build
+   */
+  bool IsOnOwnerThread() const {
+#ifdef __DEBUG__
+    return (std::thread::id() == owner_) || (std::this_thread::get_id() == owner_);
+#else
+    return true;
+#endif
+  }
+
+ private:
+
+  /**
+   * @brief Called when the binding of a token is destroyed.
+   */
+  void Remove(TokenType *token);
+
+  /**
+   * @brief Unlink a token, the mutex must be locked.
+   * @return False if it's already unlinked
+   */
+  bool Unlink(TokenType *token);
+
+  /**
+   * @brief Free tokens unlinked by a disconnect method.
+   */
+  void Release(const std::vector<TokenType *> &tokens);
+
+  /**
+   * @brief Emit in the owner thread of a confined signal.
+   */
+  void EmitConfined(ParamTypes ... Args);
+
+  /**
+   * @brief Free an unlinked token of a confined signal, or keep it until the emission returns.
+   */
+  void Free(TokenType *token);
+
+  mutable std::mutex mutex_;
+
+  std::atomic<TokenType *> head_{nullptr};
+
+  TokenType *tail_ = nullptr;
+
+  bool confined_ = false;
+
+  int emitting_ = 0;  // nesting of confined emissions
+
+  std::vector<TokenType *> graveyard_;  // unlinked during a confined emission
+
+  std::thread::id owner_;  // kept in all builds, only the checks depend on __DEBUG__
+
+};
+
+// Implementation:
+
+template<typename ... ParamTypes>
+template<typename T>
+void ConcurrentSignal<ParamTypes...>::Connect(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
+  auto *token = new TokenType(this, TokenType::DelegateType::template FromMethod<T>(obj, method));
+  auto *binding = new internal::TrackableBindingNode;
+
+  Trackable::Link(token, binding);
+  Trackable::PushBackBinding(obj, binding);
+
+  _ASSERT(IsOnOwnerThread());
+  std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+  if (!confined_) lock.lock();
+
+  // Publish the token after it's fully constructed:
+  if (nullptr == tail_) {
+    head_.store(token, std::memory_order_release);
+  } else {
+    tail_->next.store(token, std::memory_order_release);
+  }
+  tail_ = token;
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+int ConcurrentSignal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
+  std::vector<TokenType *> removed;
+  {
+    _ASSERT(IsOnOwnerThread());
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!confined_) lock.lock();
+
+    TokenType *token = head_.load(std::memory_order_relaxed);
+    TokenType *next = nullptr;
+    while (nullptr != token) {
+      next = token->next.load(std::memory_order_relaxed);
+      if ((nullptr != token->binding) && (token->binding->trackable == obj) &&
+          token->delegate.template Equal<T>(obj, method)) {
+        Unlink(token);
+        removed.push_back(token);
+      }
+      token = next;
+    }
+  }
+
+  Release(removed);
+  return static_cast<int>(removed.size());
+}
+
+template<typename ... ParamTypes>
+int ConcurrentSignal<ParamTypes...>::DisconnectAll() {
+  std::vector<TokenType *> removed;
+  {
+    _ASSERT(IsOnOwnerThread());
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    if (!confined_) lock.lock();
+
+    TokenType *token = head_.load(std::memory_order_relaxed);
+    TokenType *next = nullptr;
+    while (nullptr != token) {
+      next = token->next.load(std::memory_order_relaxed);
+      Unlink(token);
+      removed.push_back(token);
+      token = next;
+    }
+  }
+
+  Release(removed);
+  return static_cast<int>(removed.size());
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+bool ConcurrentSignal<ParamTypes...>::IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (TokenType *token = head_.load(std::memory_order_relaxed); nullptr != token;
+       token = token->next.load(std::memory_order_relaxed)) {
+    if ((nullptr != token->binding) && (token->binding->trackable == obj) &&
+        token->delegate.template Equal<T>(obj, method)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<typename ... ParamTypes>
+int ConcurrentSignal<ParamTypes...>::CountConnections() const {
+  int count = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (TokenType *token = head_.load(std::memory_order_relaxed); nullptr != token;
+       token = token->next.load(std::memory_order_relaxed)) {
+    count++;
+  }
+  return count;
+}
+
+template<typename ... ParamTypes>
+void ConcurrentSignal<ParamTypes...>::Emit(ParamTypes ... Args) {
+  if (confined_) {
+    EmitConfined(Args...);
+    return;
+  }
+
+  internal::EpochGuard guard;
+
+  TokenType *token = head_.load(std::memory_order_acquire);
+  while (nullptr != token) {
+    // Sequentially consistent, pairs with EpochDomain::Synchronize() in Remove():
+    if (token->alive.load()) token->delegate(Args..., nullptr);
+    token = token->next.load(std::memory_order_acquire);
+  }
+}
+
+template<typename ... ParamTypes>
+void ConcurrentSignal<ParamTypes...>::Remove(TokenType *token) {
+  if (confined_) {
+    // The receiver is destroyed in the owner thread:
+    _ASSERT(IsOnOwnerThread());
+    if (Unlink(token)) Free(token);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Already removed by a disconnect method which will retire it:
+    if (!Unlink(token)) return;
+  }
+
+  internal::EpochDomain::Synchronize();
+  internal::EpochDomain::Retire(token);
+}
+
+template<typename ... ParamTypes>
+bool ConcurrentSignal<ParamTypes...>::Unlink(TokenType *token) {
+  if (!token->alive.load(std::memory_order_relaxed)) return false;
+  token->alive.store(false);
+
+  TokenType *prev = nullptr;
+  TokenType *p = head_.load(std::memory_order_relaxed);
+  while ((nullptr != p) && (p != token)) {
+    prev = p;
+    p = p->next.load(std::memory_order_relaxed);
+  }
+  _ASSERT(p == token);
+
+  // Keep the next pointer of the unlinked token, a thread may still be on it:
+  TokenType *next = token->next.load(std::memory_order_relaxed);
+  if (nullptr == prev) {
+    head_.store(next, std::memory_order_release);
+  } else {
+    prev->next.store(next, std::memory_order_release);
+  }
+  if (tail_ == token) tail_ = prev;
+  return true;
+}
+
+template<typename ... ParamTypes>
+void ConcurrentSignal<ParamTypes...>::Release(const std::vector<TokenType *> &tokens) {
+  if (tokens.empty()) return;
+
+  for (TokenType *token : tokens) {
+    if (nullptr != token->binding) {
+      token->binding->token = nullptr;
+      delete token->binding;
+      token->binding = nullptr;
+    }
+  }
+
+  if (confined_) {
+    for (TokenType *token : tokens) Free(token);
+    return;
+  }
+
+  internal::EpochDomain::Synchronize();
+  for (TokenType *token : tokens) {
+    internal::EpochDomain::Retire(token);
+  }
+}
+
+template<typename ... ParamTypes>
+void ConcurrentSignal<ParamTypes...>::EmitConfined(ParamTypes ... Args) {
+  _ASSERT(IsOnOwnerThread());
+
+  ++emitting_;
+  TokenType *token = head_.load(std::memory_order_relaxed);
+  while (nullptr != token) {
+    if (token->alive.load(std::memory_order_relaxed)) token->delegate(Args..., nullptr);
+    token = token->next.load(std::memory_order_relaxed);
+  }
+
+  if ((0 == --emitting_) && !graveyard_.empty()) {
+    std::vector<TokenType *> tokens;
+    tokens.swap(graveyard_);
+    for (TokenType *p : tokens) delete p;
+  }
+}
+
+template<typename ... ParamTypes>
+void ConcurrentSignal<ParamTypes...>::Free(TokenType *token) {
+  if (emitting_ > 0) {
+    graveyard_.push_back(token);
+  } else {
+    delete token;
+  }
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_CONCURRENT_SIGNAL_HPP_
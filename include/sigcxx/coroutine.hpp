@@ -0,0 +1,124 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file coroutine.hpp
+ * @brief Header file for awaiting signals in C++20 coroutines.
+ *
+ * This header is optional and requires a C++20 compiler, it implements
+ * Signal::Next() and Signal::When():
+ *
+ * @code
+ * Task OnLogin(sigcxx::Signal<int, const User &> &logged_in) {
+ *   auto args = co_await logged_in.When([](int, const User &user) { return user.is_admin(); });
+ *   if (!args) co_return;  // the signal was destroyed
+ *   // ...
+ * }
+ * @endcode
+ *
+ * The awaiter lives in the coroutine frame and is linked into the signal like
+ * a Slot::Mark, so there's no heap allocation per co_await. If the signal is
+ * destroyed first, the coroutine is resumed with an empty result. If the
+ * coroutine is destroyed first, the awaiter unlinks itself.
+ */
+
+#ifndef WIZTK_BASE_COROUTINE_HPP_
+#define WIZTK_BASE_COROUTINE_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#if (__cplusplus < 202002L) || !defined(__cpp_impl_coroutine)
+#error "sigcxx/coroutine.hpp requires C++20 coroutines"
+#endif
+
+#include <coroutine>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief The predicate used in Signal::Next().
+ */
+struct AcceptAll {
+  template<typename ... Types>
+  bool operator()(const Types &...) const { return true; }
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The awaiter returned by Signal::Next() and Signal::When().
+ * @tparam Predicate
+ * @tparam ParamTypes
+ */
+template<typename Predicate, typename ... ParamTypes>
+class WIZTK_NO_EXPORT SignalAwaiter : public Waiter<ParamTypes...> {
+
+ public:
+
+  /**
+   * @brief A copy of the arguments, or empty if the signal was destroyed.
+   */
+  typedef std::optional<std::tuple<std::decay_t<ParamTypes>...> > ResultType;
+
+  SignalAwaiter(Signal<ParamTypes...> *signal, Predicate pred)
+      : signal_(signal), predicate_(std::move(pred)) {}
+
+  ~SignalAwaiter() final = default;
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    signal_->AddWaiter(this);
+  }
+
+  ResultType await_resume() {
+    return std::move(result_);
+  }
+
+  bool OnEmit(ParamTypes ... Args) final {
+    if (!predicate_(Args...)) return false;
+    result_.emplace(Args...);
+    return true;
+  }
+
+  void OnResume() final {
+    handle_.resume();
+  }
+
+  void OnCancel() final {
+    handle_.resume();
+  }
+
+ private:
+
+  Signal<ParamTypes...> *signal_;
+  Predicate predicate_;
+  std::coroutine_handle<> handle_;
+  ResultType result_;
+
+};
+
+} // namespace internal
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_COROUTINE_HPP_
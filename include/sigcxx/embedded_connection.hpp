@@ -0,0 +1,162 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file embedded_connection.hpp
+ * @brief Header file for connections stored in the receiver.
+ */
+
+#ifndef WIZTK_BASE_EMBEDDED_CONNECTION_HPP_
+#define WIZTK_BASE_EMBEDDED_CONNECTION_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <type_traits>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief A DelegateToken constructed in an EmbeddedConnection.
+ *
+ * It's deleted like other tokens when the connection is broken, which only
+ * runs the destructor.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT EmbeddedDelegateToken final : public DelegateToken<ParamTypes...> {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmbeddedDelegateToken);
+  EmbeddedDelegateToken() = delete;
+
+  EmbeddedDelegateToken(const typename DelegateToken<ParamTypes...>::DelegateType &d, bool *connected)
+      : DelegateToken<ParamTypes...>(d), connected_(connected) {
+    *connected_ = true;
+  }
+
+  ~EmbeddedDelegateToken() final {
+    *connected_ = false;
+  }
+
+  static void operator delete(void * /* node */) {}
+
+ private:
+
+  bool *connected_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A TrackableBindingNode constructed in an EmbeddedConnection.
+ */
+struct WIZTK_NO_EXPORT EmbeddedBindingNode final : public TrackableBindingNode {
+
+  EmbeddedBindingNode() = default;
+
+  ~EmbeddedBindingNode() final = default;
+
+  static void operator delete(void * /* node */) {}
+
+};
+
+} // namespace internal
+
+template<typename SignalType>
+class EmbeddedConnection;
+
+/**
+ * @ingroup base
+ * @brief The storage of one connection, declared as a member of the receiver.
+ *
+ * Connect() constructs the token and the binding in this object and links
+ * them like a Signal::Connect() to a slot method, without any allocation. The
+ * connection is broken like others: by the signal, by Signal::Disconnect(),
+ * by UnbindAllSignals() of the receiver, or when this object is destroyed,
+ * and can be connected again.
+ *
+ * This is for fixed 1:1 wiring, e.g. a widget to a signal of its parent:
+ *
+ * @code
+ * class Widget : public sigcxx::Trackable {
+ *  public:
+ *   explicit Widget(Widget *parent) {
+ *     resized_.Connect(parent->resized(), this, &Widget::OnParentResized);
+ *   }
+ *   void OnParentResized(int width, int height, SLOT slot);
+ *  private:
+ *   sigcxx::EmbeddedConnection<sigcxx::Signal<int, int> > resized_;
+ * };
+ * @endcode
+ *
+ * It must be a member of the receiver, or be destroyed before it: a member
+ * is destroyed before the Trackable base of the receiver, so the connection
+ * is never deferred by a TrackableTeardownScope after its storage is gone.
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT EmbeddedConnection<Signal<ParamTypes...> > {
+
+ public:
+
+  typedef Signal<ParamTypes...> SignalType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmbeddedConnection);
+
+  EmbeddedConnection() = default;
+
+  ~EmbeddedConnection() {
+    Disconnect();
+  }
+
+  /**
+   * @brief Connect the signal to a slot method, breaking the previous connection if any
+   */
+  template<typename T>
+  void Connect(SignalType &signal, T *obj, void (T::*method)(ParamTypes..., SLOT), int index = -1) {
+    Disconnect();
+
+    auto *token = ::new(&token_) TokenType(
+        Delegate<void(ParamTypes..., SLOT)>::template FromMethod<T>(obj, method), &connected_);
+    signal.LinkConnection(token, ::new(&binding_) internal::EmbeddedBindingNode, obj, index);
+  }
+
+  void Disconnect() {
+    if (connected_) reinterpret_cast<TokenType *>(&token_)->~TokenType();
+  }
+
+  bool IsConnected() const {
+    return connected_;
+  }
+
+ private:
+
+  typedef internal::EmbeddedDelegateToken<ParamTypes..., SLOT> TokenType;
+
+  typename std::aligned_storage<sizeof(TokenType), alignof(TokenType)>::type token_;
+
+  typename std::aligned_storage<sizeof(internal::EmbeddedBindingNode),
+                                alignof(internal::EmbeddedBindingNode)>::type binding_;
+
+  bool connected_ = false;
+
+};
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_EMBEDDED_CONNECTION_HPP_
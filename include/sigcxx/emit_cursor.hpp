@@ -0,0 +1,219 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file emit_cursor.hpp
+ * @brief Header file for an emission which runs in slices.
+ */
+
+#ifndef WIZTK_BASE_EMIT_CURSOR_HPP_
+#define WIZTK_BASE_EMIT_CURSOR_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief An emission of a Signal which can be paused and resumed.
+ *
+ * Each call to Resume() or ResumeFor() invokes slots until a count or a time
+ * budget is used, so a signal with many receivers can be emitted over several
+ * frames:
+ *
+ * @code
+ * sigcxx::EmitCursor<const Frame &> cursor(frame_ready, frame);
+ * while (!cursor.ResumeFor(std::chrono::milliseconds(4))) {
+ *   RenderAndWaitNextFrame();
+ * }
+ * @endcode
+ *
+ * The arguments are copied into the cursor. Between two slices its position
+ * is kept by the same mark a Slot uses during an emission, so it follows the
+ * connections: a connection added before the position is not called, a
+ * broken one is skipped, and the cursor is done if the signal is destroyed.
+ *
+ * Coroutines waiting the signal (Signal::Next(), Signal::When()) are not
+ * resumed by an EmitCursor.
+ */
+template<typename ... ParamTypes>
+class EmitCursor {
+
+ public:
+
+  typedef Signal<ParamTypes...> SignalType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmitCursor);
+  EmitCursor() = delete;
+
+  /**
+   * @brief Start an emission, no slot is called before Resume()
+   */
+  explicit EmitCursor(SignalType &signal, ParamTypes ... Args)
+      : slot_(&signal.tokens_, nullptr), args_(Args...) {
+    // The interceptors run once, on the copied arguments:
+    if (slot_.it_ && ((nullptr == signal.interceptors_) ||
+        Intercept(signal.interceptors_, std::index_sequence_for<ParamTypes...>()))) {
+      Pause();
+    } else {
+      done_ = true;
+    }
+  }
+
+  ~EmitCursor() = default;
+
+  /**
+   * @brief Invoke at most max_count slots
+   * @return true if the emission is done
+   */
+  bool Resume(size_t max_count = SIZE_MAX) {
+    size_t end = invoked_count_ + max_count;
+    if (end < invoked_count_) end = SIZE_MAX;
+    return Run([this, end]() { return invoked_count_ >= end; });
+  }
+
+  /**
+   * @brief Invoke slots until the given time has passed
+   * @return true if the emission is done
+   *
+   * The clock is read after the first slot, then less and less often while
+   * the slots between two reads take less than 1/16 of the remaining time,
+   * so cheap slots don't pay for a clock read each and a slice overruns its
+   * budget by about 1/8 at most if the slots take a similar time.
+   */
+  template<typename Rep, typename Period>
+  bool ResumeFor(const std::chrono::duration<Rep, Period> &budget) {
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point last = Clock::now();
+    Clock::time_point deadline = last + std::chrono::duration_cast<Clock::duration>(budget);
+    size_t stride = 1;
+    size_t next_check = invoked_count_ + 1;
+
+    return Run([&]() {
+      if (invoked_count_ < next_check) return false;
+
+      Clock::time_point now = Clock::now();
+      if (now >= deadline) return true;
+
+      if ((now - last) * 16 < (deadline - now)) {
+        if (stride < kMaxClockStride) stride *= 2;
+      } else if (stride > 1) {
+        stride /= 2;
+      }
+      last = now;
+      next_check = invoked_count_ + stride;
+      return false;
+    });
+  }
+
+  bool IsDone() const { return done_; }
+
+  /**
+   * @brief Number of slots invoked so far
+   */
+  size_t invoked_count() const { return invoked_count_; }
+
+ private:
+
+  static const size_t kMaxClockStride = 1024;
+
+  template<typename Predicate>
+  bool Run(Predicate exhausted);
+
+  /**
+   * @brief Keep the mark on the next token to invoke, until the next slice.
+   *
+   * ref_count_ makes the first increment of the next slice stay on it, or
+   * on the token after it if it's deleted in between.
+   */
+  void Pause() {
+    slot_.it_->slot_mark_head.push_back(&slot_.mark_);
+    slot_.ref_count_ = 1;
+  }
+
+  template<size_t ... Indices>
+  bool Intercept(internal::InterceptorChain<ParamTypes...> *chain, std::index_sequence<Indices...>) {
+    return chain->Run(std::get<Indices>(args_)...);
+  }
+
+  /**
+   * @brief Invoke the token under the cursor with the copied arguments.
+   *
+   * Signal only inserts CallableToken<ParamTypes..., SLOT> in its tokens_,
+   * the parameter type of its insert functions, so the downcast is the one
+   * Signal::Emit() does.
+   */
+  template<size_t ... Indices>
+  void Invoke(std::index_sequence<Indices...>) {
+    typedef internal::CallableToken<ParamTypes..., SLOT> TokenType;
+    static_assert(std::is_base_of<internal::SignalTokenNode, TokenType>::value,
+                  "The tokens of a Signal must be callable with its parameters");
+
+    static_cast<TokenType *>(slot_.it_.get())->Invoke(std::get<Indices>(args_)..., &slot_);
+  }
+
+  Slot slot_;
+
+  std::tuple<typename std::decay<ParamTypes>::type...> args_;
+
+  size_t invoked_count_ = 0;
+
+  bool done_ = false;
+
+};
+
+// Implementation:
+
+template<typename ... ParamTypes>
+template<typename Predicate>
+bool EmitCursor<ParamTypes...>::Run(Predicate exhausted) {
+  if (done_) return true;
+
+  ++slot_;
+  while (slot_.it_) {
+    // Skip the tokens of receivers destroyed in a TrackableTeardownScope:
+    if (nullptr != slot_.it_->binding) {
+      slot_.it_->slot_mark_head.push_back(&slot_.mark_);
+      Invoke(std::index_sequence_for<ParamTypes...>());
+      invoked_count_++;
+      if (slot_.stopped_) break;
+
+      if (exhausted()) {
+        ++slot_;
+        if (!slot_.it_) break;
+
+        Pause();
+        return false;
+      }
+    }
+    ++slot_;
+  }
+
+  slot_.mark_.unlink();
+  done_ = true;
+  return true;
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_EMIT_CURSOR_HPP_
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file epoch.hpp
+ * @brief Header file for epoch-based reclamation of nodes read by concurrent emissions.
+ */
+
+#ifndef WIZTK_BASE_EPOCH_HPP_
+#define WIZTK_BASE_EPOCH_HPP_
+
+#include "sigcxx/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief The epoch announced by one thread.
+ *
+ * Records are allocated once and reused by new threads, they're never freed.
+ * Each one takes a cache line so emitting threads don't share any written line.
+ */
+struct WIZTK_NO_EXPORT alignas(64) EpochRecord {
+  std::atomic<uint64_t> epoch{0};     // 0 when not in a critical section
+  std::atomic<bool> in_use{false};
+  std::atomic<EpochRecord *> waiting_for{nullptr};  // the record waited in Synchronize()
+  int nesting = 0;                    // only accessed by the owner thread
+  EpochRecord *next = nullptr;        // never changes once published
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The process wide epoch-based reclamation domain.
+ *
+ * A thread reading shared nodes (e.g. emitting a ConcurrentSignal) enters a
+ * critical section, which only costs a store of the current epoch and a
+ * fence. A writer unlinks a node then retires it, the node is freed once every
+ * thread which might still see it has left its critical section.
+ *
+ * Synchronize() waits for the other threads instead, it's used when the
+ * writer needs to know that no thread is still using what it has unlinked.
+ */
+class WIZTK_EXPORT EpochDomain {
+
+ public:
+
+  typedef void (*Deleter)(void *);
+
+  /**
+   * @brief Enter a critical section, can be nested.
+   */
+  static void Enter() {
+    EpochRecord *record = GetRecord();
+    if (0 == record->nesting++) {
+      record->epoch.store(global_epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+      // Make the announcement visible before reading any shared node:
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  /**
+   * @brief Leave a critical section.
+   */
+  static void Exit() {
+    EpochRecord *record = GetRecord();
+    if (0 == --record->nesting) {
+      record->epoch.store(0, std::memory_order_release);
+      if (retired_count_.load(std::memory_order_relaxed) > 0) Reclaim();
+    }
+  }
+
+  /**
+   * @brief Returns if the current thread is in a critical section.
+   */
+  static bool IsInCriticalSection() {
+    return GetRecord()->nesting > 0;
+  }
+
+  /**
+   * @brief Wait until all other threads in a critical section started before this call have left it.
+   *
+   * The calling thread itself is not waited, so this can be called in a
+   * critical section (e.g. a receiver destroyed in its own slot). A thread
+   * waiting in this method is waited too, unless it is waiting for the
+   * calling thread, directly or through others: they would wait for each
+   * other forever. Only this cycle is broken, the nodes retired by these
+   * threads are still freed after all of them have left their critical
+   * sections.
+   */
+  static void Synchronize();
+
+  /**
+   * @brief Free a node once no thread can see it any more.
+   */
+  static void Retire(void *node, Deleter deleter);
+
+  template<typename T>
+  static void Retire(T *node) {
+    Retire(node, [](void *p) { delete static_cast<T *>(p); });
+  }
+
+  /**
+   * @brief Free the retired nodes no thread can see.
+   */
+  static void Reclaim();
+
+  /**
+   * @brief Number of nodes waiting to be freed.
+   */
+  static size_t retired_count() {
+    return retired_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+
+  static EpochRecord *GetRecord() {
+    static thread_local EpochRecord *record = nullptr;
+    if (nullptr == record) record = AcquireRecord();
+    return record;
+  }
+
+  static EpochRecord *AcquireRecord();
+
+  static std::atomic<uint64_t> global_epoch_;
+
+  static std::atomic<size_t> retired_count_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A helper class to enter and leave a critical section in a scope.
+ */
+class WIZTK_NO_EXPORT EpochGuard {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EpochGuard);
+
+  EpochGuard() { EpochDomain::Enter(); }
+
+  ~EpochGuard() { EpochDomain::Exit(); }
+
+};
+
+} // namespace internal
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_EPOCH_HPP_
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file event_bus.hpp
+ * @brief Header file for signals found by event names hashed at compile time.
+ */
+
+#ifndef WIZTK_BASE_EVENT_BUS_HPP_
+#define WIZTK_BASE_EVENT_BUS_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief The id of a named event, the 64-bit FNV-1a hash of its name.
+ */
+typedef uint64_t EventId;
+
+/**
+ * @ingroup base
+ * @brief Hash an event name, in a constant expression or at runtime.
+ *
+ * Never returns 0, which marks an empty entry in EventBus.
+ */
+constexpr EventId HashEventName(const char *name, size_t length) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 1099511628211ull;
+  }
+  return 0 == hash ? 1 : hash;
+}
+
+constexpr EventId HashEventName(const char *name) {
+  size_t length = 0;
+  while ('\0' != name[length]) length++;
+  return HashEventName(name, length);
+}
+
+namespace literals {
+
+/**
+ * @ingroup base
+ * @brief The id of an event name, e.g. "order.filled"_ev
+ */
+constexpr EventId operator "" _ev(const char *name, size_t length) {
+  return HashEventName(name, length);
+}
+
+} // namespace literals
+
+/**
+ * @ingroup base
+ * @brief The parameter types of a named event.
+ *
+ * Not defined for names which have not been declared with
+ * WIZTK_DECLARE_EVENT, so emitting or connecting to them does not compile.
+ */
+template<EventId Id>
+struct EventTraits;
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief Base class of the channel of an event in EventBus.
+ */
+class WIZTK_NO_EXPORT EventChannelBase {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EventChannelBase);
+
+  EventChannelBase() = default;
+
+  virtual ~EventChannelBase() = default;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The signal of an event in EventBus.
+ */
+template<typename SignalType>
+class WIZTK_NO_EXPORT EventChannel : public EventChannelBase {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EventChannel);
+
+  EventChannel() = default;
+
+  ~EventChannel() final = default;
+
+  SignalType signal;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The SignalRef type of a Signal type.
+ */
+template<typename SignalType>
+struct WIZTK_NO_EXPORT SignalRefOf;
+
+template<typename ... ParamTypes>
+struct WIZTK_NO_EXPORT SignalRefOf<Signal<ParamTypes...> > {
+  typedef SignalRef<ParamTypes...> type;
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief Named events routed through a flat hash table of signals.
+ *
+ * An event is declared once, at global scope, with its name and parameter
+ * types. Its name is hashed at compile time, so emitting it costs one probe
+ * in an open-addressing table, and the arguments are checked by the
+ * compiler:
+ *
+ * @code
+ * WIZTK_DECLARE_EVENT("order.filled", int, double);
+ *
+ * using namespace sigcxx::literals;
+ *
+ * sigcxx::EventBus bus;
+ * bus.channel<"order.filled"_ev>().Connect(&book, &Book::OnOrderFilled);
+ * bus.Emit<"order.filled"_ev>(42, 10.5);
+ * @endcode
+ *
+ * Two declared names with the same hash are a duplicate specialization of
+ * EventTraits, and fail to compile instead of sharing a channel.
+ *
+ * Like Signal, an EventBus must be used in one thread.
+ */
+class WIZTK_EXPORT EventBus {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EventBus);
+
+  EventBus();
+
+  ~EventBus();
+
+  /**
+   * @brief The signal of an event, created by the first call
+   */
+  template<EventId Id>
+  typename internal::SignalRefOf<typename EventTraits<Id>::SignalType>::type channel() {
+    return typename internal::SignalRefOf<typename EventTraits<Id>::SignalType>::type(GetChannel<Id>()->signal);
+  }
+
+  /**
+   * @brief Emit an event, nothing is done if it has never been connected
+   */
+  template<EventId Id, typename ... ArgTypes>
+  void Emit(ArgTypes &&... args) {
+    typedef internal::EventChannel<typename EventTraits<Id>::SignalType> ChannelType;
+
+    internal::EventChannelBase *channel = Find(Id);
+    if (nullptr == channel) return;
+
+    static_cast<ChannelType *>(channel)->signal.Emit(std::forward<ArgTypes>(args)...);
+  }
+
+  /**
+   * @brief Number of connections to an event
+   */
+  template<EventId Id>
+  int CountConnections() const {
+    typedef internal::EventChannel<typename EventTraits<Id>::SignalType> ChannelType;
+
+    internal::EventChannelBase *channel = Find(Id);
+    return nullptr == channel ? 0 : static_cast<ChannelType *>(channel)->signal.CountConnections();
+  }
+
+  /**
+   * @brief Number of events which have a channel
+   */
+  size_t channel_count() const { return count_; }
+
+ private:
+
+  struct Entry {
+    EventId id;   // 0 if empty
+    internal::EventChannelBase *channel;
+  };
+
+  template<EventId Id>
+  internal::EventChannel<typename EventTraits<Id>::SignalType> *GetChannel() {
+    typedef internal::EventChannel<typename EventTraits<Id>::SignalType> ChannelType;
+
+    internal::EventChannelBase *channel = Find(Id);
+    if (nullptr == channel) {
+      channel = new ChannelType;
+      Insert(Id, channel);
+    }
+    return static_cast<ChannelType *>(channel);
+  }
+
+  /**
+   * @brief Linear probing, the table is never more than half full.
+   */
+  internal::EventChannelBase *Find(EventId id) const {
+    size_t mask = entries_.size() - 1;
+    for (size_t i = Mix(id) & mask;; i = (i + 1) & mask) {
+      const Entry &entry = entries_[i];
+      if (id == entry.id) return entry.channel;
+      if (0 == entry.id) return nullptr;
+    }
+  }
+
+  void Insert(EventId id, internal::EventChannelBase *channel);
+
+  /**
+   * @brief Fold the high bits of the hash into the bits used as the index.
+   */
+  static size_t Mix(EventId id) {
+    return static_cast<size_t>(id ^ (id >> 32));
+  }
+
+  std::vector<Entry> entries_;
+
+  size_t count_ = 0;
+
+};
+
+} // namespace sigcxx
+
+/**
+ * @ingroup base
+ * @brief Declare a named event and its parameter types for EventBus, at global scope.
+ */
+#define WIZTK_DECLARE_EVENT(NAME, ...) \
+  namespace sigcxx { \
+  template<> \
+  struct EventTraits<::sigcxx::HashEventName(NAME)> { \
+    typedef ::sigcxx::Signal<__VA_ARGS__> SignalType; \
+    static constexpr const char *name() { return NAME; } \
+  }; \
+  } \
+  static_assert(true, "")
+
+#endif // WIZTK_BASE_EVENT_BUS_HPP_
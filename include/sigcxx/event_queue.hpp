@@ -0,0 +1,327 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file event_queue.hpp
+ * @brief Header file for queued connections called in another thread.
+ */
+
+#ifndef WIZTK_BASE_EVENT_QUEUE_HPP_
+#define WIZTK_BASE_EVENT_QUEUE_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief A call waiting in an EventQueue.
+ *
+ * The latch of an asynchronous emission counts down when the call is
+ * destroyed, whether it has been run or dropped.
+ */
+class WIZTK_EXPORT QueuedCallBase {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(QueuedCallBase);
+
+  explicit QueuedCallBase(EmitLatch *latch)
+      : latch_(latch) {
+    if (nullptr != latch_) {
+      latch_->Retain();
+      latch_->AddPending();
+    }
+  }
+
+  virtual ~QueuedCallBase() {
+    if (nullptr != latch_) {
+      latch_->CountDown();
+      latch_->Release();
+    }
+  }
+
+  virtual void Run() = 0;
+
+  QueuedCallBase *next = nullptr;
+
+ private:
+
+  EmitLatch *latch_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The shared state of an EventQueue.
+ *
+ * The core is referenced by the queue and by every queued connection, so a
+ * connection can outlive the queue, calls posted after the queue is destroyed
+ * are dropped.
+ */
+class WIZTK_EXPORT EventQueueCore {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EventQueueCore);
+
+  EventQueueCore() = default;
+
+  void Post(QueuedCallBase *call);
+
+  size_t Process();
+
+  bool Wait(int timeout_ms);
+
+  size_t pending_count() const;
+
+  /**
+   * @brief Called by the queue destructor, drop all pending calls.
+   */
+  void Close();
+
+  void Retain() {
+    ref_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Release() {
+    if (1 == ref_count_.fetch_sub(1, std::memory_order_acq_rel)) delete this;
+  }
+
+ private:
+
+  ~EventQueueCore() = default;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  QueuedCallBase *head_ = nullptr;
+  QueuedCallBase *tail_ = nullptr;
+  size_t count_ = 0;
+  bool closed_ = false;
+  std::atomic<long> ref_count_{1};  // the queue itself
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The receiver of a queued connection, shared by the token and its pending calls.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT QueuedTarget {
+
+ public:
+
+  typedef Delegate<void(ParamTypes..., SLOT)> DelegateType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(QueuedTarget);
+
+  explicit QueuedTarget(const DelegateType &d)
+      : delegate(d) {}
+
+  void Retain() {
+    ref_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Release() {
+    if (1 == ref_count_.fetch_sub(1, std::memory_order_acq_rel)) delete this;
+  }
+
+  DelegateType delegate;
+
+  std::atomic<bool> connected{true};
+
+ private:
+
+  ~QueuedTarget() = default;
+
+  std::atomic<long> ref_count_{1};
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A queued call with a copy of the arguments.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT QueuedCall : public QueuedCallBase {
+
+ public:
+
+  QueuedCall(QueuedTarget<ParamTypes...> *target, EmitLatch *latch, ParamTypes ... Args)
+      : QueuedCallBase(latch), target_(target), args_(Args...) {
+    target_->Retain();
+  }
+
+  ~QueuedCall() final {
+    target_->Release();
+  }
+
+  void Run() final {
+    // The receiver is not called once disconnected:
+    if (target_->connected.load(std::memory_order_acquire)) {
+      Call(std::index_sequence_for<ParamTypes...>());
+    }
+  }
+
+ private:
+
+  template<size_t ... Indices>
+  void Call(std::index_sequence<Indices...>) {
+    target_->delegate(std::get<Indices>(args_)..., nullptr);
+  }
+
+  QueuedTarget<ParamTypes...> *target_;
+  std::tuple<typename std::decay<ParamTypes>::type...> args_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A token posting a call to an EventQueue for each emission.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT QueuedToken : public CallableToken<ParamTypes..., SLOT> {
+
+ public:
+
+  typedef typename QueuedTarget<ParamTypes...>::DelegateType DelegateType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(QueuedToken);
+  QueuedToken() = delete;
+
+  QueuedToken(EventQueueCore *queue, const DelegateType &d)
+      : queue_(queue), target_(new QueuedTarget<ParamTypes...>(d)) {
+    queue_->Retain();
+  }
+
+  ~QueuedToken() final {
+    target_->connected.store(false, std::memory_order_release);
+    target_->Release();
+    queue_->Release();
+  }
+
+  virtual void Invoke(ParamTypes ... Args, SLOT slot) final {
+    queue_->Post(new QueuedCall<ParamTypes...>(target_, slot->latch_, Args...));
+  }
+
+ private:
+
+  EventQueueCore *queue_;
+  QueuedTarget<ParamTypes...> *target_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The type of a slot method, used where it should not deduce the parameter types.
+ */
+template<typename T, typename ... ParamTypes>
+struct WIZTK_NO_EXPORT SlotMethod {
+  typedef void (T::*type)(ParamTypes..., SLOT);
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief A queue of slot calls processed in the thread owning the receivers.
+ *
+ * A queued connection copies the arguments of each emission into the queue of
+ * the receiver, the slot method is called later in ProcessEvents():
+ *
+ * @code
+ * sigcxx::EventQueue queue;  // processed in the worker thread
+ *
+ * queue.Connect(producer.data_ready_, &consumer, &Consumer::OnDataReady);
+ *
+ * // in the producer thread:
+ * sigcxx::EmitFuture done = producer.data_ready_.EmitAsync(42);
+ * done.Wait();  // until the worker has called Consumer::OnDataReady()
+ * @endcode
+ *
+ * The slot parameter is nullptr in a queued call, and a disconnected receiver
+ * is not called any more. Calls still pending when the queue is destroyed are
+ * dropped, and so are the calls posted to a destroyed queue.
+ *
+ * Like any other connection, a queued one must be made and broken in the
+ * thread emitting the signal, or when it's not being emitted.
+ */
+class WIZTK_EXPORT EventQueue {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EventQueue);
+
+  EventQueue()
+      : core_(new internal::EventQueueCore) {}
+
+  ~EventQueue() {
+    core_->Close();
+    core_->Release();
+  }
+
+  /**
+   * @brief Connect a signal to a slot method called in this queue
+   */
+  template<typename T, typename ... ParamTypes>
+  void Connect(Signal<ParamTypes...> &signal,
+               T *obj,
+               typename internal::SlotMethod<T, ParamTypes...>::type method,
+               int index = -1) {
+    typedef internal::QueuedToken<ParamTypes...> TokenType;
+    auto *token = new TokenType(core_, TokenType::DelegateType::template FromMethod<T>(obj, method));
+    signal.Connect(token, obj, index);
+  }
+
+  /**
+   * @brief Call all pending slot methods in the current thread.
+   * @return Number of calls
+   */
+  size_t ProcessEvents() {
+    return core_->Process();
+  }
+
+  /**
+   * @brief Block until there is a pending call.
+   * @param timeout_ms Timeout in milliseconds, negative to wait forever
+   * @return True if there is a pending call
+   */
+  bool WaitForEvents(int timeout_ms = -1) {
+    return core_->Wait(timeout_ms);
+  }
+
+  size_t pending_count() const {
+    return core_->pending_count();
+  }
+
+ private:
+
+  internal::EventQueueCore *core_;
+
+};
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_EVENT_QUEUE_HPP_
@@ -73,6 +73,12 @@
 #define WIZTK_NO_EXPORT
 #endif  // WIZTK_SHARED_EXPORT
 
+#if defined(__GNUC__) || defined(__clang__)
+#define WIZTK_PREFETCH(ADDR) __builtin_prefetch(ADDR)
+#else
+#define WIZTK_PREFETCH(ADDR) ((void)(ADDR))
+#endif
+
 #ifndef WIZTK_DEPRECATED
 #define WIZTK_DEPRECATED __attribute__ ((__deprecated__))
 #endif
@@ -0,0 +1,333 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file node_arena.hpp
+ * @brief Header file for the pages the connection nodes are allocated in.
+ */
+
+#ifndef WIZTK_BASE_NODE_ARENA_HPP_
+#define WIZTK_BASE_NODE_ARENA_HPP_
+
+#include "sigcxx/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief Memory statistics of the node arena.
+ */
+struct WIZTK_EXPORT NodeArenaStats {
+
+  size_t page_count = 0;
+
+  size_t empty_page_count = 0;
+
+  /**
+   * @brief Number of live nodes
+   */
+  size_t node_count = 0;
+
+  /**
+   * @brief Number of nodes the pages in use can hold
+   */
+  size_t capacity = 0;
+
+  /**
+   * @brief Bytes mapped for the pages
+   */
+  size_t reserved_bytes = 0;
+
+  /**
+   * @brief The part of the capacity not used by live nodes, from 0 to 1
+   */
+  double fragmentation() const {
+    return 0 == capacity ? 0.0 : 1.0 - static_cast<double>(node_count) / static_cast<double>(capacity);
+  }
+
+};
+
+/**
+ * @ingroup base
+ * @brief The arena which allocates the nodes of every connection.
+ *
+ * Tokens and bindings are allocated in 64 KB pages mapped from the OS, one
+ * set of pages per node size, instead of being spread in the heap among
+ * other small objects. After a lot of connections and disconnections the
+ * pages are left partly used:
+ *
+ * - Compact() moves the bindings into the densest pages and returns the
+ *   pages left empty to the OS.
+ * - TrimMemory() only returns the empty pages.
+ *
+ * Tokens are not moved: emitting slots, EmitCursor, ConcurrentSignal and
+ * ShardedSignal keep pointers to them. A binding is only referred to by its
+ * neighbours in the receiver and by its token, which are fixed up.
+ *
+ * Compact() must be called when no emission, connection or disconnection is
+ * running in any thread and no TrackableTeardownScope is alive, e.g. from an
+ * idle maintenance task. TrimMemory() can be called at any time.
+ */
+class WIZTK_EXPORT NodeArena {
+
+ public:
+
+  NodeArena() = delete;
+
+  /**
+   * @brief Move the bindings into dense pages and free the empty pages
+   * @return Number of bindings moved
+   */
+  static size_t Compact();
+
+  /**
+   * @brief Return the empty pages to the OS
+   * @return Number of bytes returned
+   */
+  static size_t TrimMemory();
+
+  static NodeArenaStats GetStats();
+
+};
+
+namespace internal {
+
+// Token pools in 16-byte steps, up to 256 bytes:
+const size_t kTokenSizeStep = 16;
+const size_t kTokenPoolCount = 16;
+
+/**
+ * @ingroup base_intern
+ * @brief Pages of nodes of one size.
+ */
+class WIZTK_NO_EXPORT NodePool {
+
+ public:
+
+  /**
+   * @brief Move a live node to a free slot, called by Compact()
+   */
+  typedef void (*RelocateFunction)(void *from, void *to);
+
+  static const size_t kPageSize = 64 * 1024;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(NodePool);
+
+  explicit NodePool(size_t node_size, RelocateFunction relocate = nullptr);
+
+  /**
+   * @brief Unmap all pages, only for a pool without live nodes (see Release())
+   *
+   * The pools of the arena live until the process exits.
+   */
+  ~NodePool();
+
+  /**
+   * @brief The pool a node allocated in a page belongs to
+   */
+  static NodePool *Of(void *node);
+
+  void *Allocate();
+
+  void Free(void *node);
+
+  /**
+   * @brief Map the pages for count more nodes at once
+   */
+  void Reserve(size_t count);
+
+  /**
+   * @brief Delete this pool now, or when its last node is freed
+   */
+  void Release();
+
+  size_t Compact();
+
+  size_t Trim();
+
+  void AddStats(NodeArenaStats *stats) const;
+
+  size_t node_size() const { return node_size_; }
+
+  /**
+   * @brief Number of pages to add so that count more nodes can be allocated without mapping
+   */
+  size_t CountMissingPages(size_t count) const;
+
+  /**
+   * @brief Take aligned pages mapped by MapPages()
+   */
+  void AddPages(void *pages, size_t page_count);
+
+  /**
+   * @brief Map page_count contiguous pages aligned to kPageSize
+   * @param populate Fault the memory in at once
+   */
+  static void *MapPages(size_t page_count, bool populate);
+
+ private:
+
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  struct Page;
+
+  static Page *PageOf(const void *node) {
+    return reinterpret_cast<Page *>(reinterpret_cast<uintptr_t>(node) & ~(uintptr_t) (kPageSize - 1));
+  }
+
+  Page *NewPage();
+
+  void InitPage(Page *page);
+
+  void AddAvailable(Page *page);
+
+  void RemoveAvailable(Page *page);
+
+  void *AllocateIn(Page *page);
+
+  void FreeIn(Page *page, void *node);
+
+  size_t TrimLocked();
+
+  mutable std::mutex mutex_;
+
+  size_t node_size_;
+
+  RelocateFunction relocate_;
+
+  // Pages with at least one free slot, and all pages:
+  Page *available_ = nullptr;
+  Page *pages_ = nullptr;
+
+  size_t page_count_ = 0;
+
+  size_t node_count_ = 0;
+
+  bool released_ = false;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The nodes reserved for the connections of one Signal, see Signal::Reserve().
+ *
+ * Nodes from a block are freed like others, into the page they come from.
+ * The block is released with its signal, and its pools are deleted when
+ * their last node is freed, e.g. bindings freed later by a
+ * TrackableTeardownScope.
+ */
+class WIZTK_NO_EXPORT NodeBlock {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(NodeBlock);
+
+  NodeBlock(size_t token_size, size_t binding_size);
+
+  ~NodeBlock();
+
+  NodePool *tokens() const { return tokens_; }
+
+  NodePool *bindings() const { return bindings_; }
+
+  void Reserve(size_t count) {
+    tokens_->Reserve(count);
+    bindings_->Reserve(count);
+  }
+
+  void Trim() {
+    tokens_->Trim();
+    bindings_->Trim();
+  }
+
+  /**
+   * @brief Stats of the pages of this block, in the same form as the arena
+   */
+  NodeArenaStats GetStats() const;
+
+ private:
+
+  NodePool *tokens_;
+
+  NodePool *bindings_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Reserve the pages for a known number of nodes with a single mapping.
+ *
+ * Used to wire many connections at once (see "sigcxx/wiring.hpp").
+ */
+class WIZTK_NO_EXPORT NodeReservation {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(NodeReservation);
+
+  NodeReservation() = default;
+
+  ~NodeReservation() = default;
+
+  void AddTokens(size_t size, size_t count);
+
+  void AddBindings(size_t count) { binding_count_ += count; }
+
+  /**
+   * @brief Map and populate the missing pages of all pools at once
+   * @return Number of pages added
+   */
+  size_t Commit();
+
+ private:
+
+  size_t token_counts_[kTokenPoolCount] = {0};
+
+  size_t binding_count_ = 0;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Allocate a node of the given size, from the arena or the heap if too large.
+ */
+WIZTK_NO_EXPORT void *AllocateTokenNode(size_t size);
+
+/**
+ * @ingroup base_intern
+ * @brief Allocate a node in the given pool if its size matches, or in the arena.
+ */
+WIZTK_NO_EXPORT void *AllocateTokenNode(size_t size, NodePool *pool);
+
+WIZTK_NO_EXPORT void FreeTokenNode(void *node, size_t size);
+
+WIZTK_NO_EXPORT void *AllocateBindingNode();
+
+WIZTK_NO_EXPORT void *AllocateBindingNode(NodePool *pool);
+
+WIZTK_NO_EXPORT void FreeBindingNode(void *node);
+
+} // namespace internal
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_NODE_ARENA_HPP_
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file packed_args.hpp
+ * @brief Header file for packing signal arguments into raw memory.
+ */
+
+#ifndef WIZTK_BASE_PACKED_ARGS_HPP_
+#define WIZTK_BASE_PACKED_ARGS_HPP_
+
+#include "sigcxx/macros.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief Sum of sizeof() of the given types.
+ */
+template<typename ... Types>
+struct SizeOfAll;
+
+template<>
+struct SizeOfAll<> {
+  static constexpr size_t value = 0;
+};
+
+template<typename T, typename ... Rest>
+struct SizeOfAll<T, Rest...> {
+  static constexpr size_t value = sizeof(T) + SizeOfAll<Rest...>::value;
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Check if all the given (decayed) types can be packed into raw memory.
+ */
+template<typename ... Types>
+struct IsPackable;
+
+template<>
+struct IsPackable<> {
+  static constexpr bool value = true;
+};
+
+template<typename T, typename ... Rest>
+struct IsPackable<T, Rest...> {
+  static constexpr bool value = std::is_trivially_copyable<T>::value &&
+      (!std::is_pointer<T>::value) && IsPackable<Rest...>::value;
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Packs signal arguments back to back into untyped memory.
+ * @tparam ParamTypes The parameter types of a Signal
+ *
+ * The packed layout has no padding and no alignment requirement, every value
+ * is copied with memcpy(). It's used to move emitted arguments out of the
+ * current process or across time, so every decayed parameter type must be
+ * trivially copyable and must not be a pointer.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT PackedArgs {
+
+ public:
+
+  static_assert(IsPackable<typename std::decay<ParamTypes>::type...>::value,
+                "Only trivially copyable, non-pointer arguments can be packed");
+
+  typedef std::tuple<typename std::decay<ParamTypes>::type...> TupleType;
+
+  /**
+   * @brief The size in bytes of the packed arguments.
+   */
+  static constexpr size_t kSize = SizeOfAll<typename std::decay<ParamTypes>::type...>::value;
+
+  /**
+   * @brief Copy the given arguments into dst.
+   * @param dst At least kSize bytes
+   */
+  static void Pack(void *dst, const typename std::decay<ParamTypes>::type &... Args) {
+    char *p = static_cast<char *>(dst);
+    int dummy[] = {0, (memcpy(p, &Args, sizeof(Args)), p += sizeof(Args), 0)...};
+    (void) dummy;
+    (void) p;
+  }
+
+  /**
+   * @brief Copy packed arguments from src into a tuple.
+   * @param src At least kSize bytes written by Pack()
+   * @param tuple
+   */
+  static void Unpack(const void *src, TupleType *tuple) {
+    Unpack(src, tuple, std::index_sequence_for<ParamTypes...>());
+  }
+
+  /**
+   * @brief Emit a signal (or call any functor) with the values in a tuple.
+   */
+  template<typename F>
+  static void Apply(F &&func, TupleType &tuple) {
+    Apply(std::forward<F>(func), tuple, std::index_sequence_for<ParamTypes...>());
+  }
+
+ private:
+
+  template<size_t ... I>
+  static void Unpack(const void *src, TupleType *tuple, std::index_sequence<I...>) {
+    const char *p = static_cast<const char *>(src);
+    int dummy[] = {0, (memcpy(&std::get<I>(*tuple), p, sizeof(std::get<I>(*tuple))),
+        p += sizeof(std::get<I>(*tuple)), 0)...};
+    (void) dummy;
+    (void) p;
+  }
+
+  template<typename F, size_t ... I>
+  static void Apply(F &&func, TupleType &tuple, std::index_sequence<I...>) {
+    func(std::get<I>(tuple)...);
+  }
+
+};
+
+} // namespace internal
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_PACKED_ARGS_HPP_
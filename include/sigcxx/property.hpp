@@ -0,0 +1,238 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file property.hpp
+ * @brief Header file for observable values which emit a signal when changed.
+ */
+
+#ifndef WIZTK_BASE_PROPERTY_HPP_
+#define WIZTK_BASE_PROPERTY_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief Defers the notifications of the properties changed in a scope.
+ *
+ * A property changed while a transaction is alive on the thread emits its
+ * signal once when the outermost transaction ends, however many times it was
+ * set, with the value it has then. A nested transaction joins the outermost
+ * one.
+ *
+ * @code
+ * {
+ *   sigcxx::PropertyTransaction transaction;
+ *   width = 640;
+ *   height = 480;
+ *   width = 800;
+ * }  // width.changed() emits 800 once, then height.changed() emits 480
+ * @endcode
+ *
+ * Notifications are sent in the order the properties were first changed. A
+ * property changed by a slot during the commit is notified in the same
+ * commit.
+ */
+class WIZTK_EXPORT PropertyTransaction {
+
+  template<typename T> friend
+  class Property;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(PropertyTransaction);
+
+  PropertyTransaction();
+
+  ~PropertyTransaction();
+
+  /**
+   * @brief Number of notifications waiting for the commit.
+   */
+  size_t pending_count() const {
+    return nullptr == outer_ ? pending_count_ : outer_->pending_count();
+  }
+
+  /**
+   * @brief Returns the outermost transaction of the current thread, or nullptr
+   */
+  static PropertyTransaction *current();
+
+ private:
+
+  typedef void (*NotifyFunction)(void *property);
+
+  struct Entry {
+    void *property;   // nullptr if the property was destroyed
+    NotifyFunction notify;
+  };
+
+  /**
+   * @brief Add a notification, returns its index.
+   */
+  int Enqueue(void *property, NotifyFunction notify);
+
+  /**
+   * @brief Called when a property with a pending notification is destroyed.
+   */
+  void Cancel(int index) {
+    entries_[index].property = nullptr;
+    pending_count_--;
+  }
+
+  PropertyTransaction *outer_ = nullptr;
+
+  std::vector<Entry> entries_;
+
+  size_t pending_count_ = 0;
+
+};
+
+/**
+ * @ingroup base
+ * @brief A value which emits a signal when it changes.
+ *
+ * Setting a value equal to the current one (compared with operator==) emits
+ * nothing. The signal is allocated by the first call to changed(), so a
+ * property nobody observes only takes its value, an index and a pointer (16
+ * bytes for an int), and a change costs a comparison and a store.
+ *
+ * @code
+ * sigcxx::Property<int> width;
+ *
+ * width.changed().Connect(&layout, &Layout::OnWidthChanged);
+ * width = 640;  // emits
+ * width = 640;  // suppressed
+ * @endcode
+ *
+ * @see PropertyTransaction
+ */
+template<typename T>
+class WIZTK_EXPORT Property {
+
+ public:
+
+  typedef Signal<const T &> SignalType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Property);
+
+  Property()
+      : value_() {}
+
+  explicit Property(const T &value)
+      : value_(value) {}
+
+  explicit Property(T &&value)
+      : value_(std::move(value)) {}
+
+  ~Property();
+
+  /**
+   * @brief Change the value
+   * @return true if the value is different and has been changed
+   */
+  bool Set(const T &value) {
+    if (value_ == value) return false;
+    value_ = value;
+    if (nullptr != signal_) Notify();
+    return true;
+  }
+
+  bool Set(T &&value) {
+    if (value_ == value) return false;
+    value_ = std::move(value);
+    if (nullptr != signal_) Notify();
+    return true;
+  }
+
+  Property &operator=(const T &value) {
+    Set(value);
+    return *this;
+  }
+
+  Property &operator=(T &&value) {
+    Set(std::move(value));
+    return *this;
+  }
+
+  const T &value() const { return value_; }
+
+  operator const T &() const { return value_; }
+
+  /**
+   * @brief The signal emitted with the new value, allocated by the first call
+   */
+  SignalRef<const T &> changed() {
+    if (nullptr == signal_) signal_ = new SignalType;
+    return SignalRef<const T &>(*signal_);
+  }
+
+  /**
+   * @brief Returns if changed() has been called and the signal exists
+   */
+  bool IsObserved() const { return nullptr != signal_; }
+
+ private:
+
+  void Notify();
+
+  static void Emit(void *property);
+
+  T value_;
+
+  // Index in the current PropertyTransaction, -1 if no notification is
+  // pending, kept here so a repeated change doesn't touch the signal:
+  int pending_ = -1;
+
+  SignalType *signal_ = nullptr;
+
+};
+
+// Implementation:
+
+template<typename T>
+Property<T>::~Property() {
+  if (nullptr == signal_) return;
+
+  if (pending_ >= 0) PropertyTransaction::current()->Cancel(pending_);
+  delete signal_;
+}
+
+template<typename T>
+void Property<T>::Notify() {
+  PropertyTransaction *transaction = PropertyTransaction::current();
+  if (nullptr == transaction) {
+    signal_->Emit(value_);
+  } else if (pending_ < 0) {
+    pending_ = transaction->Enqueue(this, &Property<T>::Emit);
+  }
+}
+
+template<typename T>
+void Property<T>::Emit(void *property) {
+  Property<T> *self = static_cast<Property<T> *>(property);
+  self->pending_ = -1;
+  self->signal_->Emit(self->value_);
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_PROPERTY_HPP_
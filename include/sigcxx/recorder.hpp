@@ -0,0 +1,329 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file recorder.hpp
+ * @brief Header file for recording emissions into a log file and replaying them.
+ */
+
+#ifndef WIZTK_BASE_RECORDER_HPP_
+#define WIZTK_BASE_RECORDER_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+#include "sigcxx/packed_args.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace sigcxx {
+
+class EmissionRecorder;
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief Base class of a connection from a recorded signal to EmissionRecorder.
+ */
+class WIZTK_NO_EXPORT RecordingTapBase : public Trackable {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(RecordingTapBase);
+
+  RecordingTapBase(EmissionRecorder *recorder, uint32_t signal_id)
+      : recorder_(recorder), signal_id_(signal_id) {}
+
+  ~RecordingTapBase() override = default;
+
+ protected:
+
+  EmissionRecorder *recorder_;
+  uint32_t signal_id_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A slot object packing the arguments of each emission into the log.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT RecordingTap : public RecordingTapBase {
+
+ public:
+
+  typedef PackedArgs<ParamTypes...> PackedType;
+
+  RecordingTap(EmissionRecorder *recorder, uint32_t signal_id)
+      : RecordingTapBase(recorder, signal_id) {}
+
+  ~RecordingTap() final = default;
+
+  void OnEmit(ParamTypes ... Args, __SLOT__);
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Base class to decode a record and emit a signal.
+ */
+class WIZTK_NO_EXPORT ReplayChannelBase {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ReplayChannelBase);
+
+  explicit ReplayChannelBase(size_t size)
+      : size_(size) {}
+
+  virtual ~ReplayChannelBase() = default;
+
+  virtual void Emit(const void *payload) = 0;
+
+  size_t size() const { return size_; }
+
+ private:
+
+  size_t size_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Decode a record and emit the signal chained to it.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT ReplayChannel : public ReplayChannelBase {
+
+ public:
+
+  typedef PackedArgs<ParamTypes...> PackedType;
+
+  explicit ReplayChannel(Signal<ParamTypes...> &signal)
+      : ReplayChannelBase(PackedType::kSize) {
+    source_.Connect(signal);
+  }
+
+  ~ReplayChannel() final = default;
+
+  void Emit(const void *payload) final {
+    PackedType::Unpack(payload, &args_);
+    PackedType::Apply(source_, args_);
+  }
+
+ private:
+
+  Signal<ParamTypes...> source_;
+  typename PackedType::TupleType args_;
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief Record the emissions of selected signals into a memory-mapped log.
+ *
+ * Each record contains a timestamp (nanoseconds since Open()), the signal id
+ * given in Record() and the packed arguments. Appending a record is a bump of
+ * the write position in the mapped file and a memcpy of the arguments, the
+ * file is only remapped when it has to grow. The size of the recorded data in
+ * the file header is updated after each record, so the log of a process which
+ * crashed before Close() can still be replayed.
+ *
+ * @code
+ * sigcxx::EmissionRecorder recorder;
+ *
+ * recorder.Open("emissions.log");
+ * recorder.Record(widget.resized_, 1);
+ * recorder.Record(widget.clicked_, 2);
+ * @endcode
+ *
+ * All arguments of a recorded signal must be trivially copyable values.
+ */
+class WIZTK_EXPORT EmissionRecorder {
+
+  template<typename ... ParamTypes> friend
+  class internal::RecordingTap;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmissionRecorder);
+
+  EmissionRecorder() = default;
+
+  /**
+   * @brief Destructor, disconnect all recorded signals and close the log.
+   */
+  ~EmissionRecorder();
+
+  /**
+   * @brief Create (or truncate) a log file.
+   * @param path
+   * @param initial_size Initial size of the mapping, it's doubled on demand
+   * @return True if success, false otherwise and errno is set
+   */
+  bool Open(const char *path, size_t initial_size = 1 << 20);
+
+  /**
+   * @brief Stop recording, trim the log file to the recorded size and close it.
+   */
+  void Close();
+
+  /**
+   * @brief Start recording a signal.
+   * @param signal
+   * @param signal_id The id used to bind the signal in EmissionReplayer
+   */
+  template<typename ... ParamTypes>
+  void Record(Signal<ParamTypes...> &signal, uint32_t signal_id);
+
+  bool is_open() const { return nullptr != base_; }
+
+  /**
+   * @brief Number of records written.
+   */
+  size_t record_count() const { return record_count_; }
+
+ private:
+
+  /**
+   * @brief Start a record.
+   * @return The memory to pack the payload into, nullptr if the record is
+   * dropped because the log is not open or cannot grow
+   */
+  void *Append(uint32_t signal_id, size_t size);
+
+  /**
+   * @brief Publish the records appended so far in the file header.
+   */
+  void Commit();
+
+  bool Grow(size_t required);
+
+  std::vector<std::unique_ptr<internal::RecordingTapBase> > taps_;
+
+  int fd_ = -1;
+  unsigned char *base_ = nullptr;
+  size_t capacity_ = 0;
+  size_t offset_ = 0;
+  size_t record_count_ = 0;
+  int64_t start_time_ = 0;
+
+};
+
+/**
+ * @ingroup base
+ * @brief Read a log written by EmissionRecorder and emit the recorded signals again.
+ *
+ * @code
+ * sigcxx::EmissionReplayer replayer;
+ *
+ * replayer.Open("emissions.log");
+ * replayer.Bind(other_widget.resized_, 1);
+ * replayer.Bind(other_widget.clicked_, 2);
+ * replayer.Replay(sigcxx::EmissionReplayer::kMaximumSpeed);
+ * @endcode
+ *
+ * Records of signal ids not bound are skipped. A bound signal is chained, so it
+ * can be destroyed before the replayer.
+ */
+class WIZTK_EXPORT EmissionReplayer {
+
+ public:
+
+  /**
+   * @brief The replay speed.
+   */
+  enum Speed {
+    kOriginalSpeed,                     /**< Keep the recorded interval between emissions */
+    kMaximumSpeed                       /**< Emit as fast as possible */
+  };
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmissionReplayer);
+
+  EmissionReplayer() = default;
+
+  ~EmissionReplayer();
+
+  /**
+   * @brief Map a log file.
+   * @param path
+   * @return True if success
+   */
+  bool Open(const char *path);
+
+  void Close();
+
+  /**
+   * @brief Emit the given signal for each record with the given id.
+   */
+  template<typename ... ParamTypes>
+  void Bind(Signal<ParamTypes...> &signal, uint32_t signal_id);
+
+  /**
+   * @brief Emit all records in the log.
+   *
+   * Stops at the first record which does not fit in the log.
+   *
+   * @param speed
+   * @return Number of records emitted
+   */
+  size_t Replay(Speed speed = kMaximumSpeed);
+
+  /**
+   * @brief Number of records in the log, up to the first one which does not fit.
+   */
+  size_t CountRecords() const;
+
+ private:
+
+  std::unordered_map<uint32_t, std::unique_ptr<internal::ReplayChannelBase> > channels_;
+
+  const unsigned char *base_ = nullptr;
+  size_t size_ = 0;
+  size_t data_size_ = 0;
+
+};
+
+// Implementation:
+
+template<typename ... ParamTypes>
+void internal::RecordingTap<ParamTypes...>::OnEmit(ParamTypes ... Args, SLOT) {
+  void *payload = recorder_->Append(signal_id_, PackedType::kSize);
+  if (nullptr == payload) return;
+
+  PackedType::Pack(payload, Args...);
+  recorder_->Commit();
+}
+
+template<typename ... ParamTypes>
+void EmissionRecorder::Record(Signal<ParamTypes...> &signal, uint32_t signal_id) {
+  auto *tap = new internal::RecordingTap<ParamTypes...>(this, signal_id);
+  taps_.emplace_back(tap);
+  signal.Connect(tap, &internal::RecordingTap<ParamTypes...>::OnEmit);
+}
+
+template<typename ... ParamTypes>
+void EmissionReplayer::Bind(Signal<ParamTypes...> &signal, uint32_t signal_id) {
+  channels_[signal_id].reset(new internal::ReplayChannel<ParamTypes...>(signal));
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_RECORDER_HPP_
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file selector.hpp
+ * @brief Header file for waiting on whichever of many signals fires first.
+ */
+
+#ifndef WIZTK_BASE_SELECTOR_HPP_
+#define WIZTK_BASE_SELECTOR_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sigcxx {
+
+class SignalSelector;
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief A block of ready bits in SignalSelector.
+ *
+ * Each bit in summary tells if the corresponding word may have a ready bit, so
+ * a poll only loads the words which have been touched.
+ */
+struct WIZTK_NO_EXPORT SelectorBlock {
+
+  static const int kWordCount = 64;
+
+  static const int kCapacity = kWordCount * 64;
+
+  SelectorBlock() {
+    summary.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kWordCount; i++) words[i].store(0, std::memory_order_relaxed);
+  }
+
+  void Set(int bit) {
+    int word = bit >> 6;
+    words[word].fetch_or(uint64_t(1) << (bit & 63));
+    summary.fetch_or(uint64_t(1) << word);
+  }
+
+  void Clear(int bit) {
+    words[bit >> 6].fetch_and(~(uint64_t(1) << (bit & 63)));
+  }
+
+  bool Test(int bit) const {
+    return 0 != (words[bit >> 6].load() & (uint64_t(1) << (bit & 63)));
+  }
+
+  std::atomic<uint64_t> summary;
+  std::atomic<uint64_t> words[kWordCount];
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Base class of a connection from a watched signal to SignalSelector.
+ */
+class WIZTK_NO_EXPORT SelectorWatchBase : public Trackable {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SelectorWatchBase);
+
+  SelectorWatchBase(SignalSelector *selector, SelectorBlock *block, int bit)
+      : selector_(selector), block_(block), bit_(bit) {}
+
+  ~SelectorWatchBase() override = default;
+
+ protected:
+
+  inline void Notify();
+
+ private:
+
+  SignalSelector *selector_;
+  SelectorBlock *block_;
+  int bit_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief A slot object setting the ready bit of a watched signal.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT SelectorWatch : public SelectorWatchBase {
+
+ public:
+
+  SelectorWatch(SignalSelector *selector, SelectorBlock *block, int bit)
+      : SelectorWatchBase(selector, block, bit) {}
+
+  ~SelectorWatch() final = default;
+
+  void OnEmit(ParamTypes ..., SLOT) {
+    Notify();
+  }
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief Wait for any of many signals.
+ *
+ * A selector connects to any number of signals with different signatures and
+ * keeps one ready bit for each of them. An emission only sets the bit, the
+ * arguments are dropped:
+ *
+ * @code
+ * sigcxx::SignalSelector selector;
+ *
+ * int finished = selector.Add(job.finished_);
+ * int cancelled = selector.Add(button.clicked_);
+ *
+ * int index = selector.Wait(1000);  // or Take() in a polling loop
+ * if (index == cancelled) { ... }
+ * @endcode
+ *
+ * The ready bits are a two level lock-free bitmap: setting a bit costs two
+ * atomic ORs, and a poll only loads the words marked in the summary, so it
+ * stays cheap with thousands of signals.
+ *
+ * Add(), Remove() and Clear() change connections, so they must not run while
+ * the watched signals are being emitted or another thread is polling the
+ * selector. Once set up, the signals can be emitted in any thread, and Poll(),
+ * Take() or Wait() can be called in any other thread. Wait() and fd() need the
+ * event fd created in the constructor, a thread blocking on it is only woken
+ * once for a burst of emissions.
+ *
+ * All watched signals are disconnected when the selector is destroyed.
+ */
+class WIZTK_EXPORT SignalSelector {
+
+  friend class internal::SelectorWatchBase;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SignalSelector);
+
+  /**
+   * @brief Constructor.
+   * @param blocking Create an event fd for Wait() and fd()
+   */
+  explicit SignalSelector(bool blocking = true);
+
+  ~SignalSelector();
+
+  /**
+   * @brief Watch a signal.
+   * @return The index of the signal in this selector
+   *
+   * Indices of removed signals are reused.
+   */
+  template<typename ... ParamTypes>
+  int Add(Signal<ParamTypes...> &signal);
+
+  template<typename ... ParamTypes>
+  int Add(SignalRef<ParamTypes...> signal);
+
+  /**
+   * @brief Disconnect the signal at the given index and clear its ready bit.
+   */
+  void Remove(int index);
+
+  /**
+   * @brief Disconnect all signals.
+   */
+  void Clear();
+
+  /**
+   * @brief Returns if any watched signal has been emitted since it was taken.
+   */
+  bool Poll() const;
+
+  /**
+   * @brief Returns if the signal at the given index is ready.
+   */
+  bool IsReady(int index) const;
+
+  /**
+   * @brief Take a ready signal.
+   * @return The lowest ready index, or -1 if none is ready
+   *
+   * The ready bit is cleared.
+   */
+  int Take();
+
+  /**
+   * @brief Take all ready signals.
+   * @param indices The ready indices are appended to this vector in ascending order
+   * @return Number of indices appended
+   */
+  size_t TakeAll(std::vector<int> *indices);
+
+  /**
+   * @brief Block until a signal is ready and take it.
+   * @param timeout_ms Timeout in milliseconds, negative to wait forever
+   * @return The taken index, or -1 on timeout or error
+   */
+  int Wait(int timeout_ms = -1);
+
+  /**
+   * @brief The event fd readable when a signal is ready, or -1.
+   *
+   * This can be added to an external poll loop, call Take() or TakeAll()
+   * when it's readable.
+   */
+  int fd() const { return event_fd_; }
+
+  /**
+   * @brief Number of watched signals.
+   */
+  size_t size() const { return watch_count_; }
+
+ private:
+
+  int Allocate(internal::SelectorBlock **block, int *bit);
+
+  void Notify(internal::SelectorBlock *block, int bit) {
+    block->Set(bit);
+    if ((event_fd_ >= 0) && !signaled_.exchange(true)) WakeUp();
+  }
+
+  void WakeUp();
+
+  void DrainEventFd();
+
+  std::vector<std::unique_ptr<internal::SelectorBlock> > blocks_;
+
+  std::vector<std::unique_ptr<internal::SelectorWatchBase> > watches_;
+
+  std::vector<int> free_indices_;
+
+  size_t watch_count_ = 0;
+
+  int event_fd_ = -1;
+
+  int write_fd_ = -1;  // the other end of the pipe if eventfd is not available
+
+  std::atomic<bool> signaled_;
+
+};
+
+// Implementation:
+
+void internal::SelectorWatchBase::Notify() {
+  selector_->Notify(block_, bit_);
+}
+
+template<typename ... ParamTypes>
+int SignalSelector::Add(Signal<ParamTypes...> &signal) {
+  return Add(SignalRef<ParamTypes...>(signal));
+}
+
+template<typename ... ParamTypes>
+int SignalSelector::Add(SignalRef<ParamTypes...> signal) {
+  internal::SelectorBlock *block = nullptr;
+  int bit = 0;
+  int index = Allocate(&block, &bit);
+
+  auto *watch = new internal::SelectorWatch<ParamTypes...>(this, block, bit);
+  watches_[index].reset(watch);
+  signal.Connect(watch, &internal::SelectorWatch<ParamTypes...>::OnEmit);
+  return index;
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_SELECTOR_HPP_
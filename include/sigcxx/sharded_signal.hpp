@@ -0,0 +1,395 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file sharded_signal.hpp
+ * @brief Header file for a signal replicated per thread for high-rate emission.
+ */
+
+#ifndef WIZTK_BASE_SHARDED_SIGNAL_HPP_
+#define WIZTK_BASE_SHARDED_SIGNAL_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+#include "sigcxx/epoch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+namespace sigcxx {
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief Returns a small index of the current thread, used to pick a shard.
+ *
+ * Threads are numbered in the order they first emit, so consecutive threads
+ * get different shards.
+ */
+inline unsigned int GetThreadIndex() {
+  static std::atomic<unsigned int> counter(0);
+  static thread_local unsigned int index = counter.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+/**
+ * @ingroup base_intern
+ * @brief A connection of a ShardedSignal.
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT ShardedToken : public SignalTokenNode {
+
+ public:
+
+  typedef Delegate<void(ParamTypes..., SLOT)> DelegateType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ShardedToken);
+  ShardedToken() = delete;
+
+  ShardedToken(ShardedSignal<ParamTypes...> *signal, const DelegateType &d)
+      : delegate(d), signal_(signal) {}
+
+  ~ShardedToken() final = default;
+
+  void Dispose() final {
+    signal_->Remove(this);
+  }
+
+  DelegateType delegate;
+
+  std::atomic<bool> alive{true};
+
+ private:
+
+  ShardedSignal<ParamTypes...> *signal_;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief An immutable copy of the delegates, read by the threads of one shard.
+ *
+ * Each delegate keeps a pointer to the alive flag of its token, so a
+ * connection removed during an emission is not called any more.
+ */
+template<typename ... ParamTypes>
+struct WIZTK_NO_EXPORT ShardReplica {
+  struct Entry {
+    Delegate<void(ParamTypes..., SLOT)> delegate;
+    const std::atomic<bool> *alive;
+  };
+  std::vector<Entry> entries;
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The replica pointer of a shard, on its own cache line.
+ *
+ * The replica is rebuilt when version differs from the version of the signal.
+ */
+template<typename ... ParamTypes>
+struct WIZTK_NO_EXPORT alignas(64) Shard {
+  std::atomic<ShardReplica<ParamTypes...> *> replica{nullptr};
+  std::atomic<uint64_t> version{0};
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief A signal emitted at a high rate in many threads.
+ *
+ * Each shard keeps its own replica of the connected delegates, on its own
+ * cache lines, and a thread always reads the replica of its shard. Emit()
+ * only reads memory written by connection changes and the epoch record of
+ * the current thread, no lock, no shared reference count, so it scales with
+ * the number of cores.
+ *
+ * A connection change takes a mutex and marks all replicas out of date. The
+ * next emission in a shard rebuilds its replica under the mutex and retires the
+ * old one with the EpochDomain, so a burst of N connections costs one rebuild
+ * per shard, not N. This is still much more expensive than with Signal: use
+ * this for signals connected once and emitted very often.
+ *
+ * @code
+ * sigcxx::ShardedSignal<const Sample &> sampled;  // one shard per core
+ *
+ * sampled.Connect(&histogram, &Histogram::OnSample);
+ * // in any thread:
+ * sampled.Emit(sample);
+ * @endcode
+ *
+ * As in ConcurrentSignal, a receiver can be destroyed while other threads
+ * emit, no invocation is running or starts after ~Trackable() returns, and a
+ * receiver destroyed in a slot is not called by the emission in progress. The
+ * slot parameter is nullptr.
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT ShardedSignal {
+
+  friend class internal::ShardedToken<ParamTypes...>;
+
+ public:
+
+  typedef internal::ShardedToken<ParamTypes...> TokenType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ShardedSignal);
+
+  /**
+   * @brief Constructor.
+   * @param shard_count Number of replicas, 0 for the number of cores
+   */
+  explicit ShardedSignal(unsigned int shard_count = 0);
+
+  ~ShardedSignal();
+
+  /**
+   * @brief Connect this signal to a slot method in a observer
+   */
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes..., SLOT));
+
+  /**
+   * @brief Disconnect all delegates to a method
+   * @return Number of connections broken
+   */
+  template<typename T>
+  int DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT));
+
+  /**
+   * @brief Disconnect all
+   */
+  int DisconnectAll();
+
+  int CountConnections() const;
+
+  unsigned int shard_count() const { return shard_count_; }
+
+  void Emit(ParamTypes ... Args) {
+    internal::EpochGuard guard;
+
+    ShardType *shard = &shards_[internal::GetThreadIndex() % shard_count_];
+    if (shard->version.load(std::memory_order_acquire) != version_.load(std::memory_order_acquire))
+      Rebuild(shard);
+
+    const ReplicaType *replica = shard->replica.load(std::memory_order_acquire);
+    if (nullptr == replica) return;
+
+    for (const auto &entry : replica->entries) {
+      // Sequentially consistent, pairs with EpochDomain::Synchronize() in Remove():
+      if (entry.alive->load()) entry.delegate(Args..., nullptr);
+    }
+  }
+
+  void operator()(ParamTypes ... Args) {
+    Emit(Args...);
+  }
+
+ private:
+
+  typedef internal::Shard<ParamTypes...> ShardType;
+
+  typedef internal::ShardReplica<ParamTypes...> ReplicaType;
+
+  /**
+   * @brief Called when the binding of a token is destroyed.
+   */
+  void Remove(TokenType *token);
+
+  /**
+   * @brief Mark all replicas out of date, the mutex must be locked.
+   */
+  void Publish();
+
+  /**
+   * @brief Build a new replica of a shard from tokens_, in an emission.
+   */
+  void Rebuild(ShardType *shard);
+
+  /**
+   * @brief Wait for emissions reading the old replicas and free the removed tokens.
+   */
+  static void Release(const std::vector<TokenType *> &tokens);
+
+  mutable std::mutex mutex_;
+
+  std::vector<TokenType *> tokens_;
+
+  /**
+   * @brief Incremented by each connection change.
+   */
+  std::atomic<uint64_t> version_{0};
+
+  ShardType *shards_ = nullptr;
+
+  unsigned int shard_count_;
+
+};
+
+// Implementation:
+
+template<typename ... ParamTypes>
+ShardedSignal<ParamTypes...>::ShardedSignal(unsigned int shard_count)
+    : shard_count_(shard_count) {
+  if (0 == shard_count_) shard_count_ = std::max(1u, std::thread::hardware_concurrency());
+
+  void *memory = nullptr;
+  if (0 != posix_memalign(&memory, alignof(ShardType), sizeof(ShardType) * shard_count_)) throw std::bad_alloc();
+  shards_ = static_cast<ShardType *>(memory);
+  for (unsigned int i = 0; i < shard_count_; i++) new(&shards_[i]) ShardType;
+}
+
+template<typename ... ParamTypes>
+ShardedSignal<ParamTypes...>::~ShardedSignal() {
+  DisconnectAll();
+
+  for (unsigned int i = 0; i < shard_count_; i++) {
+    ReplicaType *replica = shards_[i].replica.load(std::memory_order_acquire);
+    if (nullptr != replica) internal::EpochDomain::Retire(replica);
+    shards_[i].~ShardType();
+  }
+  free(shards_);
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+void ShardedSignal<ParamTypes...>::Connect(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
+  auto *token = new TokenType(this, TokenType::DelegateType::template FromMethod<T>(obj, method));
+  auto *binding = new internal::TrackableBindingNode;
+
+  Trackable::Link(token, binding);
+  Trackable::PushBackBinding(obj, binding);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  tokens_.push_back(token);
+  Publish();
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+int ShardedSignal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
+  std::vector<TokenType *> removed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::remove_if(tokens_.begin(), tokens_.end(), [obj, method, &removed](TokenType *token) {
+      if ((token->binding->trackable == obj) && token->delegate.template Equal<T>(obj, method)) {
+        removed.push_back(token);
+        return true;
+      }
+      return false;
+    });
+    if (removed.empty()) return 0;
+
+    tokens_.erase(it, tokens_.end());
+    Publish();
+  }
+
+  Release(removed);
+  return static_cast<int>(removed.size());
+}
+
+template<typename ... ParamTypes>
+int ShardedSignal<ParamTypes...>::DisconnectAll() {
+  std::vector<TokenType *> removed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tokens_.empty()) return 0;
+
+    removed.swap(tokens_);
+    Publish();
+  }
+
+  Release(removed);
+  return static_cast<int>(removed.size());
+}
+
+template<typename ... ParamTypes>
+int ShardedSignal<ParamTypes...>::CountConnections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(tokens_.size());
+}
+
+template<typename ... ParamTypes>
+void ShardedSignal<ParamTypes...>::Remove(TokenType *token) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find(tokens_.begin(), tokens_.end(), token);
+    // Already removed by a disconnect method which will free it:
+    if (it == tokens_.end()) return;
+
+    tokens_.erase(it);
+    token->alive.store(false);
+    Publish();
+  }
+
+  internal::EpochDomain::Synchronize();
+  internal::EpochDomain::Retire(token);
+}
+
+template<typename ... ParamTypes>
+void ShardedSignal<ParamTypes...>::Publish() {
+  version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+template<typename ... ParamTypes>
+void ShardedSignal<ParamTypes...>::Rebuild(ShardType *shard) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  uint64_t version = version_.load(std::memory_order_relaxed);
+  // Rebuilt by another thread of this shard:
+  if (shard->version.load(std::memory_order_relaxed) == version) return;
+
+  ReplicaType *replica = nullptr;
+  if (!tokens_.empty()) {
+    // Each shard gets its own copy, allocated by a thread of the shard:
+    replica = new ReplicaType;
+    replica->entries.reserve(tokens_.size());
+    for (TokenType *token : tokens_) replica->entries.push_back({token->delegate, &token->alive});
+  }
+
+  ReplicaType *old = shard->replica.exchange(replica, std::memory_order_acq_rel);
+  shard->version.store(version, std::memory_order_release);
+
+  // Other threads of this shard may still read the old replica:
+  if (nullptr != old) internal::EpochDomain::Retire(old);
+}
+
+template<typename ... ParamTypes>
+void ShardedSignal<ParamTypes...>::Release(const std::vector<TokenType *> &tokens) {
+  for (TokenType *token : tokens) {
+    token->alive.store(false);
+    if (nullptr != token->binding) {
+      token->binding->token = nullptr;
+      delete token->binding;
+      token->binding = nullptr;
+    }
+  }
+
+  internal::EpochDomain::Synchronize();
+  for (TokenType *token : tokens) {
+    internal::EpochDomain::Retire(token);
+  }
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_SHARDED_SIGNAL_HPP_
@@ -0,0 +1,357 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file shared_payload.hpp
+ * @brief Header file for pooled, reference counted payloads shared by slots.
+ */
+
+#ifndef WIZTK_BASE_SHARED_PAYLOAD_HPP_
+#define WIZTK_BASE_SHARED_PAYLOAD_HPP_
+
+#include "sigcxx/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sigcxx {
+
+template<typename T>
+class PayloadPool;
+
+template<typename T>
+class SharedPayload;
+
+namespace internal {
+
+template<typename T>
+class PayloadPoolCore;
+
+/**
+ * @ingroup base_intern
+ * @brief A memory block of PayloadPool with an intrusive reference count.
+ */
+template<typename T>
+struct WIZTK_NO_EXPORT PayloadBlock {
+
+  T *value() {
+    return reinterpret_cast<T *>(&storage);
+  }
+
+  std::atomic<long> ref_count;
+  PayloadPoolCore<T> *pool;
+  PayloadBlock *next_free;
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The free list of PayloadPool.
+ *
+ * The core is referenced by the pool and by every block in use, so a payload
+ * can outlive the pool it was made from.
+ */
+template<typename T>
+class WIZTK_NO_EXPORT PayloadPoolCore {
+
+ public:
+
+  typedef PayloadBlock<T> BlockType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(PayloadPoolCore);
+
+  explicit PayloadPoolCore(size_t max_free)
+      : max_free_(max_free) {}
+
+  BlockType *Acquire() {
+    BlockType *block = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      block = free_list_;
+      if (nullptr != block) {
+        free_list_ = block->next_free;
+        --free_count_;
+        ++ref_count_;
+      }
+    }
+
+    if (nullptr == block) {
+      // Take the reference after the allocation, which may throw:
+      block = new BlockType;
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++ref_count_;
+    }
+
+    block->ref_count.store(1, std::memory_order_relaxed);
+    block->pool = this;
+    block->next_free = nullptr;
+    return block;
+  }
+
+  void Recycle(BlockType *block) {
+    bool keep = false;
+    bool last = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      keep = !detached_ && (free_count_ < max_free_);
+      if (keep) {
+        block->next_free = free_list_;
+        free_list_ = block;
+        ++free_count_;
+      }
+      last = (0 == --ref_count_);
+    }
+
+    if (!keep) delete block;
+    if (last) delete this;
+  }
+
+  void Reserve(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (free_count_ < count) {
+      auto *block = new BlockType;
+      block->next_free = free_list_;
+      free_list_ = block;
+      ++free_count_;
+    }
+    if (max_free_ < count) max_free_ = count;
+  }
+
+  /**
+   * @brief Called by the pool destructor.
+   */
+  void Detach() {
+    BlockType *list = nullptr;
+    bool last = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      detached_ = true;
+      list = free_list_;
+      free_list_ = nullptr;
+      free_count_ = 0;
+      last = (0 == --ref_count_);
+    }
+
+    while (nullptr != list) {
+      BlockType *next = list->next_free;
+      delete list;
+      list = next;
+    }
+
+    if (last) delete this;
+  }
+
+  size_t free_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_count_;
+  }
+
+  size_t in_use_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ref_count_ - (detached_ ? 0 : 1);
+  }
+
+ private:
+
+  ~PayloadPoolCore() = default;
+
+  mutable std::mutex mutex_;
+  BlockType *free_list_ = nullptr;
+  size_t free_count_ = 0;
+  size_t max_free_;
+  size_t ref_count_ = 1;  // the pool itself
+  bool detached_ = false;
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief A handle to an immutable payload made by PayloadPool.
+ * @tparam T The payload type
+ *
+ * Copying a handle only increases an atomic reference count stored next to
+ * the payload, when the last handle is destroyed the payload is destructed and
+ * its memory goes back to the pool.
+ *
+ * Declare a signal with a const reference to the handle so one payload is
+ * shared by all slots without touching the reference count at all, a slot
+ * which needs the payload later (e.g. queued to another thread) just keeps a
+ * copy of the handle:
+ *
+ * @code
+ * sigcxx::Signal<const sigcxx::SharedPayload<Frame> &> frame_ready;
+ * sigcxx::PayloadPool<Frame> pool;
+ *
+ * frame_ready.Emit(pool.Make(width, height));
+ * @endcode
+ */
+template<typename T>
+class WIZTK_EXPORT SharedPayload {
+
+  friend class PayloadPool<T>;
+
+ public:
+
+  SharedPayload() = default;
+
+  SharedPayload(const SharedPayload &other) noexcept
+      : block_(other.block_) {
+    if (nullptr != block_) block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  SharedPayload(SharedPayload &&other) noexcept
+      : block_(other.block_) {
+    other.block_ = nullptr;
+  }
+
+  ~SharedPayload() {
+    Reset();
+  }
+
+  SharedPayload &operator=(const SharedPayload &other) noexcept {
+    SharedPayload(other).Swap(*this);
+    return *this;
+  }
+
+  SharedPayload &operator=(SharedPayload &&other) noexcept {
+    SharedPayload(std::move(other)).Swap(*this);
+    return *this;
+  }
+
+  /**
+   * @brief Release the payload referenced by this handle.
+   */
+  void Reset() {
+    if (nullptr == block_) return;
+
+    if (1 == block_->ref_count.fetch_sub(1, std::memory_order_acq_rel)) {
+      block_->value()->~T();
+      block_->pool->Recycle(block_);
+    }
+    block_ = nullptr;
+  }
+
+  void Swap(SharedPayload &other) noexcept {
+    std::swap(block_, other.block_);
+  }
+
+  const T *get() const { return nullptr == block_ ? nullptr : block_->value(); }
+
+  const T &operator*() const { return *block_->value(); }
+
+  const T *operator->() const { return block_->value(); }
+
+  explicit operator bool() const { return nullptr != block_; }
+
+  /**
+   * @brief Returns the number of handles referencing the same payload.
+   */
+  long use_count() const {
+    return nullptr == block_ ? 0 : block_->ref_count.load(std::memory_order_relaxed);
+  }
+
+ private:
+
+  typedef internal::PayloadBlock<T> BlockType;
+
+  explicit SharedPayload(BlockType *block)
+      : block_(block) {}
+
+  BlockType *block_ = nullptr;
+
+};
+
+/**
+ * @ingroup base
+ * @brief A thread-safe pool of memory blocks for SharedPayload.
+ * @tparam T The payload type
+ *
+ * Payloads made by a pool can outlive it, their blocks are freed instead of
+ * recycled once the pool is destroyed.
+ */
+template<typename T>
+class WIZTK_EXPORT PayloadPool {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(PayloadPool);
+
+  /**
+   * @brief Constructor.
+   * @param max_free The maximum number of free blocks kept for reuse
+   */
+  explicit PayloadPool(size_t max_free = 64)
+      : core_(new internal::PayloadPoolCore<T>(max_free)) {}
+
+  ~PayloadPool() {
+    core_->Detach();
+  }
+
+  /**
+   * @brief Construct a payload in a pooled block.
+   *
+   * If the constructor of T throws, the block goes back to the pool and the
+   * exception is rethrown.
+   */
+  template<typename ... Args>
+  SharedPayload<T> Make(Args &&... args) {
+    internal::PayloadBlock<T> *block = core_->Acquire();
+    try {
+      new(block->value()) T(std::forward<Args>(args)...);
+    } catch (...) {
+      core_->Recycle(block);
+      throw;
+    }
+    return SharedPayload<T>(block);
+  }
+
+  /**
+   * @brief Preallocate free blocks.
+   */
+  void Reserve(size_t count) {
+    core_->Reserve(count);
+  }
+
+  /**
+   * @brief Number of free blocks ready for reuse.
+   */
+  size_t free_count() const {
+    return core_->free_count();
+  }
+
+  /**
+   * @brief Number of blocks referenced by a SharedPayload.
+   */
+  size_t in_use_count() const {
+    return core_->in_use_count();
+  }
+
+ private:
+
+  internal::PayloadPoolCore<T> *core_;
+
+};
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_SHARED_PAYLOAD_HPP_
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file shm_channel.hpp
+ * @brief Header file for transporting signals between processes through shared memory.
+ */
+
+#ifndef WIZTK_BASE_SHM_CHANNEL_HPP_
+#define WIZTK_BASE_SHM_CHANNEL_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+#include "sigcxx/packed_args.hpp"
+
+#include <cstdint>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief A single-producer, multi-consumer ring buffer in POSIX shared memory.
+ *
+ * The producer creates a named ring with Create() and each consumer process
+ * maps the same ring with Open(). Every consumer reads every message (this is
+ * a broadcast ring), so the producer never waits for slow consumers: old
+ * messages are overwritten and a consumer detects the loss by the sequence
+ * number.
+ *
+ * Each slot is guarded by a version number (a seqlock), the producer makes it
+ * odd while writing and even when done, a consumer reads the payload in place
+ * and checks the version again afterwards.
+ *
+ * You usually don't use this class directly but through ShmPublisher and
+ * ShmSubscriber.
+ */
+class WIZTK_EXPORT ShmRing {
+
+ public:
+
+  /**
+   * @brief Result of BeginRead()
+   */
+  enum ReadResult {
+    kReadEmpty,                         /**< The message is not published yet */
+    kReadReady,                         /**< The message can be read */
+    kReadOverrun                        /**< The message was overwritten */
+  };
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ShmRing);
+
+  ShmRing() = default;
+
+  /**
+   * @brief Destructor.
+   *
+   * Unmap the shared memory, and remove its name if this ring was created by
+   * Create().
+   */
+  ~ShmRing();
+
+  /**
+   * @brief Create a new ring as the producer.
+   * @param name A POSIX shared memory name, e.g. "/my_ring"
+   * @param capacity Number of slots, rounded up to a power of 2
+   * @param payload_size Size in bytes of each message
+   * @return True if success, false otherwise and errno is set, EEXIST if the
+   * name is already in use
+   *
+   * An existing ring is never replaced, remove the one left by a producer
+   * which crashed with Unlink().
+   */
+  bool Create(const char *name, size_t capacity, size_t payload_size);
+
+  /**
+   * @brief Remove the name of a ring, e.g. left by a producer which crashed.
+   * @param name A POSIX shared memory name
+   * @return True if success, false otherwise and errno is set
+   *
+   * The consumers which mapped the ring keep it until they close it. Never
+   * call this on the name of a running producer, it would remove the name of
+   * the next ring created with it when it closes.
+   */
+  static bool Unlink(const char *name);
+
+  /**
+   * @brief Map an existing ring as a consumer.
+   * @param name The name used in Create()
+   * @param payload_size Must be the same as the one used in Create()
+   * @return True if success, false otherwise and errno is set, EINVAL if the
+   * header does not describe a ring which fits in the shared memory
+   */
+  bool Open(const char *name, size_t payload_size);
+
+  /**
+   * @brief Unmap the shared memory.
+   */
+  void Close();
+
+  bool is_open() const { return nullptr != header_; }
+
+  /**
+   * @brief Start to write the next message.
+   * @return The memory to write the payload into
+   */
+  void *BeginWrite();
+
+  /**
+   * @brief Publish the message started by BeginWrite().
+   */
+  void EndWrite();
+
+  /**
+   * @brief Start to read the message with the given sequence number.
+   * @param sequence
+   * @param payload Output pointer to the payload in shared memory
+   * @return One of ReadResult
+   */
+  ReadResult BeginRead(uint64_t sequence, const void **payload) const;
+
+  /**
+   * @brief Check the message read since BeginRead() was not overwritten meanwhile.
+   * @param sequence
+   * @return True if the data copied out of the payload is valid
+   */
+  bool EndRead(uint64_t sequence) const;
+
+  /**
+   * @brief The sequence number of the last published message, 0 if none.
+   */
+  uint64_t sequence() const;
+
+  /**
+   * @brief The sequence number of the oldest message still in the ring.
+   */
+  uint64_t oldest_sequence() const;
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+
+  struct Header;
+
+  void *Map(int fd, size_t size);
+
+  unsigned char *SlotAt(uint64_t sequence) const;
+
+  Header *header_ = nullptr;
+  size_t mapped_size_ = 0;
+  size_t capacity_ = 0;
+  size_t stride_ = 0;
+  char *name_ = nullptr;  // only set in producer
+
+};
+
+/**
+ * @ingroup base
+ * @brief Publish the emission of a local signal into a ShmRing.
+ * @tparam ParamTypes Trivially copyable parameter types of the signal
+ *
+ * Connect any signal to Publish() and each emission is packed directly into
+ * the shared memory slot:
+ *
+ * @code
+ * sigcxx::Signal<int, double> changed;
+ * sigcxx::ShmPublisher<int, double> publisher;
+ *
+ * publisher.Create("/my_ring", 1024);
+ * changed.Connect(&publisher, &sigcxx::ShmPublisher<int, double>::Publish);
+ * @endcode
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT ShmPublisher : public Trackable {
+
+ public:
+
+  typedef internal::PackedArgs<ParamTypes...> PackedType;
+
+  ShmPublisher() = default;
+
+  ~ShmPublisher() override = default;
+
+  /**
+   * @brief Create the shared memory ring.
+   * @param name A POSIX shared memory name
+   * @param capacity Number of messages kept in the ring
+   * @return True if success, false with errno EEXIST if the name is in use
+   */
+  bool Create(const char *name, size_t capacity) {
+    return ring_.Create(name, capacity, PackedType::kSize);
+  }
+
+  /**
+   * @brief Slot method to publish a message.
+   */
+  void Publish(ParamTypes ... Args, __SLOT__) {
+    PackedType::Pack(ring_.BeginWrite(), Args...);
+    ring_.EndWrite();
+  }
+
+  /**
+   * @brief The sequence number of the last published message.
+   */
+  uint64_t sequence() const { return ring_.sequence(); }
+
+ private:
+
+  ShmRing ring_;
+
+};
+
+/**
+ * @ingroup base
+ * @brief Receive messages from a ShmRing and re-emit them into a local signal.
+ * @tparam ParamTypes Must be the same as the ShmPublisher
+ *
+ * A subscriber starts with the first message published after Open(). Call
+ * Pump() in the consumer process (e.g. in its event loop) to emit the pending
+ * messages through received().
+ */
+template<typename ... ParamTypes>
+class WIZTK_EXPORT ShmSubscriber {
+
+ public:
+
+  typedef internal::PackedArgs<ParamTypes...> PackedType;
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(ShmSubscriber);
+
+  ShmSubscriber() = default;
+
+  ~ShmSubscriber() = default;
+
+  /**
+   * @brief Map the ring created by a ShmPublisher.
+   * @param name The same name used in ShmPublisher::Create()
+   * @return True if success
+   */
+  bool Open(const char *name) {
+    if (!ring_.Open(name, PackedType::kSize)) return false;
+    next_ = ring_.sequence() + 1;
+    lost_ = 0;
+    return true;
+  }
+
+  /**
+   * @brief Emit at most max_count pending messages.
+   * @return Number of messages emitted
+   */
+  size_t Pump(size_t max_count = static_cast<size_t>(-1));
+
+  /**
+   * @brief The local signal emitted for each message.
+   */
+  SignalRef<ParamTypes...> received() { return received_; }
+
+  /**
+   * @brief Total number of messages overwritten before they were read.
+   */
+  uint64_t lost() const { return lost_; }
+
+  /**
+   * @brief The sequence number of the next message to read.
+   */
+  uint64_t next_sequence() const { return next_; }
+
+ private:
+
+  ShmRing ring_;
+  Signal<ParamTypes...> received_;
+  uint64_t next_ = 1;
+  uint64_t lost_ = 0;
+
+};
+
+template<typename ... ParamTypes>
+size_t ShmSubscriber<ParamTypes...>::Pump(size_t max_count) {
+  typename PackedType::TupleType args;
+  const void *payload = nullptr;
+  size_t count = 0;
+
+  while (count < max_count) {
+    ShmRing::ReadResult result = ring_.BeginRead(next_, &payload);
+
+    if (ShmRing::kReadEmpty == result) break;
+
+    if (ShmRing::kReadReady == result) {
+      PackedType::Unpack(payload, &args);
+      if (ring_.EndRead(next_)) {
+        ++next_;
+        ++count;
+        PackedType::Apply(received_, args);
+        continue;
+      }
+    }
+
+    // Overwritten by the producer, skip to the oldest message in ring:
+    uint64_t oldest = ring_.oldest_sequence();
+    if (oldest <= next_) oldest = next_ + 1;
+    lost_ += oldest - next_;
+    next_ = oldest;
+  }
+
+  return count;
+}
+
+} // namespace sigcxx
+
+#endif // WIZTK_BASE_SHM_CHANNEL_HPP_
@@ -24,8 +24,17 @@
 
 #include "sigcxx/delegate.hpp"
 #include "sigcxx/binode.hpp"
+#include "sigcxx/node_arena.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifndef __SLOT__
 /**
@@ -39,11 +48,24 @@ namespace sigcxx {
 
 // forward declaration
 class Trackable;
+class TrackableTeardownScope;
 class Slot;
 
 template<typename ... ParamTypes>
 class Signal;
 
+template<typename ... ParamTypes>
+class ConcurrentSignal;
+
+template<typename ... ParamTypes>
+class ShardedSignal;
+
+template<typename ... ParamTypes>
+class EmitCursor;
+
+template<typename SignalType>
+class EmbeddedConnection;
+
 namespace internal {
 
 // Foward declarations:
@@ -52,6 +74,14 @@ struct SignalTokenNode;
 template<typename ... ParamTypes>
 class SignalToken;
 
+template<typename ... ParamTypes>
+class QueuedToken;
+
+template<typename Predicate, typename ... ParamTypes>
+class SignalAwaiter;
+
+struct AcceptAll;
+
 /**
  * @ingroup base_intern
  * @brief A bidirectional node used to save the status of a Slot object.
@@ -68,22 +98,129 @@ class WIZTK_NO_EXPORT SlotNode : public Binode<SlotNode> {
 
 /**
  * @ingroup base_intern
- * @brief Base class of a bidirectional node used in Trackable or Signal only.
+ * @brief A bidirectional node linked in a Signal to wait for its next emission.
+ *
+ * Unlike a connection, a waiter node is not allocated by the signal, it's
+ * usually a member of an object waiting the signal (e.g. a coroutine awaiter)
+ * and unlinks itself when destroyed.
  */
-class WIZTK_NO_EXPORT InterRelatedNodeBase : public Binode<InterRelatedNodeBase> {
-  friend class Trackable;
-  template<typename ... ParamTypes> friend
-  class Signal;
+class WIZTK_NO_EXPORT WaiterNode : public Binode<WaiterNode> {
+ public:
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(WaiterNode);
+  WaiterNode() = default;
+  ~WaiterNode() override = default;
+
+  /**
+   * @brief Called when the signal is destroyed before the wait is done.
+   */
+  virtual void OnCancel() {}
+
+  /**
+   * @brief Called after the wait is done and the node is unlinked.
+   */
+  virtual void OnResume() {}
 };
 
 /**
  * @ingroup base_intern
- * @brief The end point used in Trackable or Signal for building a double-ended list.
+ * @brief A WaiterNode checking the arguments of each emission.
+ * @tparam ParamTypes
  */
-class WIZTK_NO_EXPORT InterRelatedNodeEndpoint : public InterRelatedNodeBase {
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT Waiter : public WaiterNode {
+ public:
+  Waiter() = default;
+  ~Waiter() override = default;
+
+  /**
+   * @brief Check the arguments of an emission.
+   * @return True to stop waiting, OnResume() will be called later in the same emission
+   */
+  virtual bool OnEmit(ParamTypes ... Args) = 0;
+};
+
+/**
+ * @ingroup base_intern
+ * @brief An atomic countdown shared by an asynchronous emission and its queued calls.
+ *
+ * The pending count starts at 1 for the emission itself, each queued call adds
+ * 1 and counts down after it has run (or is dropped). The reference count
+ * keeps the latch alive for the EmitFuture and the queued calls.
+ */
+class WIZTK_EXPORT EmitLatch {
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(EmitLatch);
+
+  EmitLatch() = default;
+
+  ~EmitLatch() = default;
+
+  void AddPending() {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void CountDown() {
+    // Sequentially consistent, pairs with the waiting flag set in Wait():
+    if (1 == pending_.fetch_sub(1)) {
+      if (waiting_.load()) WakeUp();
+    }
+  }
+
+  bool IsDone() const {
+    return 0 == pending_.load();
+  }
+
+  /**
+   * @brief Block until the pending count is 0.
+   * @param timeout_ms Timeout in milliseconds, negative to wait forever
+   * @return True if done, false on timeout
+   */
+  bool Wait(int timeout_ms);
+
+  void Retain() {
+    ref_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Release() {
+    if (1 == ref_count_.fetch_sub(1, std::memory_order_acq_rel)) delete this;
+  }
+
+ private:
+
+  void WakeUp();
+
+  std::atomic<long> pending_{1};
+  std::atomic<long> ref_count_{1};
+  std::atomic<bool> waiting_{false};
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Base class of a bidirectional node used in Trackable or Signal only.
+ */
+class WIZTK_NO_EXPORT InterRelatedNodeBase : public Binode<InterRelatedNodeBase> {
   friend class Trackable;
+  friend class sigcxx::TrackableTeardownScope;
   template<typename ... ParamTypes> friend
   class Signal;
+  friend struct TrackableBindingNode;
+
+ public:
+
+  InterRelatedNodeBase() = default;
+
+ private:
+
+  /**
+   * @brief Forget the neighbours without unlinking from them, used in a bulk teardown.
+   */
+  void Detach() {
+    previous_ = nullptr;
+    next_ = nullptr;
+  }
 };
 
 /**
@@ -92,7 +229,27 @@ class WIZTK_NO_EXPORT InterRelatedNodeEndpoint : public InterRelatedNodeBase {
  */
 struct WIZTK_NO_EXPORT TrackableBindingNode : public InterRelatedNodeBase {
   TrackableBindingNode() = default;
-  ~TrackableBindingNode() final;
+  ~TrackableBindingNode() override;  // not final, see EmbeddedConnection
+
+  // Allocated in the NodeArena (see "sigcxx/node_arena.hpp"), or in the block of a signal:
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, NodePool *pool);
+  static void operator delete(void *node);
+  static void operator delete(void *node, NodePool *pool);
+
+  /**
+   * @brief Move a binding to another address and fix up the pointers to it, used by NodeArena::Compact()
+   */
+  static void Relocate(void *from, void *to);
+
+  /**
+   * @brief The binding shared by the tokens without receiver, e.g. of a static function
+   *
+   * It's never linked or deleted, the tokens keep it so they are not taken
+   * for dead tokens.
+   */
+  static TrackableBindingNode *Unbound();
+
   Trackable *trackable = nullptr;
   SignalTokenNode *token = nullptr;
 };
@@ -105,6 +262,29 @@ struct WIZTK_NO_EXPORT SignalTokenNode : public InterRelatedNodeBase {
   friend class Slot;
   SignalTokenNode() = default;
   ~SignalTokenNode() override;
+
+  // Allocated in the NodeArena by size, sub classes included, or in the
+  // block of a signal if the size matches:
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, NodePool *pool);
+  static void operator delete(void *node, size_t size);
+  static void operator delete(void *node, NodePool *pool);
+
+  /**
+   * @brief Called when the binding is destroyed, e.g. in ~Trackable()
+   *
+   * The default deletes this token, override this to defer it.
+   */
+  virtual void Dispose() { delete this; }
+
+  /**
+   * @brief Move the slots emitting this token to the next one, or stop them if nullptr
+   *
+   * Both the slots marking this token and the emitting slots of the thread
+   * which are on it.
+   */
+  void MoveSlotMarks(SignalTokenNode *next_token);
+
   Trackable *trackable = nullptr;
   TrackableBindingNode *binding = nullptr;
   SlotNode slot_mark_head;
@@ -150,7 +330,7 @@ class WIZTK_NO_EXPORT DelegateToken : public CallableToken<ParamTypes...> {
   explicit DelegateToken(const DelegateType &d)
       : CallableToken<ParamTypes...>(), delegate_(d) {}
 
-  ~DelegateToken() final = default;
+  ~DelegateToken() override = default;  // not final, see EmbeddedConnection
 
   virtual void Invoke(ParamTypes... Args) final {
     delegate_(Args...);
@@ -168,237 +348,225 @@ class WIZTK_NO_EXPORT DelegateToken : public CallableToken<ParamTypes...> {
 
 /**
  * @ingroup base_intern
- * @brief A TokenNode points to a Signal.
- * @tparam ParamTypes
+ * @brief A token calling a slot method which doesn't take the SLOT parameter.
+ * @tparam ParamTypes The parameters of the signal
  */
 template<typename ... ParamTypes>
-class WIZTK_NO_EXPORT SignalToken : public CallableToken<ParamTypes...> {
+class WIZTK_NO_EXPORT SlotFreeDelegateToken : public CallableToken<ParamTypes..., Slot *> {
 
  public:
 
-  typedef Signal<ParamTypes...> SignalType;
+  typedef Delegate<void(ParamTypes...)> DelegateType;
 
-  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SignalToken);
-  SignalToken() = delete;
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SlotFreeDelegateToken);
+  SlotFreeDelegateToken() = delete;
 
-  explicit SignalToken(SignalType &signal)
-      : CallableToken<ParamTypes...>(), signal_(&signal) {}
+  explicit SlotFreeDelegateToken(const DelegateType &d)
+      : CallableToken<ParamTypes..., Slot *>(), delegate_(d) {}
 
-  ~SignalToken() final = default;
+  ~SlotFreeDelegateToken() final = default;
 
-  virtual void Invoke(ParamTypes... Args) final {
-    signal_->Emit(Args...);
+  void Invoke(ParamTypes... Args, Slot * /* slot */) final {
+    delegate_(Args...);
   }
 
-  const SignalType *signal() const {
-    return signal_;
+  inline const DelegateType &delegate() const {
+    return delegate_;
   }
 
  private:
 
-  SignalType *signal_;
+  DelegateType delegate_;
 
 };
 
 /**
  * @ingroup base_intern
- * @brief A simple double-ended queue to store bindings or tokens.
- * @tparam T Must be BindingNode or TokenNode
+ * @brief Returns a new id for a connection to a static function, never 0 and never reused.
  */
-template<typename T>
-class WIZTK_NO_EXPORT InterRelatedDeque {
-
- public:
+WIZTK_EXPORT uint64_t NewFunctionConnectionId();
 
-  /**
-   * @brief Declare this class is non-copyable and non-movable.
-   */
-  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(InterRelatedDeque);
-
-  /**
-   * @brief Iterator.
-   */
-  class Iterator {
-
-   public:
+/**
+ * @ingroup base_intern
+ * @brief A token calling a static function, with or without the SLOT parameter.
+ * @tparam ParamTypes The parameters of the signal
+ */
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT FunctionToken : public CallableToken<ParamTypes..., Slot *> {
 
-    Iterator() = delete;
+ public:
 
-    explicit Iterator(internal::InterRelatedNodeBase *node)
-        : current_(node) {}
+  typedef void (*FunctionType)(ParamTypes...);
+  typedef void (*SlotFunctionType)(ParamTypes..., Slot *);
 
-    ~Iterator() = default;
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(FunctionToken);
+  FunctionToken() = delete;
 
-    Iterator &operator++() {
-      current_ = current_->next();
-      return *this;
-    }
+  explicit FunctionToken(FunctionType function)
+      : CallableToken<ParamTypes..., Slot *>(), function_(function), id_(NewFunctionConnectionId()) {}
 
-    Iterator &operator--() {
-      current_ = current_->previous();
-      return *this;
-    }
+  explicit FunctionToken(SlotFunctionType function)
+      : CallableToken<ParamTypes..., Slot *>(), slot_function_(function), id_(NewFunctionConnectionId()) {}
 
-    bool operator==(const Iterator &other) const { return current_ == other.current_; }
-    bool operator!=(const Iterator &other) const { return current_ != other.current_; }
+  ~FunctionToken() final = default;
 
-    T *get() const {
-      return static_cast<T *>(current_);
-    }
-
-    T *operator->() const { return get(); }
-
-    explicit operator bool() const {
-      return nullptr == current_ ?
-             false : (nullptr == current_->previous() ?
-                      false : (nullptr != current_->next()));
+  void Invoke(ParamTypes... Args, Slot *slot) final {
+    if (nullptr != function_) {
+      function_(Args...);
+    } else {
+      slot_function_(Args..., slot);
     }
-
-   private:
-
-    internal::InterRelatedNodeBase *current_ = nullptr;
-
-  };
+  }
 
   /**
-   * @brief Const iterator.
+   * @brief The id of this connection, kept by the FunctionHandle
    */
-  class ConstIterator {
-
-   public:
-
-    ConstIterator() = delete;
-
-    explicit ConstIterator(const internal::InterRelatedNodeBase *node)
-        : current_(node) {}
-
-    ~ConstIterator() = default;
-
-    ConstIterator &operator++() {
-      current_ = current_->next();
-      return *this;
-    }
+  uint64_t id() const {
+    return id_;
+  }
 
-    ConstIterator &operator--() {
-      current_ = current_->previous();
-      return *this;
-    }
+ private:
 
-    bool operator==(const ConstIterator &other) const { return current_ == other.current_; }
-    bool operator!=(const ConstIterator &other) const { return current_ != other.current_; }
+  FunctionType function_ = nullptr;
+  SlotFunctionType slot_function_ = nullptr;
+  uint64_t id_;
 
-    const T *get() const {
-      return static_cast<const internal::TrackableBindingNode *>(current_);
-    }
-
-    const T *operator->() const { return get(); }
+};
 
-    explicit operator bool() const {
-      return nullptr == current_ ?
-             false : (nullptr == current_->previous() ?
-                      false : (nullptr != current_->next()));
-    }
+/**
+ * @ingroup base_intern
+ * @brief The token type of the connections to a slot method taking the given parameters.
+ */
+template<typename ... MethodParamTypes>
+struct MethodToken {
+  typedef typename std::conditional<
+      std::is_same<typename std::tuple_element<sizeof...(MethodParamTypes) - 1,
+                                               std::tuple<MethodParamTypes...> >::type, Slot *>::value,
+      DelegateToken<MethodParamTypes...>,
+      SlotFreeDelegateToken<MethodParamTypes...> >::type type;
+};
 
-   private:
+template<>
+struct MethodToken<> {
+  typedef SlotFreeDelegateToken<> type;
+};
 
-    const internal::InterRelatedNodeBase *current_ = nullptr;
+/**
+ * @ingroup base_intern
+ * @brief The first types of a std::tuple, in a std::tuple.
+ */
+template<typename Tuple, typename Indices>
+struct WIZTK_NO_EXPORT TupleHead;
 
-  };
+template<typename Tuple, size_t ... Indices>
+struct WIZTK_NO_EXPORT TupleHead<Tuple, std::index_sequence<Indices...> > {
+  typedef std::tuple<typename std::tuple_element<Indices, Tuple>::type...> type;
+};
 
-  /**
- * @brief Reverse iterator.
+/**
+ * @ingroup base_intern
+ * @brief A TokenNode with a delegate and the leading arguments bound to it.
+ * @tparam BoundTuple A std::tuple of the bound parameter types
+ * @tparam ParamTypes
+ *
+ * The bound values are stored in the token and passed before the arguments
+ * of each emission.
  */
-  class ReverseIterator {
+template<typename BoundTuple, typename ... ParamTypes>
+class WIZTK_NO_EXPORT BoundDelegateToken;
 
-   public:
+template<typename ... BoundTypes, typename ... ParamTypes>
+class WIZTK_NO_EXPORT BoundDelegateToken<std::tuple<BoundTypes...>, ParamTypes...>
+    : public CallableToken<ParamTypes...> {
 
-    ReverseIterator() = delete;
+ public:
 
-    explicit ReverseIterator(internal::InterRelatedNodeBase *node)
-        : current_(node) {}
+  typedef Delegate<void(BoundTypes..., ParamTypes...)> DelegateType;
 
-    ~ReverseIterator() = default;
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(BoundDelegateToken);
+  BoundDelegateToken() = delete;
 
-    ReverseIterator &operator++() {
-      current_ = current_->previous();
-      return *this;
-    }
+  template<typename ... ArgTypes>
+  explicit BoundDelegateToken(const DelegateType &d, ArgTypes &&... bound)
+      : CallableToken<ParamTypes...>(), delegate_(d), bound_(std::forward<ArgTypes>(bound)...) {}
 
-    ReverseIterator &operator--() {
-      current_ = current_->next();
-      return *this;
-    }
+  ~BoundDelegateToken() final = default;
 
-    bool operator==(const ReverseIterator &other) const { return current_ == other.current_; }
-    bool operator!=(const ReverseIterator &other) const { return current_ != other.current_; }
+  virtual void Invoke(ParamTypes... Args) final {
+    InvokeWithBound(std::index_sequence_for<BoundTypes...>(), Args...);
+  }
 
-    T *get() const {
-      return static_cast<T *>(current_);
-    }
+  inline const DelegateType &delegate() const {
+    return delegate_;
+  }
 
-    T *operator->() const { return get(); }
+ private:
 
-    explicit operator bool() const {
-      return nullptr == current_ ?
-             false : (nullptr == current_->previous() ?
-                      false : (nullptr != current_->next()));
-    }
+  template<size_t ... Indices>
+  inline void InvokeWithBound(std::index_sequence<Indices...>, ParamTypes... Args) {
+    delegate_(std::get<Indices>(bound_)..., Args...);
+  }
 
-   private:
+  DelegateType delegate_;
 
-    internal::InterRelatedNodeBase *current_ = nullptr;
+  std::tuple<typename std::decay<BoundTypes>::type...> bound_;
 
-  };
+};
 
-  /**
- * @brief Const reverse iterator.
+/**
+ * @ingroup base_intern
+ * @brief A TokenNode points to a Signal.
+ * @tparam ParamTypes
  */
-  class ConstReverseIterator {
+template<typename ... ParamTypes>
+class WIZTK_NO_EXPORT SignalToken : public CallableToken<ParamTypes..., Slot *> {
 
-   public:
+ public:
 
-    ConstReverseIterator() = delete;
+  typedef Signal<ParamTypes...> SignalType;
 
-    explicit ConstReverseIterator(const internal::InterRelatedNodeBase *node)
-        : current_(node) {}
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(SignalToken);
+  SignalToken() = delete;
 
-    ~ConstReverseIterator() = default;
+  explicit SignalToken(SignalType &signal)
+      : CallableToken<ParamTypes..., Slot *>(), signal_(&signal) {}
 
-    ConstReverseIterator &operator++() {
-      current_ = current_->previous();
-      return *this;
-    }
+  ~SignalToken() final = default;
 
-    ConstReverseIterator &operator--() {
-      current_ = current_->next();
-      return *this;
-    }
+  virtual void Invoke(ParamTypes... Args, Slot *slot) final;
 
-    bool operator==(const ConstReverseIterator &other) const { return current_ == other.current_; }
-    bool operator!=(const ConstReverseIterator &other) const { return current_ != other.current_; }
+  const SignalType *signal() const {
+    return signal_;
+  }
 
-    const T *get() const {
-      return static_cast<const internal::TrackableBindingNode *>(current_);
-    }
+ private:
 
-    const T *operator->() const { return get(); }
+  SignalType *signal_;
 
-    explicit operator bool() const {
-      return nullptr == current_ ?
-             false : (nullptr == current_->previous() ?
-                      false : (nullptr != current_->next()));
-    }
+};
 
-   private:
+/**
+ * @ingroup base_intern
+ * @brief A Deque to store bindings or tokens.
+ * @tparam T Must be BindingNode or TokenNode
+ */
+template<typename T>
+class WIZTK_NO_EXPORT InterRelatedDeque : public Deque<T> {
 
-    const internal::InterRelatedNodeBase *current_ = nullptr;
+ public:
 
-  };
+  /**
+   * @brief Declare this class is non-copyable and non-movable.
+   */
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(InterRelatedDeque);
 
   /**
    * @brief Default constructor.
+   *
+   * Constant for a deque with static storage duration, so an empty Trackable
+   * or Signal global is constant-initialized.
    */
-  InterRelatedDeque() { head_.push_back(&tail_); }
+  constexpr InterRelatedDeque() = default;
 
   /**
    * @brief Destructor.
@@ -412,7 +580,7 @@ class WIZTK_NO_EXPORT InterRelatedDeque {
   void push_back(T *node) {
     // link binding and token before calling this method:
     _ASSERT(nullptr != node->trackable);
-    tail_.push_front(node);
+    Deque<T>::push_back(node);
   }
 
   /**
@@ -422,7 +590,7 @@ class WIZTK_NO_EXPORT InterRelatedDeque {
   void push_front(T *node) {
     // link binding and token before calling this method:
     _ASSERT(nullptr != node->trackable);
-    head_.push_back(node);
+    Deque<T>::push_front(node);
   }
 
   /**
@@ -433,184 +601,379 @@ class WIZTK_NO_EXPORT InterRelatedDeque {
   void insert(T *node, int index = 0) {
     // link binding and token before calling this method:
     _ASSERT(nullptr != node->trackable);
-    if (index >= 0) {
-      Iterator it = begin();
-      while ((it != end()) && (index > 0)) {
-        ++it;
-        index--;
+    Deque<T>::insert(node, index);
+  }
+
+  /**
+   * @brief Forget all elements at once.
+   *
+   * The elements are not unlinked, the caller takes care of them (see
+   * TrackableTeardownScope).
+   */
+  using Deque<T>::reset;
+
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The interceptors of a Signal, stored contiguously and called in order.
+ */
+template<typename ... ParamTypes>
+struct WIZTK_NO_EXPORT InterceptorChain {
+
+  typedef Delegate<bool(ParamTypes &...)> DelegateType;
+
+  /**
+   * @brief Returns false if an interceptor cancels the emission
+   *
+   * Indexed, an interceptor may add another one to the same signal. The ones
+   * removed meanwhile are only cleared, and erased when the outermost run
+   * returns.
+   */
+  bool Run(ParamTypes &... Args) {
+    RunGuard guard(this);
+
+    for (size_t i = 0; i < interceptors.size(); i++) {
+      if (interceptors[i] && !interceptors[i](Args...)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Remove the first interceptor equal to the given one
+   */
+  bool Remove(const DelegateType &interceptor) {
+    for (auto it = interceptors.begin(); it != interceptors.end(); ++it) {
+      if (*it == interceptor) {
+        if (0 == running) {
+          interceptors.erase(it);
+        } else {
+          it->Reset();
+          ++cleared;
+        }
+        return true;
       }
-      it->push_front(node);
-    } else {
-      ReverseIterator it = rbegin();
-      while ((it != rend()) && (index < -1)) {
-        ++it;
-        index++;
+    }
+    return false;
+  }
+
+  size_t size() const {
+    return interceptors.size() - cleared;
+  }
+
+  std::vector<DelegateType> interceptors;
+
+  int running = 0;  // nesting of Run()
+
+  size_t cleared = 0;  // removed while running
+
+ private:
+
+  /**
+   * @brief Counts a run, the outermost one erases the cleared interceptors when it returns or throws
+   */
+  class RunGuard {
+
+   public:
+
+    WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(RunGuard);
+
+    explicit RunGuard(InterceptorChain *chain)
+        : chain_(chain) {
+      ++chain_->running;
+    }
+
+    ~RunGuard() {
+      if ((0 == --chain_->running) && (0 < chain_->cleared)) {
+        chain_->interceptors.erase(std::remove_if(chain_->interceptors.begin(), chain_->interceptors.end(),
+                                                  [](const DelegateType &d) { return !d; }),
+                                   chain_->interceptors.end());
+        chain_->cleared = 0;
       }
-      it->push_back(node);
     }
+
+   private:
+
+    InterceptorChain *chain_;
+
+  };
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief Iterator and signature to a slot method
+ *
+ * A Slot object is created and destroyed when a signal is being emitted.
+ *
+ * It has two main purposes:
+ *   - Works as an iterator
+ *   - The last parameter in a slot method
+ *
+ * A Signal holds a list of token to support multicast, when it's being
+ * emitted, it create a simple Slot object and use it as an iterater and call
+ * each delegate (@ref Delegate) to the slot method or another signal.
+ */
+class WIZTK_EXPORT Slot {
+
+  friend struct internal::SignalTokenNode;
+  friend class Trackable;
+
+  template<typename ... ParamTypes> friend
+  class Signal;
+
+  template<typename ... ParamTypes> friend
+  class internal::SignalToken;
+
+  template<typename ... ParamTypes> friend
+  class internal::QueuedToken;
+
+  template<typename ... ParamTypes> friend
+  class EmitCursor;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Slot);
+  Slot() = delete;
+
+  class Mark : public internal::SlotNode {
+
+   public:
+
+    Mark() = delete;
+
+    explicit Mark(Slot *slot)
+        : slot_(slot) {}
+
+    ~Mark() final = default;
+
+    Slot *slot() const { return slot_; }
+
+   private:
+
+    Slot *slot_ = nullptr;
+
+  };
+
+ public:
+
+  /**
+   * @brief Get the Signal object which is just calling this slot
+   */
+  template<typename ... ParamTypes>
+  Signal<ParamTypes...> *signal() const {
+    return dynamic_cast<Signal<ParamTypes...> *>(it_->trackable);
   }
 
   /**
-   * @brief Return iterator to beginning.
-   * @return
+   * @brief The trackable object in which the slot method is being called
+   * @return The trackable object receiving signal
    */
-  Iterator begin() const { return Iterator(head_.next()); }
+  Trackable *binding_trackable() const {
+    return nullptr == it_->binding ? nullptr : it_->binding->trackable;
+  }
 
   /**
-   * @brief Return const iterator to beginning.
-   * @return
+   * @brief Skip the slots after this one in the current emission
+   *
+   * If the signal is connected to another signal (through Connect(Signal&)),
+   * the emission of that signal is stopped too, and so on up the chain.
+   * The slot parameter is nullptr when a slot method is called directly or
+   * by a ConcurrentSignal, check it before calling this.
    */
-  ConstIterator cbegin() const { return ConstIterator(head_.next()); }
+  void StopPropagation() { stopped_ = true; }
+
+  bool IsPropagationStopped() const { return stopped_; }
+
+ private:
+
+  typedef internal::InterRelatedDeque<internal::SignalTokenNode> DequeType;
+  typedef internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator IteratorType;
 
   /**
-   * @brief Return iterator to end.
-   * @return
+   * @brief Tag of the slots linked in the emitting slots of the thread
+   */
+  struct Emitting {};
+
+  /**
+   * @brief A slot which keeps a mark on the token it's on, e.g. in an EmitCursor
    */
-  Iterator end() const {
-    const internal::InterRelatedNodeBase *p = &tail_;
-    return Iterator(const_cast<internal::InterRelatedNodeBase *>(p));
+  Slot(DequeType *deque, internal::EmitLatch *latch)
+      : deque_(deque), it_(deque->begin()), mark_(this), latch_(latch) {}
+
+  /**
+   * @brief A slot on the stack of Signal::Emit(), found through innermost() instead of a mark
+   *
+   * A token deleted under it moves it to the next token like a mark, but
+   * emitting doesn't link and unlink a mark for each slot it calls.
+   */
+  Slot(DequeType *deque, internal::EmitLatch *latch, Emitting)
+      : deque_(deque), it_(deque->begin()), mark_(this), latch_(latch), outer_(innermost()), emitting_(true) {
+    innermost() = this;
+  }
+
+  ~Slot() {
+    if (emitting_) {
+      _ASSERT(innermost() == this);
+      innermost() = outer_;
+    }
   }
 
   /**
-   * @brief Return const iterator to end.
-   * @return
+   * @brief The innermost emitting slot of this thread, linked to the outer ones
+   */
+  static Slot *&innermost() {
+    static thread_local Slot *slot = nullptr;
+    return slot;
+  }
+
+  Slot &operator++() {
+    if (ref_count_ > 0) {
+      --ref_count_;
+    } else {
+      ++it_;
+    }
+    return *this;
+  }
+
+  Slot &operator--() {
+    if (ref_count_ > 0) {
+      --ref_count_;
+    } else {
+      --it_;
+    }
+    return *this;
+  }
+
+  DequeType *deque_ = nullptr;
+  IteratorType it_;
+  size_t ref_count_ = 0;
+  Mark mark_;
+  internal::EmitLatch *latch_ = nullptr;  // only in Signal::EmitAsync()
+  Slot *outer_ = nullptr;
+  bool emitting_ = false;
+  bool stopped_ = false;
+
+};
+
+/**
+ * @ingroup base
+ * @brief Memory used by a Signal, see Signal::MemoryUsage().
+ */
+struct WIZTK_EXPORT SignalMemoryUsage {
+
+  size_t connection_count = 0;
+
+  /**
+   * @brief Number of method connections which can still be made without allocation
    */
-  ConstIterator cend() const { return ConstIterator(&tail_); }
+  size_t reserved_count = 0;
 
   /**
-   * @brief Return reverse iterator to reverse beginning
-   * @return
+   * @brief Bytes of the signal, its connections, its interceptors and its reserved pages
    */
-  ReverseIterator rbegin() const { return ReverseIterator(tail_.previous()); }
+  size_t bytes = 0;
+
+};
+
+/**
+ * @ingroup base
+ * @brief A lightweight future returned by Signal::EmitAsync().
+ *
+ * It's ready when every receiver of the emission has been called, including
+ * the ones queued in an EventQueue (see "sigcxx/event_queue.hpp").
+ */
+class WIZTK_EXPORT EmitFuture {
+
+  template<typename ... ParamTypes> friend
+  class Signal;
+
+ public:
 
   /**
-   * @brief Return const reverse iterator to reverse beginning.
-   * @return
+   * @brief Create an empty future which is always ready.
    */
-  ConstReverseIterator crbegin() const { return ConstReverseIterator(tail_.previous()); }
+  EmitFuture() = default;
+
+  EmitFuture(const EmitFuture &) = delete;
+  EmitFuture &operator=(const EmitFuture &) = delete;
+
+  EmitFuture(EmitFuture &&other) noexcept
+      : latch_(other.latch_) {
+    other.latch_ = nullptr;
+  }
+
+  EmitFuture &operator=(EmitFuture &&other) noexcept {
+    std::swap(latch_, other.latch_);
+    return *this;
+  }
+
+  ~EmitFuture() {
+    if (nullptr != latch_) latch_->Release();
+  }
+
+  bool IsReady() const {
+    return nullptr == latch_ || latch_->IsDone();
+  }
 
   /**
-   * @brief Return reverse iterator to reverse end.
-   * @return
+   * @brief Block until all receivers have been called.
    */
-  ReverseIterator rend() const {
-    const internal::InterRelatedNodeBase *p = &head_;
-    return ReverseIterator(const_cast<internal::InterRelatedNodeBase *>(p));
+  void Wait() const {
+    if (nullptr != latch_) latch_->Wait(-1);
   }
 
   /**
-   * @brief Return const reverse iterator to reverse end.
-   * @return
+   * @brief Block until all receivers have been called or timeout.
+   * @return True if ready
    */
-  ConstReverseIterator crend() const { return ConstReverseIterator(&head_); }
+  bool WaitFor(int timeout_ms) const {
+    return nullptr == latch_ || latch_->Wait(timeout_ms);
+  }
 
  private:
 
-  typedef InterRelatedNodeEndpoint EndpointType;
+  explicit EmitFuture(internal::EmitLatch *latch)
+      : latch_(latch) {}
 
-  EndpointType head_;
-  EndpointType tail_;
+  internal::EmitLatch *latch_ = nullptr;
 
 };
 
-} // namespace internal
-
 /**
  * @ingroup base
- * @brief Iterator and signature to a slot method
+ * @brief A handle to a connection of a Signal to a static function, see Signal::Connect().
  *
- * A Slot object is created and destroyed when a signal is being emitted.
- *
- * It has two main purposes:
- *   - Works as an iterator
- *   - The last parameter in a slot method
- *
- * A Signal holds a list of token to support multicast, when it's being
- * emitted, it create a simple Slot object and use it as an iterater and call
- * each delegate (@ref Delegate) to the slot method or another signal.
+ * It's a plain value which doesn't keep the connection alive: once the
+ * connection is broken, the signal doesn't find it any more. Each connection
+ * has its own id, so a new one reusing the memory of the old token doesn't
+ * match it either.
  */
-class WIZTK_EXPORT Slot {
-
-  friend struct internal::SignalTokenNode;
-  friend class Trackable;
+class WIZTK_EXPORT FunctionHandle {
 
   template<typename ... ParamTypes> friend
   class Signal;
 
- public:
-
-  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Slot);
-  Slot() = delete;
-
-  class Mark : public internal::SlotNode {
-
-   public:
-
-    Mark() = delete;
-
-    explicit Mark(Slot *slot)
-        : slot_(slot) {}
-
-    ~Mark() final = default;
-
-    Slot *slot() const { return slot_; }
-
-   private:
-
-    Slot *slot_ = nullptr;
-
-  };
-
  public:
 
   /**
-   * @brief Get the Signal object which is just calling this slot
+   * @brief Create an empty handle which matches no connection.
    */
-  template<typename ... ParamTypes>
-  Signal<ParamTypes...> *signal() const {
-    return dynamic_cast<Signal<ParamTypes...> *>(it_->trackable);
-  }
+  FunctionHandle() = default;
 
-  /**
-   * @brief The trackable object in which the slot method is being called
-   * @return The trackable object receiving signal
-   */
-  Trackable *binding_trackable() const {
-    return it_->binding->trackable;
+  explicit operator bool() const {
+    return nullptr != token_;
   }
 
  private:
 
-  typedef internal::InterRelatedDeque<internal::SignalTokenNode> DequeType;
-  typedef internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator IteratorType;
-
-  explicit Slot(DequeType *deque)
-      : deque_(deque), it_(deque->begin()), mark_(this) {}
-
-  ~Slot() = default;
-
-  Slot &operator++() {
-    if (ref_count_ > 0) {
-      --ref_count_;
-    } else {
-      ++it_;
-    }
-    return *this;
-  }
-
-  Slot &operator--() {
-    if (ref_count_ > 0) {
-      --ref_count_;
-    } else {
-      --it_;
-    }
-    return *this;
-  }
+  FunctionHandle(const internal::SignalTokenNode *token, uint64_t id)
+      : token_(token), id_(id) {}
 
-  DequeType *deque_ = nullptr;
-  IteratorType it_;
-  size_t ref_count_ = 0;
-  Mark mark_;
+  const internal::SignalTokenNode *token_ = nullptr;
+  uint64_t id_ = 0;
 
 };
 
@@ -623,12 +986,24 @@ typedef Slot *SLOT;
 /**
  * @ingroup base
  * @brief The basic class for an object which can provide slot methods
+ *
+ * An object only used in one thread can declare it with SetThreadAffinity(),
+ * debug builds then assert that signals connect, emit and disconnect it only
+ * in this thread. Nothing is stored or checked in a release build.
  */
 class WIZTK_EXPORT Trackable {
 
   template<typename ... ParamTypes> friend
   class Signal;
 
+  template<typename ... ParamTypes> friend
+  class ConcurrentSignal;
+
+  template<typename ... ParamTypes> friend
+  class ShardedSignal;
+
+  friend class TrackableTeardownScope;
+
  public:
 
   /**
@@ -658,7 +1033,7 @@ class WIZTK_EXPORT Trackable {
   }
 
   /**
-   * @brief Count connections to the given slot method
+   * @brief Count connections to the given slot method, with or without the SLOT parameter
    */
   template<typename T, typename ... ParamTypes>
   size_t CountSignalBindings(void (T::*method)(ParamTypes...)) const;
@@ -668,6 +1043,42 @@ class WIZTK_EXPORT Trackable {
    */
   size_t CountSignalBindings() const;
 
+  /**
+   * @brief Confine this object to the current thread
+   */
+  void SetThreadAffinity() {
+    MoveToThread(std::this_thread::get_id());
+  }
+
+  /**
+   * @brief Hand this object over to another thread
+   *
+   * Must be called in the owner thread, e.g. just before passing the object
+   * to a worker.
+   */
+  void MoveToThread(std::thread::id owner) {
+    _ASSERT(IsOnOwnerThread());
+    owner_ = std::thread::id() == owner ? 0 : HashThreadId(owner);
+  }
+
+  /**
+   * @brief Let this object be used in any thread again
+   */
+  void ClearThreadAffinity() {
+    MoveToThread(std::thread::id());
+  }
+
+  /**
+   * @brief Returns false if this object is confined to another thread, always true in a release build
+   */
+  bool IsOnOwnerThread() const {
+#ifdef __DEBUG__
+    return (0 == owner_) || (HashThreadId(std::this_thread::get_id()) == owner_);
+#else
+    return true;
+#endif
+  }
+
  protected:
 
   /**
@@ -683,7 +1094,7 @@ class WIZTK_EXPORT Trackable {
   void UnbindAllSignals();
 
   /**
-    * @brief Break all connections to the given slot method of this object
+    * @brief Break all connections to the given slot method of this object, with or without the SLOT parameter
     */
   template<typename T, typename ... ParamTypes>
   void UnbindAllSignalsTo(void (T::*method)(ParamTypes...));
@@ -720,19 +1131,100 @@ class WIZTK_EXPORT Trackable {
 
   internal::InterRelatedDeque<internal::TrackableBindingNode> bindings_;
 
+  static size_t HashThreadId(std::thread::id id) {
+    return std::hash<std::thread::id>()(id) | 1;
+  }
+
+  // The hash of the owner thread id, 0 if not confined. std::thread::id has
+  // no constexpr constructor, which would make every global dynamically
+  // initialized. Kept in all builds so the layout does not depend on
+  // __DEBUG__, only the checks are compiled out.
+  size_t owner_ = 0;
+
+};
+
+/**
+ * @ingroup base
+ * @brief Batch the destruction of many Trackable objects.
+ *
+ * While a scope is alive in the current thread, ~Trackable() doesn't unlink
+ * its connections one by one: it frees its bindings without unlinking them
+ * from each other, and leaves its tokens in the signals as dead tokens.
+ * Emitting skips dead tokens and no query of a Signal sees them. When the
+ * outermost scope ends, all dead tokens are released in the order their
+ * receivers were destroyed, which is close to the allocation order.
+ *
+ * @code
+ * {
+ *   sigcxx::TrackableTeardownScope scope;
+ *   document.reset();  // destroys a lot of views and models
+ * }
+ * @endcode
+ *
+ * Scopes can be nested, only the outermost one releases the tokens. The
+ * connections of a ConcurrentSignal or a ShardedSignal are still broken
+ * immediately.
+ */
+class WIZTK_EXPORT TrackableTeardownScope {
+
+  template<typename ... ParamTypes> friend
+  class Signal;
+
+  friend class Trackable;
+
+ public:
+
+  WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(TrackableTeardownScope);
+
+  TrackableTeardownScope();
+
+  ~TrackableTeardownScope();
+
+  /**
+   * @brief Number of dead tokens waiting to be released.
+   */
+  size_t pending_count() const {
+    return nullptr == outer_ ? pending_count_ : outer_->pending_count();
+  }
+
+  /**
+   * @brief Returns the outermost scope of the current thread, or nullptr
+   */
+  static TrackableTeardownScope *current();
+
+ private:
+
+  /**
+   * @brief Called in ~Trackable() instead of UnbindAllSignals().
+   */
+  void Defer(Trackable *trackable);
+
+  /**
+   * @brief Called in ~Signal(), unlink the dead tokens which are freed by the scope.
+   */
+  static void DetachDeadTokens(internal::InterRelatedDeque<internal::SignalTokenNode> *tokens);
+
+  TrackableTeardownScope *outer_ = nullptr;
+
+  // The bindings of the dead tokens, linked to each other:
+  internal::TrackableBindingNode *first_ = nullptr;
+  internal::TrackableBindingNode *last_ = nullptr;
+
+  size_t pending_count_ = 0;
+
 };
 
 template<typename T, typename ... ParamTypes>
 void Trackable::UnbindAllSignalsTo(void (T::*method)(ParamTypes...)) {
   internal::TrackableBindingNode *tmp = nullptr;
-  internal::DelegateToken<ParamTypes...> *delegate_token = nullptr;
+  typename internal::MethodToken<ParamTypes...>::type *delegate_token = nullptr;
 
   auto it = bindings_.rbegin();
   while (it != bindings_.rend()) {
     tmp = it.get();
     ++it;
 
-    delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes...> * > (tmp->token);
+    delegate_token = dynamic_cast<typename internal::MethodToken<ParamTypes...>::type *> (tmp->token);
     if (delegate_token && (delegate_token->delegate().template Equal<T>((T *) this, method))) {
       delete tmp;
     }
@@ -742,11 +1234,11 @@ void Trackable::UnbindAllSignalsTo(void (T::*method)(ParamTypes...)) {
 template<typename T, typename ... ParamTypes>
 size_t Trackable::CountSignalBindings(void (T::*method)(ParamTypes...)) const {
   size_t count = 0;
-  internal::DelegateToken<ParamTypes...> *delegate_token = nullptr;
+  typename internal::MethodToken<ParamTypes...>::type *delegate_token = nullptr;
 
   for (auto it = bindings_.cbegin(); it != bindings_.cend(); ++it) {
     delegate_token =
-        dynamic_cast<internal::DelegateToken<ParamTypes...> * > (it.get()->token);
+        dynamic_cast<typename internal::MethodToken<ParamTypes...>::type *> (it.get()->token);
     if (delegate_token && (delegate_token->delegate().template Equal<T>((T *) this, method))) {
       count++;
     }
@@ -763,6 +1255,18 @@ class WIZTK_EXPORT Signal : public Trackable {
 
   friend class Trackable;
 
+  template<typename ... SignalParamTypes> friend
+  class internal::SignalToken;
+
+  template<typename Predicate, typename ... AwaiterParamTypes> friend
+  class internal::SignalAwaiter;
+
+  template<typename ... CursorParamTypes> friend
+  class EmitCursor;
+
+  template<typename SignalType> friend
+  class EmbeddedConnection;
+
  public:
 
   WIZTK_DECLARE_NONCOPYABLE_AND_NONMOVALE(Signal);
@@ -770,7 +1274,11 @@ class WIZTK_EXPORT Signal : public Trackable {
   Signal() = default;
 
   ~Signal() final {
+    TrackableTeardownScope::DetachDeadTokens(&tokens_);
     DisconnectAll();
+    CancelWaiters();
+    delete interceptors_;
+    delete block_;  // its pools are freed with their last node
   }
 
   /**
@@ -779,14 +1287,105 @@ class WIZTK_EXPORT Signal : public Trackable {
   template<typename T>
   void Connect(T *obj, void (T::*method)(ParamTypes..., SLOT), int index = -1);
 
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes..., SLOT) const, int index = -1) {
+    ConnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, index);
+  }
+
+  /**
+   * @brief Connect this signal to a slot method without the SLOT parameter
+   *
+   * The method can't stop the propagation or unbind itself through the slot,
+   * deleting its object or disconnecting it in the call is still safe.
+   */
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes...), int index = -1) {
+    ConnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, index);
+  }
+
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes...) const, int index = -1) {
+    ConnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, index);
+  }
+
+  /**
+   * @brief Connect this signal to a slot method with leading arguments bound
+   *
+   * The bound values are stored in the connection, no other allocation, and
+   * passed before the signal arguments, e.g. to know which row emitted:
+   * @code
+   * // void Table::OnCellChanged(int row, const std::string &text, SLOT)
+   * rows[i]->cell_changed().Connect(&table, &Table::OnCellChanged, i);
+   * @endcode
+   *
+   * The connection is always appended. It's broken like others when the
+   * receiver is destroyed, or by Disconnect(start_pos, counts) and
+   * DisconnectAll().
+   */
+  template<typename T, typename ... MethodParamTypes, typename BoundType, typename ... BoundTypes>
+  typename std::enable_if<sizeof...(MethodParamTypes) == sizeof...(BoundTypes) + sizeof...(ParamTypes) + 2>::type
+  Connect(T *obj, void (T::*method)(MethodParamTypes...), BoundType &&bound, BoundTypes &&... more);
+
   void Connect(Signal<ParamTypes...> &other, int index = -1);
 
+  /**
+   * @brief Connect this signal to a static function or a lambda without capture
+   * @return A handle to break this connection with Disconnect()
+   *
+   * The connection is a single token without binding, as there's no receiver
+   * to track. It's broken by Disconnect(handle), by the methods breaking any
+   * kind of connections, or when this signal is destroyed. The function may
+   * take the SLOT parameter or not.
+   *
+   * @code
+   * sigcxx::FunctionHandle handle = signal.Connect([](int value) { Log(value); });
+   * // ...
+   * signal.Disconnect(handle);
+   * @endcode
+   */
+  template<typename F>
+  typename std::enable_if<std::is_convertible<F, void (*)(ParamTypes...)>::value, FunctionHandle>::type
+  Connect(F function, int index = -1) {
+    return ConnectFunction(static_cast<void (*)(ParamTypes...)>(function), index);
+  }
+
+  template<typename F>
+  typename std::enable_if<std::is_convertible<F, void (*)(ParamTypes..., SLOT)>::value, FunctionHandle>::type
+  Connect(F function, int index = -1) {
+    return ConnectFunction(static_cast<void (*)(ParamTypes..., SLOT)>(function), index);
+  }
+
+  /**
+   * @brief Connect a custom token to a receiver
+   * @param token A new token, it's deleted when disconnected
+   * @param receiver The trackable object this connection is bound to
+   * @param index
+   *
+   * This is used to add other kinds of connections, e.g. EventQueue::Connect().
+   */
+  void Connect(internal::CallableToken<ParamTypes..., SLOT> *token, Trackable *receiver, int index = -1);
+
   /**
    * @brief Disconnect all delegates to a method
    */
   template<typename T>
   void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT));
 
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT) const) {
+    DisconnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, -1, -1);
+  }
+
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes...)) {
+    DisconnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, -1, -1);
+  }
+
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes...) const) {
+    DisconnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, -1, -1);
+  }
+
   /**
    * @brief Disconnect all signals
    */
@@ -806,6 +1405,21 @@ class WIZTK_EXPORT Signal : public Trackable {
   template<typename T>
   int Disconnect(T *obj, void (T::*method)(ParamTypes..., SLOT), int start_pos = -1, int counts = 1);
 
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes..., SLOT) const, int start_pos = -1, int counts = 1) {
+    return DisconnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, start_pos, counts);
+  }
+
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes...), int start_pos = -1, int counts = 1) {
+    return DisconnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, start_pos, counts);
+  }
+
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes...) const, int start_pos = -1, int counts = 1) {
+    return DisconnectMethod<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, start_pos, counts);
+  }
+
   /**
    * @brief Disconnect connections to a signal by given start position and counts
    * @param other
@@ -817,6 +1431,12 @@ class WIZTK_EXPORT Signal : public Trackable {
    */
   int Disconnect(Signal<ParamTypes...> &other, int start_pos = -1, int counts = 1);
 
+  /**
+   * @brief Break a connection to a static function
+   * @return false if it's already broken
+   */
+  bool Disconnect(const FunctionHandle &handle);
+
   /**
    * @brief Disconnect any kind of connections from the start position
    * @param start_pos
@@ -834,45 +1454,279 @@ class WIZTK_EXPORT Signal : public Trackable {
   template<typename T>
   bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT)) const;
 
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT) const) const {
+    return CountMethodConnections<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, 1) > 0;
+  }
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes...)) const {
+    return CountMethodConnections<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, 1) > 0;
+  }
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes...) const) const {
+    return CountMethodConnections<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, 1) > 0;
+  }
+
   bool IsConnectedTo(const Signal<ParamTypes...> &other) const;
 
   bool IsConnectedTo(const Trackable *obj) const;
 
+  bool IsConnectedTo(const FunctionHandle &handle) const {
+    return nullptr != FindFunctionToken(handle);
+  }
+
   template<typename T>
   int CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT)) const;
 
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT) const) const {
+    return CountMethodConnections<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, -1);
+  }
+
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes...)) const {
+    return CountMethodConnections<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, -1);
+  }
+
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes...) const) const {
+    return CountMethodConnections<internal::SlotFreeDelegateToken<ParamTypes...> >(obj, method, -1);
+  }
+
   int CountConnections(const Signal<ParamTypes...> &other) const;
 
   int CountConnections() const;
 
-  void Emit(ParamTypes ... Args);
+  /**
+   * @brief An interceptor of the emissions, returns false to cancel one
+   *
+   * The arguments are passed by reference: the ones the signal takes by
+   * value can be rewritten before the slots get them.
+   */
+  typedef Delegate<bool(ParamTypes &...)> InterceptorType;
+
+  /**
+   * @brief Append an interceptor, called before the waiters and the slots of each emission
+   *
+   * The interceptors are called in order, in one pass over a contiguous
+   * array, until one returns false: the emission is then cancelled and no
+   * slot is called. A signal without interceptor only tests a null pointer.
+   *
+   * An interceptor is not a connection, the object it calls must outlive it
+   * or remove it.
+   *
+   * @code
+   * // bool Guard::CheckPermission(int &user_id)
+   * signal.AddInterceptor(&guard, &Guard::CheckPermission);
+   * @endcode
+   */
+  void AddInterceptor(const InterceptorType &interceptor);
+
+  template<typename T>
+  void AddInterceptor(T *obj, bool (T::*method)(ParamTypes &...)) {
+    AddInterceptor(InterceptorType::FromMethod(obj, method));
+  }
+
+  void AddInterceptor(bool (*function)(ParamTypes &...)) {
+    AddInterceptor(InterceptorType::FromStatic(function));
+  }
+
+  /**
+   * @brief Remove the first interceptor equal to the given one
+   * @return false if not found
+   */
+  bool RemoveInterceptor(const InterceptorType &interceptor);
+
+  template<typename T>
+  bool RemoveInterceptor(T *obj, bool (T::*method)(ParamTypes &...)) {
+    return RemoveInterceptor(InterceptorType::FromMethod(obj, method));
+  }
+
+  bool RemoveInterceptor(bool (*function)(ParamTypes &...)) {
+    return RemoveInterceptor(InterceptorType::FromStatic(function));
+  }
+
+  size_t CountInterceptors() const {
+    return nullptr == interceptors_ ? 0 : interceptors_->size();
+  }
+
+  /**
+   * @brief Reserve the nodes of count more connections in a block of this signal
+   *
+   * The next count connections to slot methods or signals take their nodes
+   * from the block and don't allocate. The block is mapped in 64 KB pages,
+   * and grows by pages once the reserved nodes are used. Connections with
+   * bound arguments or custom tokens still use the node arena.
+   */
+  void Reserve(size_t count);
+
+  /**
+   * @brief Return the unused pages of the reserved block, and the block itself once empty
+   */
+  void ShrinkToFit();
+
+  /**
+   * @brief Count the connections, the reserved capacity and the bytes used by this signal
+   *
+   * Nodes outside the reserved block are counted at the size of a
+   * connection to a slot method.
+   */
+  SignalMemoryUsage MemoryUsage() const;
+
+  void Emit(ParamTypes ... Args) {
+    EmitWithLatch(nullptr, Args...);
+  }
 
   void operator()(ParamTypes ... Args) {
     Emit(Args...);
   }
 
+  /**
+   * @brief Emit and get a future ready when all receivers have been called
+   *
+   * Direct receivers are called before this method returns, queued ones
+   * later in the threads processing their EventQueue. Signals chained to
+   * this one are tracked as well.
+   */
+  EmitFuture EmitAsync(ParamTypes ... Args);
+
+  /**
+   * @brief Wait for the next emission in a C++20 coroutine
+   *
+   * Include "sigcxx/coroutine.hpp" to use this method:
+   *
+   * @code
+   * auto args = co_await signal.Next();  // std::optional<std::tuple<...>>
+   * @endcode
+   */
+  template<typename Awaiter = internal::SignalAwaiter<internal::AcceptAll, ParamTypes...> >
+  Awaiter Next() {
+    return Awaiter(this, internal::AcceptAll());
+  }
+
+  /**
+   * @brief Wait for the next emission matching the given predicate in a C++20 coroutine
+   *
+   * Include "sigcxx/coroutine.hpp" to use this method.
+   */
+  template<typename Predicate>
+  internal::SignalAwaiter<Predicate, ParamTypes...> When(Predicate pred) {
+    return internal::SignalAwaiter<Predicate, ParamTypes...>(this, std::move(pred));
+  }
+
  private:
 
-  static inline void PushFrontToken(Signal *signal, internal::SignalTokenNode *token) {
+  static inline void PushFrontToken(Signal *signal, internal::CallableToken<ParamTypes..., SLOT> *token) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
     signal->tokens_.push_front(token);
   }
 
-  static inline void PushBackToken(Signal *signal, internal::SignalTokenNode *token) {
+  static inline void PushBackToken(Signal *signal, internal::CallableToken<ParamTypes..., SLOT> *token) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
     signal->tokens_.push_back(token);
   }
 
-  static inline void InsertToken(Signal *signal, internal::SignalTokenNode *token, int index = 0) {
+  static inline void InsertToken(Signal *signal, internal::CallableToken<ParamTypes..., SLOT> *token, int index = 0) {
     _ASSERT(nullptr == token->trackable);
     token->trackable = signal;
-    signal->tokens_.insert(token, index);
+    signal->tokens_.insert(token, signal->TokenPosition(index));
+  }
+
+  /**
+   * @brief The position in tokens_ of a position counted without the dead tokens of a TrackableTeardownScope
+   */
+  int TokenPosition(int index) const;
+
+  template<typename FunctionType>
+  FunctionHandle ConnectFunction(FunctionType function, int index) {
+    _ASSERT(IsOnOwnerThread());
+
+    auto *token = new(token_pool()) internal::FunctionToken<ParamTypes...>(function);
+    token->binding = internal::TrackableBindingNode::Unbound();
+    InsertToken(this, token, index);
+    return FunctionHandle(token, token->id());
+  }
+
+  internal::FunctionToken<ParamTypes...> *FindFunctionToken(const FunctionHandle &handle) const;
+
+  /**
+   * @brief Connect a method through a token of the given type, which has a delegate to it
+   */
+  template<typename TokenType, typename T, typename Method>
+  void ConnectMethod(T *obj, Method method, int index);
+
+  /**
+   * @brief Disconnect the connections to a method made by tokens of the given type
+   */
+  template<typename TokenType, typename T, typename Method>
+  int DisconnectMethod(T *obj, Method method, int start_pos, int counts);
+
+  /**
+   * @brief Count the connections to a method made by tokens of the given type, up to max_count if positive
+   */
+  template<typename TokenType, typename T, typename Method>
+  int CountMethodConnections(T *obj, Method method, int max_count) const;
+
+  template<typename TokenType, typename T, typename Method>
+  static bool IsMethodToken(internal::SignalTokenNode *token, T *obj, Method method) {
+    if ((nullptr == token->binding) || (token->binding->trackable != obj)) return false;
+
+    auto *method_token = dynamic_cast<TokenType *>(token);
+    return (nullptr != method_token) && method_token->delegate().template Equal<T>(obj, method);
+  }
+
+  /**
+   * @brief Link a token and a binding, allocated by the caller
+   */
+  void LinkConnection(internal::CallableToken<ParamTypes..., SLOT> *token,
+                      internal::TrackableBindingNode *binding,
+                      Trackable *receiver,
+                      int index) {
+    _ASSERT(IsOnOwnerThread() && receiver->IsOnOwnerThread());
+
+    Link(token, binding);
+    InsertToken(this, token, index);
+    PushBackBinding(receiver, binding);
+  }
+
+  internal::NodePool *token_pool() const {
+    return nullptr == block_ ? nullptr : block_->tokens();
   }
 
+  internal::NodePool *binding_pool() const {
+    return nullptr == block_ ? nullptr : block_->bindings();
+  }
+
+  /**
+   * @brief Link a waiter, newest first.
+   */
+  void AddWaiter(internal::Waiter<ParamTypes...> *waiter) {
+    waiters_.push_back(waiter);
+  }
+
+  /**
+   * @brief Returns true if a slot stopped the propagation
+   */
+  bool EmitWithLatch(internal::EmitLatch *latch, ParamTypes ... Args);
+
+  void WakeWaiters(internal::WaiterNode *ready, ParamTypes ... Args);
+
+  void CancelWaiters();
+
   internal::InterRelatedDeque<internal::SignalTokenNode> tokens_;
 
+  internal::WaiterNode waiters_;
+
+  // Allocated by the first AddInterceptor(), kept until destroyed:
+  internal::InterceptorChain<ParamTypes...> *interceptors_ = nullptr;
+
+  // Allocated by Reserve():
+  internal::NodeBlock *block_ = nullptr;
+
 };
 
 // Signal implementation:
@@ -880,49 +1734,73 @@ class WIZTK_EXPORT Signal : public Trackable {
 template<typename ... ParamTypes>
 template<typename T>
 void Signal<ParamTypes...>::Connect(T *obj, void (T::*method)(ParamTypes..., SLOT), int index) {
-  Delegate<void(ParamTypes..., SLOT)> d =
-      Delegate<void(ParamTypes..., SLOT)>::template FromMethod<T>(obj, method);
-  auto *token = new internal::DelegateToken<ParamTypes..., SLOT>(d);
-  auto *binding = new internal::TrackableBindingNode;
+  ConnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, index);
+}
+
+template<typename ... ParamTypes>
+template<typename TokenType, typename T, typename Method>
+void Signal<ParamTypes...>::ConnectMethod(T *obj, Method method, int index) {
+  _ASSERT(IsOnOwnerThread() && obj->IsOnOwnerThread());
+
+  auto *token = new(token_pool()) TokenType(TokenType::DelegateType::template FromMethod<T>(obj, method));
+  auto *binding = new(binding_pool()) internal::TrackableBindingNode;
 
   Link(token, binding);
   InsertToken(this, token, index);
   PushBackBinding(obj, binding);  // always push back binding, don't care about the position in observer
 }
 
+template<typename ... ParamTypes>
+template<typename T, typename ... MethodParamTypes, typename BoundType, typename ... BoundTypes>
+typename std::enable_if<sizeof...(MethodParamTypes) == sizeof...(BoundTypes) + sizeof...(ParamTypes) + 2>::type
+Signal<ParamTypes...>::Connect(T *obj, void (T::*method)(MethodParamTypes...), BoundType &&bound, BoundTypes &&... more) {
+  _ASSERT(IsOnOwnerThread() && obj->IsOnOwnerThread());
+
+  typedef typename internal::TupleHead<std::tuple<MethodParamTypes...>,
+                                       std::make_index_sequence<sizeof...(BoundTypes) + 1> >::type BoundTuple;
+  typedef internal::BoundDelegateToken<BoundTuple, ParamTypes..., SLOT> TokenType;
+  static_assert(std::is_same<typename TokenType::DelegateType, Delegate<void(MethodParamTypes...)> >::value,
+                "The method must take the bound parameters, then the signal parameters and the slot");
+
+  auto *token = new TokenType(TokenType::DelegateType::template FromMethod<T>(obj, method),
+                              std::forward<BoundType>(bound), std::forward<BoundTypes>(more)...);
+  auto *binding = new(binding_pool()) internal::TrackableBindingNode;
+
+  Link(token, binding);
+  PushBackToken(this, token);
+  PushBackBinding(obj, binding);
+}
+
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::Connect(Signal<ParamTypes...> &other, int index) {
-  auto *token = new internal::SignalToken<ParamTypes...>(
+  _ASSERT(IsOnOwnerThread() && other.IsOnOwnerThread());
+
+  auto *token = new(token_pool()) internal::SignalToken<ParamTypes...>(
       other);
-  auto *binding = new internal::TrackableBindingNode;
+  auto *binding = new(binding_pool()) internal::TrackableBindingNode;
 
   Link(token, binding);
   InsertToken(this, token, index);
   PushBackBinding(&other, binding);  // always push back binding, don't care about the position in observer
 }
 
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::Connect(internal::CallableToken<ParamTypes..., SLOT> *token,
+                                    Trackable *receiver,
+                                    int index) {
+  LinkConnection(token, new(binding_pool()) internal::TrackableBindingNode, receiver, index);
+}
+
 template<typename ... ParamTypes>
 template<typename T>
 void Signal<ParamTypes...>::DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
-  internal::DelegateToken<ParamTypes..., SLOT> *delegate_token = nullptr;
-  internal::SignalTokenNode *tmp = nullptr;
-
-  internal::InterRelatedDeque<internal::SignalTokenNode>::ReverseIterator it = tokens_.rbegin();
-  while (it != tokens_.rend()) {
-    tmp = it.get();
-    ++it;
-
-    if (tmp->binding->trackable == obj) {
-      delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes..., SLOT> * > (tmp);
-      if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
-        delete tmp;
-      }
-    }
-  }
+  DisconnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, -1, -1);
 }
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
+  _ASSERT(IsOnOwnerThread());
+
   internal::SignalToken<ParamTypes...> *signal_token = nullptr;
   internal::SignalTokenNode *tmp = nullptr;
 
@@ -931,7 +1809,7 @@ void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
     tmp = it.get();
     ++it;
 
-    if (tmp->binding->trackable == (&other)) {
+    if ((nullptr != tmp->binding) && (tmp->binding->trackable == (&other))) {
       signal_token = dynamic_cast<internal::SignalToken<ParamTypes...> * > (tmp);
       if (signal_token && (signal_token->signal() == (&other))) {
         delete tmp;
@@ -943,10 +1821,18 @@ void Signal<ParamTypes...>::DisconnectAll(Signal<ParamTypes...> &other) {
 template<typename ... ParamTypes>
 template<typename T>
 int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., SLOT), int start_pos, int counts) {
-  internal::DelegateToken<ParamTypes..., SLOT> *delegate_token = nullptr;
+  return DisconnectMethod<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, start_pos, counts);
+}
+
+template<typename ... ParamTypes>
+template<typename TokenType, typename T, typename Method>
+int Signal<ParamTypes...>::DisconnectMethod(T *obj, Method method, int start_pos, int counts) {
+  _ASSERT(IsOnOwnerThread());
+
   internal::SignalTokenNode *tmp = nullptr;
   int ret_count = 0;
 
+  start_pos = TokenPosition(start_pos);
   if (start_pos >= 0) {
     internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin();
     while ((it != tokens_.end()) && (start_pos > 0)) {
@@ -958,13 +1844,10 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
       tmp = it.get();
       ++it;
 
-      if (tmp->binding->trackable == obj) {
-        delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes..., SLOT> * > (tmp);
-        if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
-          ret_count++;
-          counts--;
-          delete tmp;
-        }
+      if (IsMethodToken<TokenType>(tmp, obj, method)) {
+        ret_count++;
+        counts--;
+        delete tmp;
       }
       if (counts == 0) break;
     }
@@ -979,13 +1862,10 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
       tmp = it.get();
       ++it;
 
-      if (tmp->binding->trackable == obj) {
-        delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes..., SLOT> * > (tmp);
-        if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
-          ret_count++;
-          counts--;
-          delete tmp;
-        }
+      if (IsMethodToken<TokenType>(tmp, obj, method)) {
+        ret_count++;
+        counts--;
+        delete tmp;
       }
       if (counts == 0) break;
     }
@@ -996,10 +1876,13 @@ int Signal<ParamTypes...>::Disconnect(T *obj, void (T::*method)(ParamTypes..., S
 
 template<typename ... ParamTypes>
 int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_pos, int counts) {
+  _ASSERT(IsOnOwnerThread());
+
   internal::SignalToken<ParamTypes...> *signal_token = nullptr;
   internal::SignalTokenNode *tmp = nullptr;
   int ret_count = 0;
 
+  start_pos = TokenPosition(start_pos);
   if (start_pos >= 0) {
     internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin();
     while ((it != tokens_.end()) && (start_pos > 0)) {
@@ -1011,7 +1894,7 @@ int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_po
       tmp = it.get();
       ++it;
 
-      if (tmp->binding->trackable == (&other)) {
+      if ((nullptr != tmp->binding) && (tmp->binding->trackable == (&other))) {
         signal_token = dynamic_cast<internal::SignalToken<ParamTypes...> * > (tmp);
         if (signal_token && (signal_token->signal() == (&other))) {
           ret_count++;
@@ -1033,7 +1916,7 @@ int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_po
       tmp = it.get();
       ++it;
 
-      if (tmp->binding->trackable == (&other)) {
+      if ((nullptr != tmp->binding) && (tmp->binding->trackable == (&other))) {
         signal_token = dynamic_cast<internal::SignalToken<ParamTypes...> * > (tmp);
         if (signal_token && (signal_token->signal() == (&other))) {
           ret_count++;
@@ -1051,9 +1934,12 @@ int Signal<ParamTypes...>::Disconnect(Signal<ParamTypes...> &other, int start_po
 
 template<typename ... ParamTypes>
 int Signal<ParamTypes...>::Disconnect(int start_pos, int counts) {
+  _ASSERT(IsOnOwnerThread());
+
   internal::SignalTokenNode *tmp = nullptr;
   int ret_count = 0;
 
+  start_pos = TokenPosition(start_pos);
   if (start_pos >= 0) {
     internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin();
     while ((it != tokens_.end()) && (start_pos > 0)) {
@@ -1065,6 +1951,8 @@ int Signal<ParamTypes...>::Disconnect(int start_pos, int counts) {
       tmp = it.get();
       ++it;
 
+      if (nullptr == tmp->binding) continue;  // released by the TrackableTeardownScope
+
       ret_count++;
       counts--;
       delete tmp;
@@ -1083,6 +1971,8 @@ int Signal<ParamTypes...>::Disconnect(int start_pos, int counts) {
       tmp = it.get();
       ++it;
 
+      if (nullptr == tmp->binding) continue;  // released by the TrackableTeardownScope
+
       ret_count++;
       counts--;
       delete tmp;
@@ -1096,20 +1986,30 @@ int Signal<ParamTypes...>::Disconnect(int start_pos, int counts) {
 }
 
 template<typename ... ParamTypes>
-template<typename T>
-bool Signal<ParamTypes...>::IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
-  internal::DelegateToken<ParamTypes..., SLOT> *delegate_token = nullptr;
-
-  for (internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin(); it != tokens_.end();
-       ++it) {
-    if (it->binding->trackable == obj) {
-      delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes..., SLOT> * > (it.get());
-      if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
-        return true;
-      }
+int Signal<ParamTypes...>::TokenPosition(int index) const {
+  // Dead tokens only exist in a scope, and don't move either end:
+  if ((0 == index) || (-1 == index) || (nullptr == TrackableTeardownScope::current())) return index;
+
+  int position = 0;
+  if (index > 0) {
+    for (auto it = tokens_.begin(); (it != tokens_.end()) && (index > 0); ++it) {
+      if (nullptr != it->binding) index--;
+      position++;
+    }
+  } else {
+    position = -1;
+    for (auto it = tokens_.rbegin(); (it != tokens_.rend()) && (index < -1); ++it) {
+      if (nullptr != it->binding) index++;
+      position--;
     }
   }
-  return false;
+  return position;
+}
+
+template<typename ... ParamTypes>
+template<typename T>
+bool Signal<ParamTypes...>::IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
+  return CountMethodConnections<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, 1) > 0;
 }
 
 template<typename ... ParamTypes>
@@ -1118,7 +2018,7 @@ bool Signal<ParamTypes...>::IsConnectedTo(const Signal<ParamTypes...> &other) co
 
   for (internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin(); it != tokens_.end();
        ++it) {
-    if (it->binding->trackable == (&other)) {
+    if ((nullptr != it->binding) && (it->binding->trackable == (&other))) {
       signal_token = dynamic_cast<internal::SignalToken<ParamTypes...> * > (it.get());
       if (signal_token && (signal_token->signal() == (&other))) {
         return true;
@@ -1135,7 +2035,7 @@ bool Signal<ParamTypes...>::IsConnectedTo(const Trackable *obj) const {
 
   while ((it != tokens_.end()) && (binding != obj->bindings_.end())) {
 
-    if (it->binding->trackable == obj) return true;
+    if ((nullptr != it->binding) && (it->binding->trackable == obj)) return true;
     if (binding.get()->token->trackable == this) return true;
 
     ++it;
@@ -1148,17 +2048,17 @@ bool Signal<ParamTypes...>::IsConnectedTo(const Trackable *obj) const {
 template<typename ... ParamTypes>
 template<typename T>
 int Signal<ParamTypes...>::CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
+  return CountMethodConnections<internal::DelegateToken<ParamTypes..., SLOT> >(obj, method, -1);
+}
+
+template<typename ... ParamTypes>
+template<typename TokenType, typename T, typename Method>
+int Signal<ParamTypes...>::CountMethodConnections(T *obj, Method method, int max_count) const {
   int count = 0;
-  internal::DelegateToken<ParamTypes..., SLOT> *delegate_token = nullptr;
 
   for (internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin(); it != tokens_.end();
        ++it) {
-    if (it->binding->trackable == obj) {
-      delegate_token = dynamic_cast<internal::DelegateToken<ParamTypes..., SLOT> * > (it.get());
-      if (delegate_token && (delegate_token->delegate().template Equal<T>(obj, method))) {
-        count++;
-      }
-    }
+    if (IsMethodToken<TokenType>(it.get(), obj, method) && (++count == max_count)) break;
   }
   return count;
 }
@@ -1170,7 +2070,7 @@ int Signal<ParamTypes...>::CountConnections(const Signal<ParamTypes...> &other)
 
   for (internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin(); it != tokens_.end();
        ++it) {
-    if (it->binding->trackable == (&other)) {
+    if ((nullptr != it->binding) && (it->binding->trackable == (&other))) {
       signal_token = dynamic_cast<internal::SignalToken<ParamTypes...> * > (it.get());
       if (signal_token && (signal_token->signal() == (&other))) {
         count++;
@@ -1186,34 +2086,196 @@ int Signal<ParamTypes...>::CountConnections() const {
   for (internal::InterRelatedDeque<internal::SignalTokenNode>::ConstIterator it = tokens_.cbegin();
        it != tokens_.cend();
        ++it) {
-    count++;
+    if (nullptr != it->binding) count++;
   }
   return count;
 }
 
 template<typename ... ParamTypes>
-void Signal<ParamTypes...>::Emit(ParamTypes ... Args) {
-  Slot slot(&tokens_);
+EmitFuture Signal<ParamTypes...>::EmitAsync(ParamTypes ... Args) {
+  auto *latch = new internal::EmitLatch;
+  EmitWithLatch(latch, Args...);
+  latch->CountDown();
+  return EmitFuture(latch);
+}
+
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::AddInterceptor(const InterceptorType &interceptor) {
+  _ASSERT(IsOnOwnerThread() && interceptor);
+
+  if (nullptr == interceptors_) interceptors_ = new internal::InterceptorChain<ParamTypes...>;
+  interceptors_->interceptors.push_back(interceptor);
+}
+
+template<typename ... ParamTypes>
+bool Signal<ParamTypes...>::RemoveInterceptor(const InterceptorType &interceptor) {
+  _ASSERT(IsOnOwnerThread());
+
+  if (nullptr == interceptors_) return false;
+
+  // The chain is not freed here, this may be called from an interceptor:
+  return interceptors_->Remove(interceptor);
+}
+
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::Reserve(size_t count) {
+  _ASSERT(IsOnOwnerThread());
+
+  if (nullptr == block_) {
+    block_ = new internal::NodeBlock(sizeof(internal::DelegateToken<ParamTypes..., SLOT>),
+                                     sizeof(internal::TrackableBindingNode));
+  }
+  block_->Reserve(count);
+}
+
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::ShrinkToFit() {
+  _ASSERT(IsOnOwnerThread());
+
+  if (nullptr != interceptors_) interceptors_->interceptors.shrink_to_fit();
+
+  if (nullptr == block_) return;
+
+  if (0 == block_->GetStats().node_count) {
+    delete block_;
+    block_ = nullptr;
+  } else {
+    block_->Trim();
+  }
+}
+
+template<typename ... ParamTypes>
+SignalMemoryUsage Signal<ParamTypes...>::MemoryUsage() const {
+  const size_t token_size =
+      (sizeof(internal::DelegateToken<ParamTypes..., SLOT>) + internal::kTokenSizeStep - 1)
+          & ~(internal::kTokenSizeStep - 1);
+
+  SignalMemoryUsage usage;
+  usage.connection_count = static_cast<size_t>(CountConnections());
+  usage.bytes = sizeof(*this);
+
+  size_t outside = usage.connection_count;
+  if (nullptr != block_) {
+    NodeArenaStats tokens;
+    NodeArenaStats bindings;
+    block_->tokens()->AddStats(&tokens);
+    block_->bindings()->AddStats(&bindings);
+
+    usage.reserved_count = std::min(tokens.capacity - tokens.node_count, bindings.capacity - bindings.node_count);
+    usage.bytes += sizeof(internal::NodeBlock) + tokens.reserved_bytes + bindings.reserved_bytes;
+    outside = outside > tokens.node_count ? outside - tokens.node_count : 0;
+  }
+  usage.bytes += outside * (token_size + sizeof(internal::TrackableBindingNode));
+
+  if (nullptr != interceptors_) {
+    usage.bytes += sizeof(*interceptors_) + interceptors_->interceptors.capacity() * sizeof(InterceptorType);
+  }
+
+  return usage;
+}
+
+template<typename ... ParamTypes>
+bool Signal<ParamTypes...>::EmitWithLatch(internal::EmitLatch *latch, ParamTypes ... Args) {
+  _ASSERT(IsOnOwnerThread());
+
+  // The interceptors may rewrite the arguments or cancel this emission:
+  if ((nullptr != interceptors_) && !interceptors_->Run(Args...)) return false;
+
+  // Collect the waiters before calling slots, this signal may be deleted in a slot:
+  internal::WaiterNode ready;
+  if (nullptr != waiters_.next()) WakeWaiters(&ready, Args...);
+
+  Slot slot(&tokens_, latch, Slot::Emitting());
 
   while (slot.it_) {
-    slot.it_->slot_mark_head.push_back(&slot.mark_);
-    static_cast<internal::CallableToken<ParamTypes..., SLOT> * > (slot.it_.get())->Invoke(Args..., &slot);
+    // Skip the tokens of receivers destroyed in a TrackableTeardownScope:
+    if (nullptr != slot.it_->binding) {
+      static_cast<internal::CallableToken<ParamTypes..., SLOT> * > (slot.it_.get())->Invoke(Args..., &slot);
+      if (slot.stopped_) break;
+    }
     ++slot;
   }
+
+  internal::WaiterNode *node = nullptr;
+  while (nullptr != (node = ready.next())) {
+    node->unlink();
+    node->OnResume();
+  }
+
+  return slot.stopped_;
+}
+
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::WakeWaiters(internal::WaiterNode *ready, ParamTypes ... Args) {
+  internal::WaiterNode *node = waiters_.next();
+  internal::WaiterNode *next = nullptr;
+
+  // Waiters are linked newest first, moving each one just after the ready
+  // head reverses the order, so they are resumed in the order they started:
+  while (nullptr != node) {
+    next = node->next();
+    if (static_cast<internal::Waiter<ParamTypes...> *>(node)->OnEmit(Args...)) {
+      ready->push_back(node);
+    }
+    node = next;
+  }
+}
+
+template<typename ... ParamTypes>
+void Signal<ParamTypes...>::CancelWaiters() {
+  internal::WaiterNode *node = nullptr;
+  while (nullptr != (node = waiters_.next())) {
+    node->unlink();
+    node->OnCancel();
+  }
+}
+
+template<typename ... ParamTypes>
+bool Signal<ParamTypes...>::Disconnect(const FunctionHandle &handle) {
+  _ASSERT(IsOnOwnerThread());
+
+  internal::FunctionToken<ParamTypes...> *token = FindFunctionToken(handle);
+  if (nullptr == token) return false;
+
+  delete token;
+  return true;
+}
+
+template<typename ... ParamTypes>
+internal::FunctionToken<ParamTypes...> *Signal<ParamTypes...>::FindFunctionToken(const FunctionHandle &handle) const {
+  if (nullptr == handle.token_) return nullptr;
+
+  // Only the address is compared until found, the token may be freed and its memory reused:
+  for (internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin(); it != tokens_.end();
+       ++it) {
+    if (it.get() == handle.token_) {
+      auto *token = dynamic_cast<internal::FunctionToken<ParamTypes...> *>(it.get());
+      return ((nullptr != token) && (token->id() == handle.id_)) ? token : nullptr;
+    }
+  }
+  return nullptr;
 }
 
 template<typename ... ParamTypes>
 void Signal<ParamTypes...>::DisconnectAll() {
+  _ASSERT(IsOnOwnerThread());
+
   internal::InterRelatedDeque<internal::SignalTokenNode>::Iterator it = tokens_.begin();
-  internal::InterRelatedNodeBase *tmp = nullptr;
+  internal::SignalTokenNode *tmp = nullptr;
 
   while (it != tokens_.end()) {
     tmp = it.get();
     ++it;
-    delete tmp;
+    // Dead tokens are released by the TrackableTeardownScope:
+    if (nullptr != tmp->binding) delete tmp;
   }
 }
 
+template<typename ... ParamTypes>
+void internal::SignalToken<ParamTypes...>::Invoke(ParamTypes... Args, SLOT slot) {
+  if (signal_->EmitWithLatch(slot->latch_, Args...)) slot->StopPropagation();
+}
+
 /**
  * @ingroup base
  * @brief A reference to a corresponding signal
@@ -1243,15 +2305,63 @@ class WIZTK_EXPORT SignalRef {
     signal_->Connect(obj, method, index);
   }
 
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes..., SLOT) const, int index = -1) {
+    signal_->Connect(obj, method, index);
+  }
+
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes...), int index = -1) {
+    signal_->Connect(obj, method, index);
+  }
+
+  template<typename T>
+  void Connect(T *obj, void (T::*method)(ParamTypes...) const, int index = -1) {
+    signal_->Connect(obj, method, index);
+  }
+
+  template<typename T, typename ... MethodParamTypes, typename BoundType, typename ... BoundTypes>
+  typename std::enable_if<sizeof...(MethodParamTypes) == sizeof...(BoundTypes) + sizeof...(ParamTypes) + 2>::type
+  Connect(T *obj, void (T::*method)(MethodParamTypes...), BoundType &&bound, BoundTypes &&... more) {
+    signal_->Connect(obj, method, std::forward<BoundType>(bound), std::forward<BoundTypes>(more)...);
+  }
+
   void Connect(Signal<ParamTypes...> &signal, int index = -1) {
     signal_->Connect(signal, index);
   }
 
+  template<typename F>
+  typename std::enable_if<std::is_convertible<F, void (*)(ParamTypes...)>::value, FunctionHandle>::type
+  Connect(F function, int index = -1) {
+    return signal_->Connect(function, index);
+  }
+
+  template<typename F>
+  typename std::enable_if<std::is_convertible<F, void (*)(ParamTypes..., SLOT)>::value, FunctionHandle>::type
+  Connect(F function, int index = -1) {
+    return signal_->Connect(function, index);
+  }
+
   template<typename T>
   void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT)) {
     signal_->DisconnectAll(obj, method);
   }
 
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes..., SLOT) const) {
+    signal_->DisconnectAll(obj, method);
+  }
+
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes...)) {
+    signal_->DisconnectAll(obj, method);
+  }
+
+  template<typename T>
+  void DisconnectAll(T *obj, void (T::*method)(ParamTypes...) const) {
+    signal_->DisconnectAll(obj, method);
+  }
+
   void DisconnectAll(Signal<ParamTypes...> &signal) {
     signal_->DisconnectAll(signal);
   }
@@ -1261,6 +2371,21 @@ class WIZTK_EXPORT SignalRef {
     return signal_->Disconnect(obj, method, start_pos, counts);
   }
 
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes..., SLOT) const, int start_pos = -1, int counts = 1) {
+    return signal_->Disconnect(obj, method, start_pos, counts);
+  }
+
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes...), int start_pos = -1, int counts = 1) {
+    return signal_->Disconnect(obj, method, start_pos, counts);
+  }
+
+  template<typename T>
+  int Disconnect(T *obj, void (T::*method)(ParamTypes...) const, int start_pos = -1, int counts = 1) {
+    return signal_->Disconnect(obj, method, start_pos, counts);
+  }
+
   int Disconnect(Signal<ParamTypes...> &signal, int start_pos = -1, int counts = 1) {
     return signal_->Disconnect(signal, start_pos, counts);
   }
@@ -1269,6 +2394,10 @@ class WIZTK_EXPORT SignalRef {
     return signal_->Disconnect(start_pos, counts);
   }
 
+  bool Disconnect(const FunctionHandle &handle) {
+    return signal_->Disconnect(handle);
+  }
+
   void DisconnectAll() {
     signal_->DisconnectAll();
   }
@@ -1278,6 +2407,21 @@ class WIZTK_EXPORT SignalRef {
     return signal_->IsConnectedTo(obj, method);
   }
 
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes..., SLOT) const) const {
+    return signal_->IsConnectedTo(obj, method);
+  }
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes...)) const {
+    return signal_->IsConnectedTo(obj, method);
+  }
+
+  template<typename T>
+  bool IsConnectedTo(T *obj, void (T::*method)(ParamTypes...) const) const {
+    return signal_->IsConnectedTo(obj, method);
+  }
+
   bool IsConnectedTo(const Signal<ParamTypes...> &signal) const {
     return signal_->IsConnectedTo(signal);
   }
@@ -1286,11 +2430,30 @@ class WIZTK_EXPORT SignalRef {
     return signal_->IsConnectedTo(obj);
   }
 
+  bool IsConnectedTo(const FunctionHandle &handle) const {
+    return signal_->IsConnectedTo(handle);
+  }
+
   template<typename T>
   int CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT)) const {
     return signal_->CountConnections(obj, method);
   }
 
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes..., SLOT) const) const {
+    return signal_->CountConnections(obj, method);
+  }
+
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes...)) const {
+    return signal_->CountConnections(obj, method);
+  }
+
+  template<typename T>
+  int CountConnections(T *obj, void (T::*method)(ParamTypes...) const) const {
+    return signal_->CountConnections(obj, method);
+  }
+
   int CountConnections(const Signal<ParamTypes...> &signal) const {
     return signal_->CountConnections(signal);
   }
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file wiring.hpp
+ * @brief Header file for connecting signals from a table built at compile time.
+ */
+
+#ifndef WIZTK_BASE_WIRING_HPP_
+#define WIZTK_BASE_WIRING_HPP_
+
+#include "sigcxx/sigcxx.hpp"
+#include "sigcxx/node_arena.hpp"
+
+#include <iterator>
+#include <type_traits>
+
+namespace sigcxx {
+
+/**
+ * @ingroup base
+ * @brief One connection of a wiring table, made with WIZTK_WIRE().
+ */
+template<typename Context>
+struct WiringEntry {
+
+  typedef void (*ConnectFunction)(Context &context);
+
+  ConnectFunction connect;
+
+  /**
+   * @brief Size of the token this connection allocates
+   */
+  size_t token_size;
+
+};
+
+namespace internal {
+
+/**
+ * @ingroup base_intern
+ * @brief What an accessor of a wiring entry gets from the context.
+ *
+ * An accessor is a data member pointer of the context, or a function
+ * taking the context by reference.
+ */
+template<typename Accessor>
+struct WiringAccessor {
+  static constexpr bool kValid = false;
+};
+
+template<typename C, typename M>
+struct WiringAccessor<M C::*> {
+  static constexpr bool kValid = !std::is_function<M>::value;
+  typedef C ContextType;
+  typedef M ValueType;
+  static M &Get(C &context, M C::*accessor) { return context.*accessor; }
+};
+
+template<typename C, typename R>
+struct WiringAccessor<R (*)(C &)> {
+  static constexpr bool kValid = true;
+  typedef C ContextType;
+  typedef typename std::remove_reference<R>::type ValueType;
+  static R Get(C &context, R (*accessor)(C &)) { return accessor(context); }
+};
+
+/**
+ * @ingroup base_intern
+ * @brief The receiver type of a receiver accessor, which can give an object or a pointer.
+ */
+template<typename T>
+struct WiringReceiver {
+  typedef T Type;
+  static T *ToPointer(T &receiver) { return &receiver; }
+};
+
+template<typename T>
+struct WiringReceiver<T *> {
+  typedef T Type;
+  static T *ToPointer(T *receiver) { return receiver; }
+};
+
+template<typename T>
+struct WiringSignal {
+  static constexpr bool kValid = false;
+};
+
+template<typename ... ParamTypes>
+struct WiringSignal<Signal<ParamTypes...> > {
+  static constexpr bool kValid = true;
+  typedef void (Trackable::*MethodType)(ParamTypes..., SLOT);
+  typedef DelegateToken<ParamTypes..., SLOT> TokenType;
+};
+
+template<typename Method>
+struct WiringMethod {
+  static constexpr bool kValid = false;
+};
+
+template<typename T, typename ... ParamTypes>
+struct WiringMethod<void (T::*)(ParamTypes...)> {
+  static constexpr bool kValid = true;
+  typedef T ClassType;
+  typedef void (Trackable::*ErasedType)(ParamTypes...);
+};
+
+/**
+ * @ingroup base_intern
+ * @brief Check one wiring entry at compile time and connect it at runtime.
+ */
+template<typename SignalAccessor, SignalAccessor signal_accessor,
+    typename ReceiverAccessor, ReceiverAccessor receiver_accessor,
+    typename Method, Method method>
+struct WiringConnector {
+
+  static_assert(WiringAccessor<SignalAccessor>::kValid,
+                "The signal accessor must be a data member pointer or a function taking the context");
+  static_assert(WiringAccessor<ReceiverAccessor>::kValid,
+                "The receiver accessor must be a data member pointer or a function taking the context");
+
+  typedef typename WiringAccessor<SignalAccessor>::ContextType Context;
+  typedef typename std::remove_cv<typename WiringAccessor<SignalAccessor>::ValueType>::type SignalType;
+  typedef typename WiringReceiver<typename WiringAccessor<ReceiverAccessor>::ValueType>::Type Receiver;
+
+  static_assert(std::is_same<Context, typename WiringAccessor<ReceiverAccessor>::ContextType>::value,
+                "The signal and the receiver must be accessed from the same context type");
+  static_assert(WiringSignal<SignalType>::kValid, "The signal accessor must give a sigcxx::Signal");
+  static_assert(WiringMethod<Method>::kValid, "The method must be a method pointer returning void");
+
+  typedef typename WiringMethod<Method>::ClassType MethodClass;
+
+  static_assert(std::is_base_of<MethodClass, Receiver>::value,
+                "The method must be a method of the receiver");
+  static_assert(std::is_base_of<Trackable, MethodClass>::value,
+                "The method must be a method of a sigcxx::Trackable");
+  static_assert(std::is_same<typename WiringMethod<Method>::ErasedType,
+                             typename WiringSignal<SignalType>::MethodType>::value,
+                "The method must take the signal parameters and the slot");
+
+  static void Connect(Context &context) {
+    MethodClass *receiver = WiringReceiver<typename WiringAccessor<ReceiverAccessor>::ValueType>::ToPointer(
+        WiringAccessor<ReceiverAccessor>::Get(context, receiver_accessor));
+    WiringAccessor<SignalAccessor>::Get(context, signal_accessor).Connect(receiver, method);
+  }
+
+  static constexpr WiringEntry<Context> entry() {
+    return WiringEntry<Context>{&Connect, sizeof(typename WiringSignal<SignalType>::TokenType)};
+  }
+
+};
+
+} // namespace internal
+
+/**
+ * @ingroup base
+ * @brief Connect the entries of a wiring table for a range of contexts.
+ *
+ * The nodes of all connections are counted first, and the arena pages they
+ * need are mapped and populated at once (see NodeArena), then the entries are
+ * connected in one sweep, in the order of the table for each context.
+ */
+template<typename Iterator, typename Context, size_t N>
+void ApplyWiring(Iterator first, Iterator last, const WiringEntry<Context> (&table)[N]) {
+  size_t count = static_cast<size_t>(std::distance(first, last));
+
+  internal::NodeReservation reservation;
+  for (const WiringEntry<Context> &entry : table) reservation.AddTokens(entry.token_size, count);
+  reservation.AddBindings(N * count);
+  reservation.Commit();
+
+  for (; first != last; ++first) {
+    Context &context = *first;
+    for (const WiringEntry<Context> &entry : table) entry.connect(context);
+  }
+}
+
+/**
+ * @ingroup base
+ * @brief Connect the entries of a wiring table for one context.
+ */
+template<typename Context, size_t N>
+void ApplyWiring(Context &context, const WiringEntry<Context> (&table)[N]) {
+  ApplyWiring(&context, &context + 1, table);
+}
+
+} // namespace sigcxx
+
+/**
+ * @ingroup base
+ * @brief An entry of a wiring table, checked at compile time.
+ *
+ * SIGNAL and RECEIVER are accessors of a context type: data member pointers
+ * (to a Signal, to a receiver object or to a receiver pointer) or functions
+ * taking the context by reference. METHOD is a method of the receiver which
+ * takes the signal parameters and the slot:
+ *
+ * @code
+ * constexpr sigcxx::WiringEntry<App> kAppWiring[] = {
+ *   WIZTK_WIRE(&App::clicked, &App::view, &View::OnClicked),
+ *   WIZTK_WIRE(&App::resized, &GetLayout, &Layout::OnResized),
+ * };
+ *
+ * sigcxx::ApplyWiring(app, kAppWiring);
+ * @endcode
+ */
+#define WIZTK_WIRE(SIGNAL, RECEIVER, METHOD) \
+  ::sigcxx::internal::WiringConnector<decltype(SIGNAL), SIGNAL, \
+                                      decltype(RECEIVER), RECEIVER, \
+                                      decltype(METHOD), METHOD>::entry()
+
+#endif // WIZTK_BASE_WIRING_HPP_
@@ -65,4 +65,16 @@ void BinodeBase::Unlink(BinodeBase *node) {
   if (notify) node->OnUnlinked();
 }
 
+CountedDequeNodeBase::~CountedDequeNodeBase() {
+  Leave();
+}
+
+void CountedDequeNodeBase::Leave() {
+  if (nullptr != deque_) {
+    deque_->count_--;
+    deque_ = nullptr;
+  }
+  Unlink(this);
+}
+
 } // namespace sigcxx
@@ -0,0 +1,247 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/compact_signal.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sigcxx {
+
+namespace internal {
+
+namespace {
+
+std::mutex &GetMutex() {
+  static std::mutex *mutex = new std::mutex;
+  return *mutex;
+}
+
+// Guarded by GetMutex():
+uint32_t free_list = CompactArena::kNull;   // linked by signal_next
+uint32_t next_index = 1;                   // the nodes from here have never been used
+uint32_t chunk_count = 0;
+size_t node_count = 0;
+
+std::unordered_map<std::string, const CompactMethod *> &GetMethods() {
+  static auto *methods = new std::unordered_map<std::string, const CompactMethod *>;
+  return *methods;
+}
+
+thread_local int emit_depth = 0;
+
+// Nodes broken during an emission in this thread, freed when the outermost one ends:
+thread_local std::vector<uint32_t> pending;
+
+// The last method registered in this thread, most connections repeat it:
+thread_local const CompactMethod *last_method = nullptr;
+
+inline std::string MethodKey(void (*stub)(), GenericMethodPointer method) {
+  CompactMethod key;
+  std::memset(&key, 0, sizeof(key));
+  key.stub = stub;
+  key.method = method;
+  return std::string(reinterpret_cast<const char *>(&key), sizeof(key));
+}
+
+inline void InitHead(CompactNode *node, uint32_t index) {
+  node->object = nullptr;
+  node->method = nullptr;
+  node->signal_previous = index;
+  node->signal_next = index;
+  node->receiver_previous = index;
+  node->receiver_next = index;
+}
+
+}  // namespace
+
+CompactNode *CompactArena::chunks_[CompactArena::kMaxChunks] = {nullptr};
+
+void CompactArena::Connect(uint32_t *signal_head, uint32_t *receiver_head, void *object, const CompactMethod *method) {
+  if (kNull == *signal_head) {
+    *signal_head = Allocate();
+    InitHead(Node(*signal_head), *signal_head);
+  }
+  if (kNull == *receiver_head) {
+    *receiver_head = Allocate();
+    InitHead(Node(*receiver_head), *receiver_head);
+  }
+
+  uint32_t index = Allocate();
+  CompactNode *node = Node(index);
+  node->object = object;
+  node->method = method;
+
+  CompactNode *head = Node(*signal_head);
+  node->signal_previous = head->signal_previous;
+  node->signal_next = *signal_head;
+  Node(head->signal_previous)->signal_next = index;
+  head->signal_previous = index;
+
+  head = Node(*receiver_head);
+  node->receiver_previous = head->receiver_previous;
+  node->receiver_next = *receiver_head;
+  Node(head->receiver_previous)->receiver_next = index;
+  head->receiver_previous = index;
+}
+
+void CompactArena::Disconnect(uint32_t index) {
+  CompactNode *node = Node(index);
+
+  Node(node->receiver_previous)->receiver_next = node->receiver_next;
+  Node(node->receiver_next)->receiver_previous = node->receiver_previous;
+  node->receiver_previous = index;
+  node->receiver_next = index;
+  node->object = nullptr;
+
+  if (emit_depth > 0) {
+    // An emission may be on this node, keep it linked in the signal:
+    pending.push_back(index);
+    return;
+  }
+
+  UnlinkFromSignal(node);
+  Free(index);
+}
+
+void CompactArena::ReleaseHead(uint32_t index) {
+  if (emit_depth > 0) {
+    pending.push_back(index);
+    return;
+  }
+
+  Free(index);
+}
+
+const CompactMethod *CompactArena::RegisterMethod(void (*stub)(), GenericMethodPointer method) {
+  if ((nullptr != last_method) && (stub == last_method->stub) && (method == last_method->method)) {
+    return last_method;
+  }
+
+  std::string key = MethodKey(stub, method);
+
+  std::lock_guard<std::mutex> lock(GetMutex());
+  const CompactMethod *&entry = GetMethods()[key];
+  if (nullptr == entry) {
+    // Never freed, there is one per slot method:
+    entry = new CompactMethod{stub, method};
+  }
+  last_method = entry;
+  return entry;
+}
+
+void CompactArena::BeginEmit() {
+  emit_depth++;
+}
+
+void CompactArena::EndEmit() {
+  if ((0 == --emit_depth) && !pending.empty()) FreePending();
+}
+
+CompactArenaStats CompactArena::GetStats() {
+  std::lock_guard<std::mutex> lock(GetMutex());
+
+  CompactArenaStats stats;
+  stats.node_count = node_count;
+  stats.capacity = static_cast<size_t>(chunk_count) * kChunkSize;
+  stats.used_bytes = node_count * sizeof(CompactNode);
+  stats.reserved_bytes = stats.capacity * sizeof(CompactNode);
+  return stats;
+}
+
+uint32_t CompactArena::Allocate() {
+  std::lock_guard<std::mutex> lock(GetMutex());
+
+  uint32_t index = free_list;
+  if (kNull != index) {
+    free_list = Node(index)->signal_next;
+  } else {
+    if ((next_index >> kChunkBits) >= chunk_count) {
+      if (chunk_count >= kMaxChunks) throw std::bad_alloc();
+
+      // Chunks are never moved or freed, readers don't need the lock:
+      void *chunk = std::malloc(kChunkSize * sizeof(CompactNode));
+      if (nullptr == chunk) throw std::bad_alloc();
+      chunks_[chunk_count++] = static_cast<CompactNode *>(chunk);
+    }
+    index = next_index++;
+  }
+
+  node_count++;
+  return index;
+}
+
+void CompactArena::Free(uint32_t index) {
+  std::lock_guard<std::mutex> lock(GetMutex());
+
+  Node(index)->signal_next = free_list;
+  free_list = index;
+  node_count--;
+}
+
+void CompactArena::UnlinkFromSignal(CompactNode *node) {
+  Node(node->signal_previous)->signal_next = node->signal_next;
+  Node(node->signal_next)->signal_previous = node->signal_previous;
+}
+
+void CompactArena::FreePending() {
+  std::vector<uint32_t> nodes;
+  nodes.swap(pending);
+
+  // Unlink all broken connections first, their neighbours may be pending
+  // too, then free them with the heads of the destroyed signals:
+  for (uint32_t index : nodes) {
+    CompactNode *node = Node(index);
+    if (nullptr != node->method) UnlinkFromSignal(node);
+  }
+  for (uint32_t index : nodes) Free(index);
+}
+
+} // namespace internal
+
+CompactTrackable::~CompactTrackable() {
+  if (internal::CompactArena::kNull == head_) return;
+
+  UnbindAllCompactSignals();
+  internal::CompactArena::ReleaseHead(head_);
+}
+
+size_t CompactTrackable::CountCompactBindings() const {
+  if (internal::CompactArena::kNull == head_) return 0;
+
+  size_t count = 0;
+  for (uint32_t index = internal::CompactArena::Node(head_)->receiver_next; index != head_;) {
+    count++;
+    index = internal::CompactArena::Node(index)->receiver_next;
+  }
+  return count;
+}
+
+void CompactTrackable::UnbindAllCompactSignals() {
+  if (internal::CompactArena::kNull == head_) return;
+
+  uint32_t index = internal::CompactArena::kNull;
+  while (head_ != (index = internal::CompactArena::Node(head_)->receiver_next)) {
+    internal::CompactArena::Disconnect(index);
+  }
+}
+
+} // namespace sigcxx
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/epoch.hpp"
+
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+
+namespace sigcxx {
+
+namespace internal {
+
+namespace {
+
+struct RetiredNode {
+  void *node;
+  EpochDomain::Deleter deleter;
+  uint64_t epoch;
+};
+
+std::atomic<EpochRecord *> record_list(nullptr);
+
+std::mutex retired_mutex;
+
+std::vector<RetiredNode> &RetiredNodes() {
+  static std::vector<RetiredNode> *nodes = new std::vector<RetiredNode>;  // never destroyed
+  return *nodes;
+}
+
+/**
+ * @brief Give the record back when the thread exits.
+ */
+struct RecordReleaser {
+  EpochRecord *record = nullptr;
+  ~RecordReleaser() {
+    if (nullptr != record) {
+      record->epoch.store(0, std::memory_order_release);
+      record->nesting = 0;
+      record->in_use.store(false, std::memory_order_release);
+    }
+  }
+};
+
+/**
+ * @brief Returns if the thread of a record waits for the target in Synchronize(), directly or through others.
+ */
+bool IsWaitingFor(const EpochRecord *record, const EpochRecord *target) {
+  // Bounded, other threads may wait for each other without the target:
+  for (int i = 0; (i < 64) && (nullptr != record); i++) {
+    record = record->waiting_for.load();
+    if (record == target) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+// Starts from 1, 0 means a thread is not in a critical section:
+std::atomic<uint64_t> EpochDomain::global_epoch_(1);
+
+std::atomic<size_t> EpochDomain::retired_count_(0);
+
+EpochRecord *EpochDomain::AcquireRecord() {
+  static thread_local RecordReleaser releaser;
+
+  EpochRecord *record = nullptr;
+  for (EpochRecord *p = record_list.load(std::memory_order_acquire); nullptr != p; p = p->next) {
+    bool expected = false;
+    if (!p->in_use.load(std::memory_order_relaxed) &&
+        p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      record = p;
+      break;
+    }
+  }
+
+  if (nullptr == record) {
+    // Records are never freed, and plain new is not aligned to a cache line before C++17:
+    void *memory = nullptr;
+    if (0 != posix_memalign(&memory, alignof(EpochRecord), sizeof(EpochRecord))) throw std::bad_alloc();
+    record = new(memory) EpochRecord;
+    record->in_use.store(true, std::memory_order_relaxed);
+    EpochRecord *head = record_list.load(std::memory_order_relaxed);
+    do {
+      record->next = head;
+    } while (!record_list.compare_exchange_weak(head, record, std::memory_order_release));
+  }
+
+  releaser.record = record;
+  return record;
+}
+
+void EpochDomain::Synchronize() {
+  EpochRecord *self = GetRecord();
+  uint64_t epoch = global_epoch_.fetch_add(1) + 1;
+
+  for (EpochRecord *p = record_list.load(std::memory_order_acquire); nullptr != p; p = p->next) {
+    if (p == self) continue;
+
+    uint64_t value = p->epoch.load();
+    if ((0 == value) || (value >= epoch)) continue;
+
+    // Sequentially consistent: of the threads waiting for each other, at least the last one sees the cycle:
+    self->waiting_for.store(p);
+    while ((0 != value) && (value < epoch) && !IsWaitingFor(p, self)) {
+      std::this_thread::yield();
+      value = p->epoch.load();
+    }
+  }
+
+  self->waiting_for.store(nullptr, std::memory_order_release);
+}
+
+void EpochDomain::Retire(void *node, Deleter deleter) {
+  // Threads entering from now on announce a newer epoch and cannot see the node:
+  uint64_t epoch = global_epoch_.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    RetiredNodes().push_back(RetiredNode{node, deleter, epoch});
+    retired_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (!IsInCriticalSection()) Reclaim();
+}
+
+void EpochDomain::Reclaim() {
+  uint64_t oldest = UINT64_MAX;
+  for (EpochRecord *p = record_list.load(std::memory_order_acquire); nullptr != p; p = p->next) {
+    uint64_t value = p->epoch.load();
+    if ((0 != value) && (value < oldest)) oldest = value;
+  }
+
+  std::vector<RetiredNode> expired;
+  {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    std::vector<RetiredNode> &nodes = RetiredNodes();
+    size_t kept = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+      if (nodes[i].epoch < oldest) {
+        expired.push_back(nodes[i]);
+      } else {
+        nodes[kept++] = nodes[i];
+      }
+    }
+    nodes.resize(kept);
+    retired_count_.store(kept, std::memory_order_relaxed);
+  }
+
+  for (const RetiredNode &retired : expired) {
+    retired.deleter(retired.node);
+  }
+}
+
+} // namespace internal
+
+} // namespace sigcxx
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/event_bus.hpp"
+
+namespace sigcxx {
+
+namespace {
+
+const size_t kInitialCapacity = 16;
+
+}  // namespace
+
+EventBus::EventBus()
+    : entries_(kInitialCapacity, Entry{0, nullptr}) {
+}
+
+EventBus::~EventBus() {
+  for (const Entry &entry : entries_) {
+    delete entry.channel;
+  }
+}
+
+void EventBus::Insert(EventId id, internal::EventChannelBase *channel) {
+  if (2 * (count_ + 1) > entries_.size()) {
+    std::vector<Entry> old(entries_.size() * 2, Entry{0, nullptr});
+    old.swap(entries_);
+
+    size_t mask = entries_.size() - 1;
+    for (const Entry &entry : old) {
+      if (0 == entry.id) continue;
+
+      size_t i = Mix(entry.id) & mask;
+      while (0 != entries_[i].id) i = (i + 1) & mask;
+      entries_[i] = entry;
+    }
+  }
+
+  size_t mask = entries_.size() - 1;
+  size_t i = Mix(id) & mask;
+  while (0 != entries_[i].id) i = (i + 1) & mask;
+  entries_[i] = Entry{id, channel};
+  count_++;
+}
+
+} // namespace sigcxx
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/event_queue.hpp"
+
+#include <chrono>
+
+namespace sigcxx {
+
+namespace internal {
+
+void EventQueueCore::Post(QueuedCallBase *call) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!closed_) {
+      call->next = nullptr;
+      if (nullptr == tail_) {
+        head_ = call;
+      } else {
+        tail_->next = call;
+      }
+      tail_ = call;
+      ++count_;
+      call = nullptr;
+    }
+  }
+
+  if (nullptr == call) {
+    condition_.notify_one();
+  } else {
+    delete call;  // the queue is destroyed
+  }
+}
+
+size_t EventQueueCore::Process() {
+  QueuedCallBase *list = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    list = head_;
+    head_ = tail_ = nullptr;
+    count_ = 0;
+  }
+
+  // Calls posted by the slot methods are processed next time:
+  size_t count = 0;
+  QueuedCallBase *next = nullptr;
+  while (nullptr != list) {
+    next = list->next;
+    list->Run();
+    delete list;
+    list = next;
+    ++count;
+  }
+
+  return count;
+}
+
+bool EventQueueCore::Wait(int timeout_ms) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (timeout_ms < 0) {
+    condition_.wait(lock, [this]() { return nullptr != head_; });
+    return true;
+  }
+
+  return condition_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                             [this]() { return nullptr != head_; });
+}
+
+size_t EventQueueCore::pending_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_;
+}
+
+void EventQueueCore::Close() {
+  QueuedCallBase *list = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    list = head_;
+    head_ = tail_ = nullptr;
+    count_ = 0;
+  }
+
+  QueuedCallBase *next = nullptr;
+  while (nullptr != list) {
+    next = list->next;
+    delete list;
+    list = next;
+  }
+}
+
+} // namespace internal
+
+} // namespace sigcxx
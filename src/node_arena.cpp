@@ -0,0 +1,453 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/node_arena.hpp"
+#include "sigcxx/sigcxx.hpp"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace sigcxx {
+
+namespace internal {
+
+struct NodePool::Page {
+  NodePool *pool;
+
+  Page *previous_available;
+  Page *next_available;
+  bool available;
+
+  Page *previous;
+  Page *next;
+
+  FreeNode *free_list;
+  char *bump;   // the slots from here have never been used
+  char *end;
+
+  size_t live_count;
+  size_t capacity;
+};
+
+namespace {
+
+// The first slot starts on its own cache line after the page header:
+const size_t kHeaderSize = 128;
+
+}  // namespace
+
+NodePool::NodePool(size_t node_size, RelocateFunction relocate)
+    : node_size_(node_size), relocate_(relocate) {
+  static_assert(sizeof(Page) <= kHeaderSize, "The page header must fit");
+  _ASSERT(node_size_ >= sizeof(FreeNode));
+}
+
+NodePool::~NodePool() {
+  _ASSERT(0 == node_count_);
+
+  Page *page = pages_;
+  Page *next = nullptr;
+  while (nullptr != page) {
+    next = page->next;
+    munmap(page, kPageSize);
+    page = next;
+  }
+}
+
+NodePool *NodePool::Of(void *node) {
+  return PageOf(node)->pool;
+}
+
+void *NodePool::Allocate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Page *page = available_;
+  if (nullptr == page) page = NewPage();
+  return AllocateIn(page);
+}
+
+void NodePool::Free(void *node) {
+  Page *page = PageOf(node);
+  bool last = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeIn(page, node);
+    last = released_ && (0 == node_count_);
+  }
+
+  if (last) delete this;
+}
+
+void NodePool::Reserve(size_t count) {
+  size_t page_count = CountMissingPages(count);
+  if (page_count > 0) AddPages(MapPages(page_count, false), page_count);
+}
+
+void NodePool::Release() {
+  bool last = false;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    released_ = true;
+    last = 0 == node_count_;
+  }
+
+  if (last) delete this;
+}
+
+size_t NodePool::Compact() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t moved = 0;
+
+  if (nullptr != relocate_) {
+    std::vector<Page *> pages;
+    for (Page *page = pages_; nullptr != page; page = page->next) {
+      if (page->live_count > 0) pages.push_back(page);
+    }
+
+    // Fill the densest pages with the nodes of the sparsest ones:
+    std::sort(pages.begin(), pages.end(), [](const Page *a, const Page *b) {
+      return a->live_count > b->live_count;
+    });
+
+    std::vector<bool> free_slots;
+    size_t dst = 0;
+    size_t src = pages.size();
+    while (src > dst + 1) {
+      Page *from = pages[src - 1];
+      char *first = reinterpret_cast<char *>(from) + kHeaderSize;
+      size_t used = static_cast<size_t>(from->bump - first) / node_size_;
+
+      free_slots.assign(used, false);
+      for (FreeNode *node = from->free_list; nullptr != node; node = node->next) {
+        free_slots[static_cast<size_t>(reinterpret_cast<char *>(node) - first) / node_size_] = true;
+      }
+
+      for (size_t i = 0; i < used; i++) {
+        if (free_slots[i]) continue;
+
+        while ((dst < src - 1) && !pages[dst]->available) dst++;
+        if (dst >= src - 1) break;
+
+        void *node = first + i * node_size_;
+        relocate_(node, AllocateIn(pages[dst]));
+        FreeIn(from, node);
+        moved++;
+      }
+
+      src--;
+    }
+  }
+
+  TrimLocked();
+  return moved;
+}
+
+size_t NodePool::Trim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return TrimLocked();
+}
+
+void NodePool::AddStats(NodeArenaStats *stats) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (Page *page = pages_; nullptr != page; page = page->next) {
+    stats->page_count++;
+    if (0 == page->live_count) stats->empty_page_count++;
+    stats->node_count += page->live_count;
+    stats->capacity += page->capacity;
+    stats->reserved_bytes += kPageSize;
+  }
+}
+
+size_t NodePool::CountMissingPages(size_t count) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  size_t free_count = 0;
+  for (Page *page = available_; nullptr != page; page = page->next_available) {
+    free_count += page->capacity - page->live_count;
+  }
+  if (free_count >= count) return 0;
+
+  size_t capacity = (kPageSize - kHeaderSize) / node_size_;
+  return (count - free_count + capacity - 1) / capacity;
+}
+
+void NodePool::AddPages(void *pages, size_t page_count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (size_t i = 0; i < page_count; i++) {
+    InitPage(reinterpret_cast<Page *>(static_cast<char *>(pages) + i * kPageSize));
+  }
+}
+
+void *NodePool::MapPages(size_t page_count, bool populate) {
+  // Map one more page to find an aligned start, so PageOf() works with a mask:
+  size_t size = page_count * kPageSize;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+  if (populate) flags |= MAP_POPULATE;
+#endif
+  void *memory = mmap(nullptr, size + kPageSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (MAP_FAILED == memory) throw std::bad_alloc();
+
+  uintptr_t start = reinterpret_cast<uintptr_t>(memory);
+  uintptr_t aligned = (start + kPageSize - 1) & ~(uintptr_t) (kPageSize - 1);
+  if (aligned > start) munmap(memory, aligned - start);
+  if (aligned + size < start + size + kPageSize) {
+    munmap(reinterpret_cast<void *>(aligned + size), start + kPageSize - aligned);
+  }
+
+  return reinterpret_cast<void *>(aligned);
+}
+
+NodePool::Page *NodePool::NewPage() {
+  Page *page = static_cast<Page *>(MapPages(1, false));
+  InitPage(page);
+  return page;
+}
+
+void NodePool::InitPage(Page *page) {
+  page->pool = this;
+  page->previous_available = nullptr;
+  page->next_available = nullptr;
+  page->available = false;
+  page->previous = nullptr;
+  page->next = pages_;
+  if (nullptr != pages_) pages_->previous = page;
+  pages_ = page;
+  page->free_list = nullptr;
+  page->bump = reinterpret_cast<char *>(page) + kHeaderSize;
+  page->end = reinterpret_cast<char *>(page) + kPageSize;
+  page->live_count = 0;
+  page->capacity = (kPageSize - kHeaderSize) / node_size_;
+  page_count_++;
+
+  AddAvailable(page);
+}
+
+void NodePool::AddAvailable(Page *page) {
+  page->available = true;
+  page->previous_available = nullptr;
+  page->next_available = available_;
+  if (nullptr != available_) available_->previous_available = page;
+  available_ = page;
+}
+
+void NodePool::RemoveAvailable(Page *page) {
+  if (nullptr != page->previous_available) {
+    page->previous_available->next_available = page->next_available;
+  } else {
+    available_ = page->next_available;
+  }
+  if (nullptr != page->next_available) page->next_available->previous_available = page->previous_available;
+  page->previous_available = nullptr;
+  page->next_available = nullptr;
+  page->available = false;
+}
+
+void *NodePool::AllocateIn(Page *page) {
+  void *node = nullptr;
+  if (nullptr != page->free_list) {
+    node = page->free_list;
+    page->free_list = page->free_list->next;
+  } else {
+    node = page->bump;
+    page->bump += node_size_;
+  }
+
+  page->live_count++;
+  node_count_++;
+  if ((nullptr == page->free_list) && (page->bump + node_size_ > page->end)) RemoveAvailable(page);
+  return node;
+}
+
+void NodePool::FreeIn(Page *page, void *node) {
+  FreeNode *free_node = static_cast<FreeNode *>(node);
+  free_node->next = page->free_list;
+  page->free_list = free_node;
+
+  page->live_count--;
+  node_count_--;
+  if (!page->available) AddAvailable(page);
+}
+
+size_t NodePool::TrimLocked() {
+  size_t bytes = 0;
+  Page *page = pages_;
+  Page *next = nullptr;
+  while (nullptr != page) {
+    next = page->next;
+    if (0 == page->live_count) {
+      if (page->available) RemoveAvailable(page);
+      if (nullptr != page->previous) {
+        page->previous->next = page->next;
+      } else {
+        pages_ = page->next;
+      }
+      if (nullptr != page->next) page->next->previous = page->previous;
+
+      munmap(page, kPageSize);
+      page_count_--;
+      bytes += kPageSize;
+    }
+    page = next;
+  }
+  return bytes;
+}
+
+namespace {
+
+NodePool *GetBindingPool() {
+  static NodePool *pool = new NodePool(sizeof(TrackableBindingNode), &TrackableBindingNode::Relocate);
+  return pool;
+}
+
+NodePool **CreateTokenPools() {
+  NodePool **pools = new NodePool *[kTokenPoolCount];
+  for (size_t i = 0; i < kTokenPoolCount; i++) {
+    pools[i] = new NodePool((i + 1) * kTokenSizeStep);
+  }
+  return pools;
+}
+
+NodePool **GetTokenPools() {
+  static NodePool **pools = CreateTokenPools();
+  return pools;
+}
+
+}  // namespace
+
+void *AllocateTokenNode(size_t size) {
+  size_t index = (size + kTokenSizeStep - 1) / kTokenSizeStep - 1;
+  if (index >= kTokenPoolCount) return ::operator new(size);
+
+  return GetTokenPools()[index]->Allocate();
+}
+
+void *AllocateTokenNode(size_t size, NodePool *pool) {
+  if ((nullptr != pool) && ((size + kTokenSizeStep - 1) & ~(kTokenSizeStep - 1)) == pool->node_size()) {
+    return pool->Allocate();
+  }
+  return AllocateTokenNode(size);
+}
+
+void FreeTokenNode(void *node, size_t size) {
+  size_t index = (size + kTokenSizeStep - 1) / kTokenSizeStep - 1;
+  if (index >= kTokenPoolCount) {
+    ::operator delete(node);
+    return;
+  }
+
+  // The page knows its pool, which may be the block of a signal:
+  NodePool::Of(node)->Free(node);
+}
+
+void *AllocateBindingNode() {
+  return GetBindingPool()->Allocate();
+}
+
+void *AllocateBindingNode(NodePool *pool) {
+  return nullptr == pool ? AllocateBindingNode() : pool->Allocate();
+}
+
+void FreeBindingNode(void *node) {
+  NodePool::Of(node)->Free(node);
+}
+
+NodeBlock::NodeBlock(size_t token_size, size_t binding_size)
+    : tokens_(new NodePool((token_size + kTokenSizeStep - 1) & ~(kTokenSizeStep - 1))),
+      bindings_(new NodePool(binding_size)) {
+  _ASSERT(tokens_->node_size() <= kTokenSizeStep * kTokenPoolCount);
+}
+
+NodeBlock::~NodeBlock() {
+  tokens_->Release();
+  bindings_->Release();
+}
+
+NodeArenaStats NodeBlock::GetStats() const {
+  NodeArenaStats stats;
+  tokens_->AddStats(&stats);
+  bindings_->AddStats(&stats);
+  return stats;
+}
+
+void NodeReservation::AddTokens(size_t size, size_t count) {
+  size_t index = (size + kTokenSizeStep - 1) / kTokenSizeStep - 1;
+  if (index < kTokenPoolCount) token_counts_[index] += count;
+}
+
+size_t NodeReservation::Commit() {
+  NodePool **pools = GetTokenPools();
+  size_t token_pages[kTokenPoolCount];
+  size_t total = 0;
+
+  for (size_t i = 0; i < kTokenPoolCount; i++) {
+    token_pages[i] = 0 == token_counts_[i] ? 0 : pools[i]->CountMissingPages(token_counts_[i]);
+    total += token_pages[i];
+  }
+  size_t binding_pages = 0 == binding_count_ ? 0 : GetBindingPool()->CountMissingPages(binding_count_);
+  total += binding_pages;
+
+  if (0 == total) return 0;
+
+  char *memory = static_cast<char *>(NodePool::MapPages(total, true));
+  for (size_t i = 0; i < kTokenPoolCount; i++) {
+    if (0 == token_pages[i]) continue;
+    pools[i]->AddPages(memory, token_pages[i]);
+    memory += token_pages[i] * NodePool::kPageSize;
+  }
+  if (binding_pages > 0) GetBindingPool()->AddPages(memory, binding_pages);
+
+  return total;
+}
+
+} // namespace internal
+
+size_t NodeArena::Compact() {
+  size_t moved = internal::GetBindingPool()->Compact();
+
+  internal::NodePool **pools = internal::GetTokenPools();
+  for (size_t i = 0; i < internal::kTokenPoolCount; i++) pools[i]->Trim();
+
+  return moved;
+}
+
+size_t NodeArena::TrimMemory() {
+  size_t bytes = internal::GetBindingPool()->Trim();
+
+  internal::NodePool **pools = internal::GetTokenPools();
+  for (size_t i = 0; i < internal::kTokenPoolCount; i++) bytes += pools[i]->Trim();
+
+  return bytes;
+}
+
+NodeArenaStats NodeArena::GetStats() {
+  NodeArenaStats stats;
+  internal::GetBindingPool()->AddStats(&stats);
+
+  internal::NodePool **pools = internal::GetTokenPools();
+  for (size_t i = 0; i < internal::kTokenPoolCount; i++) pools[i]->AddStats(&stats);
+
+  return stats;
+}
+
+} // namespace sigcxx
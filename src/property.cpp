@@ -0,0 +1,60 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/property.hpp"
+
+namespace sigcxx {
+
+namespace {
+
+thread_local PropertyTransaction *current_transaction = nullptr;
+
+}  // namespace
+
+PropertyTransaction::PropertyTransaction()
+    : outer_(current_transaction) {
+  // A nested transaction joins the outermost one:
+  if (nullptr == outer_) current_transaction = this;
+}
+
+PropertyTransaction::~PropertyTransaction() {
+  if (nullptr != outer_) return;
+
+  // Still current during the commit, so properties changed by the slots are
+  // appended and notified in this loop, and destroyed ones cancel theirs:
+  for (size_t i = 0; i < entries_.size(); i++) {
+    Entry entry = entries_[i];
+    if (nullptr == entry.property) continue;
+
+    entries_[i].property = nullptr;
+    pending_count_--;
+    entry.notify(entry.property);
+  }
+
+  current_transaction = nullptr;
+}
+
+PropertyTransaction *PropertyTransaction::current() {
+  return current_transaction;
+}
+
+int PropertyTransaction::Enqueue(void *property, NotifyFunction notify) {
+  entries_.push_back(Entry{property, notify});
+  pending_count_++;
+  return static_cast<int>(entries_.size() - 1);
+}
+
+} // namespace sigcxx
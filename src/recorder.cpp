@@ -0,0 +1,277 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/recorder.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sigcxx {
+
+namespace {
+
+const uint32_t kLogMagic = 0x5349474c;  // "SIGL"
+const uint32_t kLogVersion = 1;
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  std::atomic<uint64_t> data_size;   // bytes of complete records following this header
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "The emission log requires lock-free 64-bit atomics");
+
+struct RecordHeader {
+  int64_t timestamp;    // nanoseconds since EmissionRecorder::Open()
+  uint32_t signal_id;
+  uint32_t size;        // payload size, the record is padded to 8 bytes
+};
+
+inline size_t RecordSize(size_t payload_size) {
+  return sizeof(RecordHeader) + ((payload_size + 7) & ~static_cast<size_t>(7));
+}
+
+/**
+ * @brief Returns the record at p if it fits before end, nullptr otherwise.
+ */
+inline const RecordHeader *GetRecord(const unsigned char *p, const unsigned char *end) {
+  size_t available = static_cast<size_t>(end - p);
+  if (available < sizeof(RecordHeader)) return nullptr;
+
+  auto *record = reinterpret_cast<const RecordHeader *>(p);
+  if (available < RecordSize(record->size)) return nullptr;
+  return record;
+}
+
+inline int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+// ----- EmissionRecorder -----
+
+EmissionRecorder::~EmissionRecorder() {
+  Close();
+}
+
+bool EmissionRecorder::Open(const char *path, size_t initial_size) {
+  Close();
+
+  fd_ = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) return false;
+
+  offset_ = sizeof(FileHeader);
+  record_count_ = 0;
+  if (!Grow(initial_size)) {
+    int error = errno;
+    close(fd_);
+    fd_ = -1;
+    errno = error;
+    return false;
+  }
+
+  // ftruncate() fills zero, construct the atomic in place:
+  auto *header = reinterpret_cast<FileHeader *>(base_);
+  header->magic = kLogMagic;
+  header->version = kLogVersion;
+  new(&header->data_size) std::atomic<uint64_t>(0);
+
+  start_time_ = Now();
+  return true;
+}
+
+void EmissionRecorder::Close() {
+  taps_.clear();
+
+  if (nullptr != base_) {
+    Commit();
+    munmap(base_, capacity_);
+    base_ = nullptr;
+  }
+
+  if (fd_ >= 0) {
+    if (0 != ftruncate(fd_, static_cast<off_t>(offset_))) {
+      _DEBUG("%s\n", "Fail to trim the emission log");
+    }
+    close(fd_);
+    fd_ = -1;
+  }
+
+  capacity_ = 0;
+  offset_ = 0;
+}
+
+void *EmissionRecorder::Append(uint32_t signal_id, size_t size) {
+  size_t record_size = RecordSize(size);
+
+  if (offset_ + record_size > capacity_) {
+    // Drop the record rather than crash in the emitting thread (e.g. not open):
+    if (!Grow(offset_ + record_size)) return nullptr;
+  }
+
+  auto *record = reinterpret_cast<RecordHeader *>(base_ + offset_);
+  record->timestamp = Now() - start_time_;
+  record->signal_id = signal_id;
+  record->size = static_cast<uint32_t>(size);
+
+  offset_ += record_size;
+  ++record_count_;
+  return record + 1;
+}
+
+void EmissionRecorder::Commit() {
+  // The payload of the last record is written, a reader of a crashed process's log sees it:
+  reinterpret_cast<FileHeader *>(base_)->data_size.store(offset_ - sizeof(FileHeader),
+                                                          std::memory_order_release);
+}
+
+bool EmissionRecorder::Grow(size_t required) {
+  size_t capacity = capacity_ > 0 ? capacity_ : 4096;
+  while (capacity < required) capacity *= 2;
+
+  if (0 != ftruncate(fd_, static_cast<off_t>(capacity))) return false;
+
+  void *addr = nullptr;
+  if (nullptr == base_) {
+    addr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  } else {
+#ifdef __linux__
+    addr = mremap(base_, capacity_, capacity, MREMAP_MAYMOVE);
+#else
+    munmap(base_, capacity_);
+    base_ = nullptr;
+    capacity_ = 0;
+    addr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+  }
+
+  if (MAP_FAILED == addr) return false;
+
+  base_ = static_cast<unsigned char *>(addr);
+  capacity_ = capacity;
+  return true;
+}
+
+// ----- EmissionReplayer -----
+
+EmissionReplayer::~EmissionReplayer() {
+  Close();
+}
+
+bool EmissionReplayer::Open(const char *path) {
+  Close();
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (0 != fstat(fd, &st) || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+    close(fd);
+    errno = EINVAL;
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (MAP_FAILED == addr) return false;
+
+  // Read the data size once, the recorder may still be appending:
+  auto *header = static_cast<const FileHeader *>(addr);
+  uint64_t data_size = header->data_size.load(std::memory_order_acquire);
+  if (kLogMagic != header->magic || kLogVersion != header->version ||
+      data_size > size - sizeof(FileHeader)) {
+    munmap(addr, size);
+    errno = EINVAL;
+    return false;
+  }
+
+  base_ = static_cast<const unsigned char *>(addr);
+  size_ = size;
+  data_size_ = static_cast<size_t>(data_size);
+  return true;
+}
+
+void EmissionReplayer::Close() {
+  if (nullptr != base_) {
+    munmap(const_cast<unsigned char *>(base_), size_);
+    base_ = nullptr;
+    size_ = 0;
+    data_size_ = 0;
+  }
+}
+
+size_t EmissionReplayer::Replay(Speed speed) {
+  if (nullptr == base_) return 0;
+
+  const unsigned char *p = base_ + sizeof(FileHeader);
+  const unsigned char *end = p + data_size_;
+  auto start = std::chrono::steady_clock::now();
+  size_t count = 0;
+
+  const RecordHeader *record = nullptr;
+  while (nullptr != (record = GetRecord(p, end))) {
+    p += RecordSize(record->size);
+
+    auto it = channels_.find(record->signal_id);
+    if (it == channels_.end()) continue;
+    internal::ReplayChannelBase *channel = it->second.get();
+
+    if (channel->size() != record->size) {
+      _DEBUG("Size of signal %u does not match the record\n", record->signal_id);
+      continue;
+    }
+
+    if (kOriginalSpeed == speed) {
+      std::this_thread::sleep_until(start + std::chrono::nanoseconds(record->timestamp));
+    }
+
+    channel->Emit(record + 1);
+    ++count;
+  }
+
+  if (p != end) _DEBUG("%s\n", "Stop replaying at a truncated record");
+  return count;
+}
+
+size_t EmissionReplayer::CountRecords() const {
+  if (nullptr == base_) return 0;
+
+  const unsigned char *p = base_ + sizeof(FileHeader);
+  const unsigned char *end = p + data_size_;
+  size_t count = 0;
+
+  const RecordHeader *record = nullptr;
+  while (nullptr != (record = GetRecord(p, end))) {
+    p += RecordSize(record->size);
+    ++count;
+  }
+
+  return count;
+}
+
+} // namespace sigcxx
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/selector.hpp"
+
+#include <cerrno>
+#include <chrono>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace sigcxx {
+
+using internal::SelectorBlock;
+
+namespace {
+
+inline int LowestBit(uint64_t bits) {
+  return __builtin_ctzll(bits);
+}
+
+/**
+ * @brief Clear a bit in the summary unless the word has been set again.
+ */
+inline void ClearSummary(SelectorBlock *block, int word) {
+  uint64_t mask = uint64_t(1) << word;
+  block->summary.fetch_and(~mask);
+  // A bit set before the summary was cleared would be lost, mark it again:
+  if (0 != block->words[word].load()) block->summary.fetch_or(mask);
+}
+
+}  // namespace
+
+SignalSelector::SignalSelector(bool blocking) {
+  signaled_.store(false);
+  if (!blocking) return;
+
+#ifdef __linux__
+  event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+  int fds[2];
+  if (0 == pipe(fds)) {
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    event_fd_ = fds[0];
+    write_fd_ = fds[1];
+  }
+#endif
+
+  if (event_fd_ < 0) {
+    _DEBUG("%s\n", "Fail to create the event fd of SignalSelector");
+  }
+}
+
+SignalSelector::~SignalSelector() {
+  Clear();
+  if (write_fd_ >= 0) close(write_fd_);
+  if (event_fd_ >= 0) close(event_fd_);
+}
+
+void SignalSelector::Remove(int index) {
+  if (index < 0 || static_cast<size_t>(index) >= watches_.size() || !watches_[index]) return;
+
+  watches_[index].reset();
+  blocks_[index / SelectorBlock::kCapacity]->Clear(index % SelectorBlock::kCapacity);
+  free_indices_.push_back(index);
+  --watch_count_;
+}
+
+void SignalSelector::Clear() {
+  watches_.clear();
+  blocks_.clear();
+  free_indices_.clear();
+  watch_count_ = 0;
+}
+
+bool SignalSelector::Poll() const {
+  for (const auto &block : blocks_) {
+    uint64_t summary = block->summary.load();
+    while (0 != summary) {
+      if (0 != block->words[LowestBit(summary)].load()) return true;
+      summary &= summary - 1;
+    }
+  }
+  return false;
+}
+
+bool SignalSelector::IsReady(int index) const {
+  if (index < 0 || static_cast<size_t>(index) >= watches_.size()) return false;
+  return blocks_[index / SelectorBlock::kCapacity]->Test(index % SelectorBlock::kCapacity);
+}
+
+int SignalSelector::Take() {
+  DrainEventFd();
+
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    SelectorBlock *block = blocks_[i].get();
+    uint64_t summary = block->summary.load();
+
+    while (0 != summary) {
+      int w = LowestBit(summary);
+      summary &= summary - 1;
+
+      uint64_t word = block->words[w].load();
+      while (0 != word) {
+        uint64_t mask = word & (~word + 1);   // the lowest bit
+        uint64_t prev = block->words[w].fetch_and(~mask);
+        if (0 != (prev & mask)) {
+          if (0 == (prev & ~mask)) ClearSummary(block, w);
+          return static_cast<int>(i * SelectorBlock::kCapacity) + w * 64 + LowestBit(mask);
+        }
+        word = prev & ~mask;  // taken in another thread, try the next bit
+      }
+
+      ClearSummary(block, w);
+    }
+  }
+
+  return -1;
+}
+
+size_t SignalSelector::TakeAll(std::vector<int> *indices) {
+  DrainEventFd();
+
+  size_t count = 0;
+  for (size_t i = 0; i < blocks_.size(); i++) {
+    SelectorBlock *block = blocks_[i].get();
+    uint64_t summary = block->summary.load();
+
+    while (0 != summary) {
+      int w = LowestBit(summary);
+      summary &= summary - 1;
+
+      uint64_t word = block->words[w].exchange(0);
+      ClearSummary(block, w);
+
+      int base = static_cast<int>(i * SelectorBlock::kCapacity) + w * 64;
+      while (0 != word) {
+        indices->push_back(base + LowestBit(word));
+        word &= word - 1;
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+int SignalSelector::Wait(int timeout_ms) {
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+  int index = Take();
+  while (index < 0) {
+    if (event_fd_ < 0) return -1;
+
+    int timeout = -1;
+    if (timeout_ms >= 0) {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+      timeout = remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = event_fd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ret = poll(&pfd, 1, timeout);
+    if (ret < 0 && EINTR != errno) return -1;
+
+    index = Take();
+    if (0 == ret && index < 0) return -1;
+  }
+
+  return index;
+}
+
+int SignalSelector::Allocate(SelectorBlock **block, int *bit) {
+  int index = 0;
+  if (!free_indices_.empty()) {
+    index = free_indices_.back();
+    free_indices_.pop_back();
+  } else {
+    index = static_cast<int>(watches_.size());
+    watches_.emplace_back();
+    if (static_cast<size_t>(index / SelectorBlock::kCapacity) >= blocks_.size()) {
+      blocks_.emplace_back(new SelectorBlock);
+    }
+  }
+
+  *block = blocks_[index / SelectorBlock::kCapacity].get();
+  *bit = index % SelectorBlock::kCapacity;
+  (*block)->Clear(*bit);
+  ++watch_count_;
+  return index;
+}
+
+void SignalSelector::WakeUp() {
+#ifdef __linux__
+  uint64_t value = 1;
+  ssize_t ret = write(event_fd_, &value, sizeof(value));
+#else
+  char value = 1;
+  ssize_t ret = write(write_fd_, &value, sizeof(value));
+#endif
+  (void) ret;   // the fd is already readable if the write would block
+}
+
+void SignalSelector::DrainEventFd() {
+  if ((event_fd_ < 0) || !signaled_.load()) return;
+
+  // Reset the flag after the fd is read and before the bits are scanned, so
+  // an emission after this point always writes the fd again. If the write of
+  // the last emission is still on the way, the flag is kept for the next call:
+#ifdef __linux__
+  uint64_t value = 0;
+  if (read(event_fd_, &value, sizeof(value)) > 0) signaled_.store(false);
+#else
+  char buffer[64];
+  bool drained = false;
+  while (read(event_fd_, buffer, sizeof(buffer)) > 0) drained = true;
+  if (drained) signaled_.store(false);
+#endif
+}
+
+} // namespace sigcxx
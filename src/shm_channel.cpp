@@ -0,0 +1,236 @@
+/*
+ * Copyright 2017 - 2018 The WizTK Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sigcxx/shm_channel.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sigcxx {
+
+namespace {
+
+const uint32_t kShmRingMagic = 0x53494752;  // "SIGR"
+const uint32_t kShmRingVersion = 1;
+const size_t kCacheLineSize = 64;
+
+inline size_t RoundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+struct SlotHeader {
+  std::atomic<uint64_t> version;
+};
+
+}  // namespace
+
+struct ShmRing::Header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+  uint64_t payload_size;
+  uint64_t stride;
+  alignas(kCacheLineSize) std::atomic<uint64_t> sequence;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "ShmRing requires lock-free 64-bit atomics");
+
+ShmRing::~ShmRing() {
+  Close();
+}
+
+bool ShmRing::Create(const char *name, size_t capacity, size_t payload_size) {
+  Close();
+
+  size_t n = 1;
+  while (n < capacity) n <<= 1;
+
+  size_t stride = RoundUp(sizeof(SlotHeader) + payload_size, kCacheLineSize);
+  size_t size = RoundUp(sizeof(Header), kCacheLineSize) + n * stride;
+
+  // Fails with EEXIST rather than replace a ring in use:
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) return false;
+
+  if (0 != ftruncate(fd, static_cast<off_t>(size))) {
+    int error = errno;
+    close(fd);
+    shm_unlink(name);
+    errno = error;
+    return false;
+  }
+
+  void *addr = Map(fd, size);
+  if (nullptr == addr) {
+    shm_unlink(name);
+    return false;
+  }
+
+  capacity_ = n;
+  stride_ = stride;
+  mapped_size_ = size;
+
+  // ftruncate() fills zero, construct the atomics in place:
+  header_ = new(addr) Header;
+  header_->capacity = n;
+  header_->payload_size = payload_size;
+  header_->stride = stride;
+  new(&header_->sequence) std::atomic<uint64_t>(0);
+  for (size_t i = 0; i < n; i++) {
+    new(SlotAt(i)) SlotHeader{{0}};
+  }
+  header_->version = kShmRingVersion;
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kShmRingMagic;
+
+  name_ = strdup(name);
+  return true;
+}
+
+bool ShmRing::Unlink(const char *name) {
+  return 0 == shm_unlink(name);
+}
+
+bool ShmRing::Open(const char *name, size_t payload_size) {
+  Close();
+
+  int fd = shm_open(name, O_RDWR, 0600);
+  if (fd < 0) return false;
+
+  const size_t slots_offset = RoundUp(sizeof(Header), kCacheLineSize);
+  struct stat st;
+  if (0 != fstat(fd, &st) || static_cast<size_t>(st.st_size) < slots_offset) {
+    close(fd);
+    errno = EINVAL;
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  void *addr = Map(fd, size);
+  if (nullptr == addr) return false;
+
+  // Don't trust the header, the slots must fit in the mapped size:
+  auto *header = static_cast<Header *>(addr);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t capacity = header->capacity;
+  uint64_t stride = header->stride;
+  if (kShmRingMagic != header->magic || kShmRingVersion != header->version ||
+      payload_size != header->payload_size ||
+      0 == capacity || 0 != (capacity & (capacity - 1)) ||
+      stride < sizeof(SlotHeader) + payload_size || 0 != stride % alignof(SlotHeader) ||
+      capacity > (size - slots_offset) / stride) {
+    munmap(addr, size);
+    errno = EINVAL;
+    return false;
+  }
+
+  header_ = header;
+  capacity_ = capacity;
+  stride_ = stride;
+  mapped_size_ = size;
+  return true;
+}
+
+void ShmRing::Close() {
+  if (nullptr != header_) {
+    munmap(header_, mapped_size_);
+    header_ = nullptr;
+  }
+
+  if (nullptr != name_) {
+    shm_unlink(name_);
+    free(name_);
+    name_ = nullptr;
+  }
+
+  mapped_size_ = 0;
+  capacity_ = 0;
+  stride_ = 0;
+}
+
+void *ShmRing::BeginWrite() {
+  _ASSERT(nullptr != header_ && nullptr != name_);
+  uint64_t sequence = header_->sequence.load(std::memory_order_relaxed) + 1;
+  auto *slot = reinterpret_cast<SlotHeader *>(SlotAt(sequence));
+
+  slot->version.store(sequence * 2 - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  return slot + 1;
+}
+
+void ShmRing::EndWrite() {
+  uint64_t sequence = header_->sequence.load(std::memory_order_relaxed) + 1;
+  auto *slot = reinterpret_cast<SlotHeader *>(SlotAt(sequence));
+
+  slot->version.store(sequence * 2, std::memory_order_release);
+  header_->sequence.store(sequence, std::memory_order_release);
+}
+
+ShmRing::ReadResult ShmRing::BeginRead(uint64_t sequence, const void **payload) const {
+  _ASSERT(nullptr != header_);
+  auto *slot = reinterpret_cast<const SlotHeader *>(SlotAt(sequence));
+  uint64_t version = slot->version.load(std::memory_order_acquire);
+
+  if (version < sequence * 2) return kReadEmpty;
+  if (version > sequence * 2) return kReadOverrun;
+
+  *payload = slot + 1;
+  return kReadReady;
+}
+
+bool ShmRing::EndRead(uint64_t sequence) const {
+  auto *slot = reinterpret_cast<const SlotHeader *>(SlotAt(sequence));
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->version.load(std::memory_order_relaxed) == sequence * 2;
+}
+
+uint64_t ShmRing::sequence() const {
+  return header_->sequence.load(std::memory_order_acquire);
+}
+
+uint64_t ShmRing::oldest_sequence() const {
+  uint64_t last = sequence();
+  return last > capacity_ ? last - capacity_ + 1 : 1;
+}
+
+void *ShmRing::Map(int fd, size_t size) {
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int error = errno;
+  close(fd);
+
+  if (MAP_FAILED == addr) {
+    errno = error;
+    return nullptr;
+  }
+  return addr;
+}
+
+unsigned char *ShmRing::SlotAt(uint64_t sequence) const {
+  return reinterpret_cast<unsigned char *>(header_) + RoundUp(sizeof(Header), kCacheLineSize) +
+      (sequence & (capacity_ - 1)) * stride_;
+}
+
+} // namespace sigcxx
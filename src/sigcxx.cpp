@@ -15,33 +15,177 @@
  */
 
 #include "sigcxx/sigcxx.hpp"
+#include "sigcxx/node_arena.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 
 namespace sigcxx {
 
 namespace internal {
 
+namespace {
+
+/**
+ * @brief A mutex and condition variable shared by the latches hashed to it.
+ *
+ * A latch only needs them when a thread blocks on it, so they're not stored
+ * in each latch.
+ */
+struct ParkingBucket {
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+ParkingBucket *GetParkingBucket(const void *address) {
+  static ParkingBucket buckets[16];
+  return &buckets[(reinterpret_cast<uintptr_t>(address) >> 4) % 16];
+}
+
+}  // namespace
+
+bool EmitLatch::Wait(int timeout_ms) {
+  if (IsDone()) return true;
+
+  ParkingBucket *bucket = GetParkingBucket(this);
+  // CountDown() checks this flag after the pending count reaches 0:
+  waiting_.store(true);
+
+  std::unique_lock<std::mutex> lock(bucket->mutex);
+  if (timeout_ms < 0) {
+    bucket->condition.wait(lock, [this]() { return IsDone(); });
+    return true;
+  }
+
+  return bucket->condition.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                    [this]() { return IsDone(); });
+}
+
+void EmitLatch::WakeUp() {
+  ParkingBucket *bucket = GetParkingBucket(this);
+  {
+    // Lock so a waiter cannot miss the notification between its check and wait:
+    std::lock_guard<std::mutex> lock(bucket->mutex);
+  }
+  bucket->condition.notify_all();
+}
+
+void *TrackableBindingNode::operator new(size_t size) {
+  _ASSERT(sizeof(TrackableBindingNode) == size);
+  return AllocateBindingNode();
+}
+
+void *TrackableBindingNode::operator new(size_t size, NodePool *pool) {
+  _ASSERT(sizeof(TrackableBindingNode) == size);
+  return AllocateBindingNode(pool);
+}
+
+void TrackableBindingNode::operator delete(void *node) {
+  FreeBindingNode(node);
+}
+
+void TrackableBindingNode::operator delete(void *node, NodePool * /* pool */) {
+  FreeBindingNode(node);
+}
+
+void TrackableBindingNode::Relocate(void *from, void *to) {
+  TrackableBindingNode *old = static_cast<TrackableBindingNode *>(from);
+  TrackableBindingNode *binding = ::new(to) TrackableBindingNode;
+
+  _ASSERT(old->is_linked() && (nullptr != old->token));
+  old->push_back(binding);
+  old->unlink();
+  binding->trackable = old->trackable;
+  binding->token = old->token;
+  binding->token->binding = binding;
+
+  // Destroy the old one without disposing anything:
+  old->token = nullptr;
+  old->~TrackableBindingNode();
+}
+
+uint64_t NewFunctionConnectionId() {
+  // Connected in any thread, only unique:
+  static std::atomic<uint64_t> next_id(1);
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+TrackableBindingNode *TrackableBindingNode::Unbound() {
+  // Never destroyed, the tokens of signals destroyed at exit still compare to it:
+  static TrackableBindingNode *binding = ::new TrackableBindingNode;
+  return binding;
+}
+
 TrackableBindingNode::~TrackableBindingNode() {
   if (nullptr != token) {
     _ASSERT(token->binding == this);
     token->binding = nullptr;
-    delete token;
+    token->Dispose();
   }
 }
 
+void *SignalTokenNode::operator new(size_t size) {
+  return AllocateTokenNode(size);
+}
+
+void *SignalTokenNode::operator new(size_t size, NodePool *pool) {
+  // Only used for small tokens, so the placement delete below finds the page:
+  _ASSERT(size <= kTokenSizeStep * kTokenPoolCount);
+  return AllocateTokenNode(size, pool);
+}
+
+void SignalTokenNode::operator delete(void *node, size_t size) {
+  FreeTokenNode(node, size);
+}
+
+void SignalTokenNode::operator delete(void *node, NodePool * /* pool */) {
+  NodePool::Of(node)->Free(node);
+}
+
 SignalTokenNode::~SignalTokenNode() {
   _ASSERT(nullptr == slot_mark_head.previous());
+
+  // The next token, or nullptr if this is the last one:
+  InterRelatedDeque<SignalTokenNode>::Iterator next_it(next_);
+  SignalTokenNode *next_token = next_it ? next_it.get() : nullptr;
+
+  // Move the emitting slots to the next token, so they still follow if it's
+  // deleted too. After the last token, the slot stops without touching the
+  // end point, as the signal may be destroyed right after:
+  MoveSlotMarks(next_token);
+
+  if ((nullptr != binding) && (TrackableBindingNode::Unbound() != binding)) {
+    _ASSERT(binding->token == this);
+    // The receiver loses a binding:
+    _ASSERT((nullptr == binding->trackable) || binding->trackable->IsOnOwnerThread());
+    binding->token = nullptr;
+    delete binding;
+  }
+}
+
+void SignalTokenNode::MoveSlotMarks(SignalTokenNode *next_token) {
   Slot::Mark *mark = nullptr;
   while (nullptr != slot_mark_head.next()) {
     mark = static_cast<Slot::Mark *>(slot_mark_head.next());
-    ++mark->slot()->it_;
-    ++mark->slot()->ref_count_;
-    mark->unlink();
+    if (nullptr != next_token) {
+      next_token->slot_mark_head.push_back(mark);
+    } else {
+      mark->unlink();
+    }
+    mark->slot()->it_ = Slot::IteratorType(next_token);
+    mark->slot()->ref_count_ = 1;
   }
 
-  if (nullptr != binding) {
-    _ASSERT(binding->token == this);
-    binding->token = nullptr;
-    delete binding;
+  // The emissions of signals in this thread are not marked, there are only a
+  // few nested ones to check:
+  const Slot::IteratorType it(this);
+  for (Slot *slot = Slot::innermost(); nullptr != slot; slot = slot->outer_) {
+    if (slot->it_ == it) {
+      slot->it_ = Slot::IteratorType(next_token);
+      slot->ref_count_ = 1;
+    }
   }
 }
 
@@ -51,14 +195,21 @@ Trackable::Trackable(const Trackable &)
     : Trackable() {}
 
 Trackable::~Trackable() {
-  UnbindAllSignals();
+  TrackableTeardownScope *scope = TrackableTeardownScope::current();
+  if (nullptr == scope) {
+    UnbindAllSignals();
+  } else {
+    scope->Defer(this);
+  }
 }
 
 void Trackable::UnbindSignal(SLOT slot) {
   using internal::SignalTokenNode;
 
-  if (slot->it_.get()->binding->trackable == this) {
-    SignalTokenNode *tmp = slot->it_.get();
+  _ASSERT(IsOnOwnerThread());
+
+  SignalTokenNode *tmp = slot->it_.get();
+  if ((nullptr != tmp) && (nullptr != tmp->binding) && (tmp->binding->trackable == this)) {
     delete tmp;
   }
 }
@@ -66,6 +217,8 @@ void Trackable::UnbindSignal(SLOT slot) {
 void Trackable::UnbindAllSignals() {
   internal::TrackableBindingNode *tmp = nullptr;
 
+  _ASSERT(IsOnOwnerThread());
+
   internal::InterRelatedDeque<internal::TrackableBindingNode>::ReverseIterator it = bindings_.rbegin();
   while (it) {
     tmp = it.get();
@@ -84,4 +237,117 @@ size_t Trackable::CountSignalBindings() const {
 
 // ------
 
+namespace {
+
+thread_local TrackableTeardownScope *current_scope = nullptr;
+
+}  // namespace
+
+TrackableTeardownScope::TrackableTeardownScope()
+    : outer_(current_scope) {
+  // A nested scope joins the outermost one:
+  if (nullptr == outer_) current_scope = this;
+}
+
+TrackableTeardownScope::~TrackableTeardownScope() {
+  using internal::TrackableBindingNode;
+  using internal::SignalTokenNode;
+
+  if (nullptr != outer_) return;
+
+  // Trackable objects destroyed from now on unbind themselves again:
+  current_scope = nullptr;
+
+  // Each delete unlinks the token from its signal, the next token in the
+  // signal is usually far away in memory, fetch it ahead:
+  TrackableBindingNode *ahead = first_;
+  for (int i = 0; (i < 16) && (nullptr != ahead); i++) {
+    ahead = static_cast<TrackableBindingNode *>(ahead->next());
+  }
+
+  TrackableBindingNode *binding = first_;
+  TrackableBindingNode *next = nullptr;
+  SignalTokenNode *token = nullptr;
+  while (nullptr != binding) {
+    if (nullptr != ahead) {
+      WIZTK_PREFETCH(ahead->token->next_);
+      ahead = static_cast<TrackableBindingNode *>(ahead->next());
+    }
+
+    next = static_cast<TrackableBindingNode *>(binding->next());
+    token = binding->token;
+    binding->token = nullptr;
+    binding->Detach();
+    delete binding;
+    token->Dispose();
+    binding = next;
+  }
+}
+
+TrackableTeardownScope *TrackableTeardownScope::current() {
+  return current_scope;
+}
+
+void TrackableTeardownScope::Defer(Trackable *trackable) {
+  using internal::TrackableBindingNode;
+  using internal::SignalTokenNode;
+
+  _ASSERT(trackable->IsOnOwnerThread());
+
+  TrackableBindingNode *binding = nullptr;
+  SignalTokenNode *token = nullptr;
+
+  auto it = trackable->bindings_.begin();
+  while (it != trackable->bindings_.end()) {
+    binding = it.get();
+    ++it;
+
+    // The whole list is dropped at once, don't unlink the binding:
+    binding->Detach();
+    binding->trackable = nullptr;
+
+    token = binding->token;
+    token->binding = nullptr;
+
+    if (nullptr == token->trackable) {
+      // Not in a Signal, let it go now:
+      binding->token = nullptr;
+      token->Dispose();
+      delete binding;
+      continue;
+    }
+
+    // A dead token stays in the signal, and the binding keeps it in a list in
+    // the order the receivers are destroyed:
+    if (nullptr == last_) {
+      first_ = binding;
+    } else {
+      last_->push_back(binding);
+    }
+    last_ = binding;
+    ++pending_count_;
+  }
+
+  trackable->bindings_.reset();
+}
+
+void TrackableTeardownScope::DetachDeadTokens(internal::InterRelatedDeque<internal::SignalTokenNode> *tokens) {
+  using internal::SignalTokenNode;
+
+  // Dead tokens only exist in a scope:
+  if (nullptr == current_scope) return;
+
+  SignalTokenNode *token = nullptr;
+  auto it = tokens->begin();
+  while (it != tokens->end()) {
+    token = it.get();
+    ++it;
+
+    if (nullptr == token->binding) {
+      token->MoveSlotMarks(nullptr);
+      token->unlink();
+    }
+  }
+}
+
 } // namespace sigcxx
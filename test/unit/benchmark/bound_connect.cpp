@@ -0,0 +1,152 @@
+// Benchmark code for connections with bound arguments
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::SLOT;
+
+namespace {
+
+class Table: public sigcxx::Trackable
+{
+ public:
+
+  Table ()
+      : count_(0)
+  { }
+
+  virtual ~Table () { }
+
+  void OnCellChanged (int row, int value, __SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
+
+// The workaround without bound arguments, a helper object per connection:
+class RowForwarder: public sigcxx::Trackable
+{
+ public:
+
+  RowForwarder (Table *table, int row)
+      : table_(table), row_(row)
+  { }
+
+  void OnValue (int value, __SLOT__)
+  {
+    table_->OnCellChanged(row_, value, slot);
+  }
+
+ private:
+
+  Table *table_;
+  int row_;
+};
+
+// Or a token calling a lambda in a std::function:
+class FunctionToken: public sigcxx::internal::CallableToken<int, SLOT>
+{
+ public:
+
+  explicit FunctionToken (const std::function<void(int, SLOT)> &function)
+      : function_(function)
+  { }
+
+  void Invoke (int value, SLOT slot) final
+  {
+    function_(value, slot);
+  }
+
+ private:
+
+  std::function<void(int, SLOT)> function_;
+};
+
+template<typename F>
+long Measure(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
+/*
+ * Connect and emit with bound arguments versus the helper workarounds
+ */
+TEST_F(Test, bound_connect)
+{
+  const int count = 200000;
+  const int rounds = 10;
+
+  typedef std::function<void(Signal<int> *, Table *, int)> ConnectFunction;
+
+  // Returns the time to connect and the time to emit:
+  auto run = [](const ConnectFunction &connect) {
+    Table table;
+    std::unique_ptr<Signal<int>[]> signals(new Signal<int>[count]);
+
+    long connect_time = Measure([&]() {
+      for (int i = 0; i < count; i++) connect(&signals[i], &table, i);
+    });
+    long emit_time = Measure([&]() {
+      for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) signals[i](r);
+      }
+    });
+    EXPECT_TRUE(table.count() == count * rounds);
+
+    return std::make_pair(connect_time, emit_time);
+  };
+
+  std::vector<std::unique_ptr<RowForwarder> > forwarders;
+  forwarders.reserve(count);
+
+  const char *names[] = {"Bound arguments", "Helper Trackable", "Lambda in a std::function"};
+  ConnectFunction connects[] = {
+      [](Signal<int> *signal, Table *table, int row) {
+        signal->Connect(table, &Table::OnCellChanged, row);
+      },
+      [&forwarders](Signal<int> *signal, Table *table, int row) {
+        forwarders.emplace_back(new RowForwarder(table, row));
+        signal->Connect(forwarders.back().get(), &RowForwarder::OnValue);
+      },
+      [](Signal<int> *signal, Table *table, int row) {
+        signal->Connect(new FunctionToken([table, row](int value, SLOT slot) {
+          table->OnCellChanged(row, value, slot);
+        }), table);
+      }
+  };
+
+  // Interleaved, and the best of 3, as the state of the heap changes the results a lot:
+  std::pair<long, long> best[3];
+  for (int n = 0; n < 3; n++) {
+    for (int k = 0; k < 3; k++) {
+      std::pair<long, long> result = run(connects[k]);
+      forwarders.clear();
+      if ((0 == n) || (result.first < best[k].first)) best[k].first = result.first;
+      if ((0 == n) || (result.second < best[k].second)) best[k].second = result.second;
+    }
+  }
+
+  for (int k = 0; k < 3; k++) {
+    std::cout << names[k] << ": " << count << " connections " << best[k].first << " us, "
+              << count * rounds << " emissions " << best[k].second << " us" << std::endl;
+  }
+}
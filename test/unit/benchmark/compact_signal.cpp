@@ -0,0 +1,127 @@
+// Benchmark code for CompactSignal
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/compact_signal.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+using sigcxx::CompactSignal;
+using sigcxx::CompactArenaStats;
+using sigcxx::internal::CompactArena;
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+using sigcxx::NodeArenaStats;
+
+namespace {
+
+class Receiver: public sigcxx::CompactTrackable
+{
+ public:
+
+  Receiver ()
+      : sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n)
+  {
+    sum_ += n;
+  }
+
+  int sum () const { return sum_; }
+
+ private:
+
+  int sum_;
+};
+
+class SignalReceiver: public sigcxx::Trackable
+{
+ public:
+
+  SignalReceiver ()
+      : sum_(0)
+  { }
+
+  virtual ~SignalReceiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    sum_ += n;
+  }
+
+  int sum () const { return sum_; }
+
+ private:
+
+  int sum_;
+};
+
+}  // namespace
+
+/*
+ * Memory and emission of 10M connections, 10 signals x 1M receivers, with Signal and CompactSignal
+ */
+TEST_F(Test, compact_signal)
+{
+  const size_t signal_count = 10;
+  const size_t receiver_count = 1000000;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best_signal = Clock::duration::max();
+  Clock::duration best_compact = Clock::duration::max();
+  size_t signal_bytes = 0;
+  size_t compact_bytes = 0;
+
+  {
+    std::unique_ptr<SignalReceiver[]> receivers(new SignalReceiver[receiver_count]);
+    std::unique_ptr<Signal<int>[]> signals(new Signal<int>[signal_count]);
+
+    NodeArenaStats before = NodeArena::GetStats();
+    for (size_t i = 0; i < signal_count; i++) {
+      for (size_t j = 0; j < receiver_count; j++) signals[i].Connect(&receivers[j], &SignalReceiver::OnValue);
+    }
+    NodeArenaStats after = NodeArena::GetStats();
+    signal_bytes = after.reserved_bytes - before.reserved_bytes;
+
+    for (int k = 0; k < 3; k++) {
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < signal_count; i++) signals[i].Emit(1);
+      best_signal = std::min(best_signal, Clock::now() - start);
+    }
+    ASSERT_TRUE(receivers[receiver_count - 1].sum() == 30);
+  }
+  NodeArena::TrimMemory();
+
+  {
+    std::unique_ptr<Receiver[]> receivers(new Receiver[receiver_count]);
+    std::unique_ptr<CompactSignal<int>[]> signals(new CompactSignal<int>[signal_count]);
+
+    CompactArenaStats before = CompactArena::GetStats();
+    for (size_t i = 0; i < signal_count; i++) {
+      for (size_t j = 0; j < receiver_count; j++) signals[i].Connect(&receivers[j], &Receiver::OnValue);
+    }
+    CompactArenaStats after = CompactArena::GetStats();
+    compact_bytes = after.used_bytes - before.used_bytes;
+
+    for (int k = 0; k < 3; k++) {
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < signal_count; i++) signals[i].Emit(1);
+      best_compact = std::min(best_compact, Clock::now() - start);
+    }
+    ASSERT_TRUE(receivers[receiver_count - 1].sum() == 30);
+  }
+
+  ASSERT_TRUE(compact_bytes < signal_bytes);
+
+  size_t connections = signal_count * receiver_count;
+  std::cout << "Signal: " << connections << " connections in " << (signal_bytes >> 20) << " MB, emit: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(best_signal).count() << " ms" << std::endl;
+  std::cout << "CompactSignal: " << connections << " connections in " << (compact_bytes >> 20) << " MB, emit: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(best_compact).count() << " ms" << std::endl;
+}
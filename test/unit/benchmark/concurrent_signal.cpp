@@ -0,0 +1,112 @@
+// Benchmark code for ConcurrentSignal
+
+#include "test.hpp"
+
+#include <sigcxx/concurrent_signal.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::ConcurrentSignal;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_.load(); }
+
+ private:
+
+  std::atomic<int> count_;
+};
+
+}  // namespace
+
+/*
+ * ConcurrentSignal compared with a global mutex around Signal::Emit() as in test/unit/thread_safe
+ */
+TEST_F(Test, concurrent_signal)
+{
+  const int threads = 4;
+  const int count = 200000;
+
+  Signal<int> signal;
+  ConcurrentSignal<int> concurrent;
+  Receiver receivers[8];
+  std::mutex mutex;
+
+  for (auto &r : receivers) {
+    signal.Connect(&r, &Receiver::OnValue);
+    concurrent.Connect(&r, &Receiver::OnValue);
+  }
+
+  auto run = [](std::function<void()> emit) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < threads; i++) {
+      workers.emplace_back([&emit]() {
+        for (int j = 0; j < count; j++) emit();
+      });
+    }
+    for (auto &t : workers) t.join();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  auto locked = run([&signal, &mutex]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    signal.Emit(1);
+  });
+
+  auto lock_free = run([&concurrent]() {
+    concurrent.Emit(1);
+  });
+
+  std::cout << threads << " threads x " << count << " emissions to 8 receivers: "
+            << locked << " us with a global mutex, "
+            << lock_free << " us with ConcurrentSignal" << std::endl;
+
+  ASSERT_TRUE(receivers[0].count() == 2 * threads * count);
+}
+
+/*
+ * Emissions in one thread, on the thread-safe path and confined with SetThreadAffinity()
+ */
+TEST_F(Test, concurrent_signal_confined)
+{
+  const int count = 1000000;
+  ConcurrentSignal<int> signal;
+  Receiver receiver;
+  signal.Connect(&receiver, &Receiver::OnValue);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) signal.Emit(1);
+  auto shared = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  signal.SetThreadAffinity();
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) signal.Emit(1);
+  auto confined = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << count << " emissions in one thread: " << shared << " us thread-safe, "
+            << confined << " us confined" << std::endl;
+  ASSERT_TRUE(receiver.count() == 2 * count);
+}
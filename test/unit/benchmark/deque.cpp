@@ -0,0 +1,131 @@
+// Benchmark code for Deque and CountedDeque
+
+#include "test.hpp"
+
+#include <sigcxx/binode.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+
+using sigcxx::Deque;
+using sigcxx::CountedDeque;
+
+namespace {
+
+class Node: public sigcxx::Binode<Node>
+{
+ public:
+
+  explicit Node (int value = 0)
+      : value_(value)
+  { }
+
+  virtual ~Node () { }
+
+  int value () const { return value_; }
+
+ private:
+
+  int value_;
+};
+
+class CountedNode: public sigcxx::CountedDequeNode<CountedNode>
+{
+ public:
+
+  explicit CountedNode (int value = 0)
+      : value_(value)
+  { }
+
+  virtual ~CountedNode () { }
+
+  int value () const { return value_; }
+
+ private:
+
+  int value_;
+};
+
+}  // namespace
+
+/*
+ * Push, iterate and erase 1M nodes with Deque, CountedDeque and std::list
+ */
+TEST_F(Test, deque)
+{
+  const int count = 1000000;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best[3][3];
+  for (auto &row : best) for (auto &cell : row) cell = Clock::duration::max();
+  long sums[3] = {0, 0, 0};
+
+  std::unique_ptr<Node[]> nodes(new Node[count]);
+  std::unique_ptr<CountedNode[]> counted_nodes(new CountedNode[count]);
+
+  for (int k = 0; k < 5; k++) {
+    Clock::time_point start;
+
+    // Deque:
+    {
+      Deque<Node> deque;
+      start = Clock::now();
+      for (int i = 0; i < count; i++) deque.push_back(&nodes[i]);
+      best[0][0] = std::min(best[0][0], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = deque.begin(); it != deque.end(); ++it) sums[0] += it->value() + 1;
+      best[0][1] = std::min(best[0][1], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = deque.begin(); it != deque.end();) it = deque.erase(it);
+      best[0][2] = std::min(best[0][2], Clock::now() - start);
+    }
+
+    // CountedDeque:
+    {
+      CountedDeque<CountedNode> deque;
+      start = Clock::now();
+      for (int i = 0; i < count; i++) deque.push_back(&counted_nodes[i]);
+      best[1][0] = std::min(best[1][0], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = deque.begin(); it != deque.end(); ++it) sums[1] += it->value() + 1;
+      best[1][1] = std::min(best[1][1], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = deque.begin(); it != deque.end();) it = deque.erase(it);
+      best[1][2] = std::min(best[1][2], Clock::now() - start);
+      ASSERT_TRUE(deque.size() == 0);
+    }
+
+    // std::list, which allocates each element:
+    {
+      std::list<int> list;
+      start = Clock::now();
+      for (int i = 0; i < count; i++) list.push_back(0);
+      best[2][0] = std::min(best[2][0], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = list.begin(); it != list.end(); ++it) sums[2] += *it + 1;
+      best[2][1] = std::min(best[2][1], Clock::now() - start);
+
+      start = Clock::now();
+      for (auto it = list.begin(); it != list.end();) it = list.erase(it);
+      best[2][2] = std::min(best[2][2], Clock::now() - start);
+    }
+  }
+
+  ASSERT_TRUE(sums[0] == sums[1] && sums[1] == sums[2]);
+
+  const char *names[3] = {"Deque", "CountedDeque", "std::list"};
+  for (int i = 0; i < 3; i++) {
+    std::cout << names[i] << " x " << count << ": push "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best[i][0]).count() << " us, iterate "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best[i][1]).count() << " us, erase "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best[i][2]).count() << " us" << std::endl;
+  }
+}
@@ -0,0 +1,109 @@
+// Benchmark code for EmbeddedConnection
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/embedded_connection.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using sigcxx::Signal;
+
+namespace {
+
+/**
+ * @brief A receiver with its connection as a member
+ */
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void Attach (sigcxx::Signal<int> &signal)
+  {
+    connection_.Connect(signal, this, &Receiver::OnValue);
+  }
+
+  bool IsAttached () const
+  {
+    return connection_.IsConnected();
+  }
+
+  void OnValue (int n, __SLOT__)
+  {
+    sum_ += n;
+  }
+
+ private:
+
+  int sum_;
+
+  sigcxx::EmbeddedConnection<sigcxx::Signal<int> > connection_;
+};
+
+/**
+ * @brief A receiver connected the usual way
+ */
+class HeapReceiver: public sigcxx::Trackable
+{
+ public:
+
+  HeapReceiver ()
+      : sum_(0)
+  { }
+
+  virtual ~HeapReceiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    sum_ += n;
+  }
+
+ private:
+
+  int sum_;
+};
+
+}  // namespace
+
+/*
+ * Connect and disconnect 100k receivers with EmbeddedConnection and Signal::Connect()
+ */
+TEST_F(Test, embedded_connection)
+{
+  const size_t count = 100000;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best_heap = Clock::duration::max();
+  Clock::duration best_embedded = Clock::duration::max();
+
+  std::vector<HeapReceiver> heap_receivers(count);
+  std::vector<Receiver> receivers(count);
+  Signal<int> signal;
+
+  for (int k = 0; k < 5; k++) {
+    Clock::time_point start = Clock::now();
+    for (auto &receiver : heap_receivers) signal.Connect(&receiver, &HeapReceiver::OnValue);
+    signal.DisconnectAll();
+    best_heap = std::min(best_heap, Clock::now() - start);
+
+    start = Clock::now();
+    for (auto &receiver : receivers) receiver.Attach(signal);
+    signal.DisconnectAll();
+    best_embedded = std::min(best_embedded, Clock::now() - start);
+  }
+  ASSERT_TRUE(!receivers[0].IsAttached());
+
+  std::cout << "Connect() and DisconnectAll() x " << count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_heap).count() << " us" << std::endl;
+  std::cout << "EmbeddedConnection x " << count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_embedded).count() << " us" << std::endl;
+}
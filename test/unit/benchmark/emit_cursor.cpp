@@ -0,0 +1,78 @@
+// Benchmark code for EmitCursor
+
+#include "test.hpp"
+
+#include <sigcxx/emit_cursor.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::EmitCursor;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
+
+}  // namespace
+
+/*
+ * Slices in a time budget, and the cost compared with Emit()
+ */
+TEST_F(Test, emit_cursor)
+{
+  const int count = 200000;
+
+  Signal<int> signal;
+  std::vector<std::unique_ptr<Receiver> > receivers;
+  for (int i = 0; i < count; i++) {
+    receivers.emplace_back(new Receiver);
+    signal.Connect(receivers.back().get(), &Receiver::OnValue);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  signal.Emit(1);
+  auto emit_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  int slices = 0;
+  EmitCursor<int> cursor(signal, 1);
+  while (!cursor.ResumeFor(std::chrono::microseconds(500))) slices++;
+  slices++;
+  auto time_sliced = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  EmitCursor<int> count_cursor(signal, 1);
+  while (!count_cursor.Resume(10000)) {}
+  auto count_sliced = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver->count() == 3);
+
+  std::cout << "Emit to " << count << " slots: " << emit_time << " us in one call, " << time_sliced << " us in "
+            << slices << " slices of 500 us, " << count_sliced << " us in slices of 10000 slots" << std::endl;
+}
@@ -0,0 +1,102 @@
+// Benchmark code for EventBus
+
+#include "test.hpp"
+
+#include <sigcxx/event_bus.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using sigcxx::EventBus;
+using sigcxx::Signal;
+
+using namespace sigcxx::literals;
+
+WIZTK_DECLARE_EVENT("bench.0", int);
+WIZTK_DECLARE_EVENT("bench.1", int);
+WIZTK_DECLARE_EVENT("bench.2", int);
+WIZTK_DECLARE_EVENT("bench.3", int);
+
+namespace {
+
+class Counter: public sigcxx::Trackable
+{
+ public:
+
+  void OnValue (int value, __SLOT__)
+  {
+    sum += value;
+  }
+
+  long sum = 0;
+};
+
+template<typename F>
+long Measure(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
+/*
+ * Emission through the bus versus a std::unordered_map of names
+ */
+TEST_F(Test, event_bus)
+{
+  const int count = 1000000;
+
+  EventBus bus;
+  Counter bus_counter;
+  bus.channel<"bench.0"_ev>().Connect(&bus_counter, &Counter::OnValue);
+  bus.channel<"bench.1"_ev>().Connect(&bus_counter, &Counter::OnValue);
+  bus.channel<"bench.2"_ev>().Connect(&bus_counter, &Counter::OnValue);
+  bus.channel<"bench.3"_ev>().Connect(&bus_counter, &Counter::OnValue);
+
+  std::unordered_map<std::string, std::unique_ptr<Signal<int> > > map;
+  Counter map_counter;
+  for (const char *name : {"bench.0", "bench.1", "bench.2", "bench.3"}) {
+    map[name].reset(new Signal<int>);
+    map[name]->Connect(&map_counter, &Counter::OnValue);
+  }
+
+  long bus_time = Measure([&]() {
+    for (int i = 0; i < count; i++) {
+      bus.Emit<"bench.0"_ev>(i);
+      bus.Emit<"bench.1"_ev>(i);
+      bus.Emit<"bench.2"_ev>(i);
+      bus.Emit<"bench.3"_ev>(i);
+    }
+  });
+
+  long map_time = Measure([&]() {
+    for (int i = 0; i < count; i++) {
+      (*map.find("bench.0")->second)(i);
+      (*map.find("bench.1")->second)(i);
+      (*map.find("bench.2")->second)(i);
+      (*map.find("bench.3")->second)(i);
+    }
+  });
+
+  // The signals alone, without any lookup:
+  Signal<int> *signals[] = {map["bench.0"].get(), map["bench.1"].get(), map["bench.2"].get(), map["bench.3"].get()};
+  long direct_time = Measure([&]() {
+    for (int i = 0; i < count; i++) {
+      (*signals[0])(i);
+      (*signals[1])(i);
+      (*signals[2])(i);
+      (*signals[3])(i);
+    }
+  });
+
+  ASSERT_TRUE(2 * bus_counter.sum == map_counter.sum);
+
+  std::cout << 4 * count << " emissions: " << bus_time << " us with EventBus, " << map_time
+            << " us with a std::unordered_map<std::string, ...>, " << direct_time << " us without lookup"
+            << std::endl;
+}
@@ -0,0 +1,68 @@
+// Benchmark code for EmitAsync() and EventQueue
+
+#include "test.hpp"
+
+#include <sigcxx/event_queue.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::EmitFuture;
+using sigcxx::EventQueue;
+
+namespace {
+
+class Consumer: public sigcxx::Trackable
+{
+ public:
+
+  Consumer ()
+      : sum_(0)
+  { }
+
+  virtual ~Consumer () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    sum_ += n;
+  }
+
+ private:
+
+  long sum_;
+};
+
+}  // namespace
+
+/*
+ * Many emissions in flight
+ */
+TEST_F(Test, event_queue)
+{
+  const int count = 100000;
+  Signal<int> signal;
+  Consumer consumer;
+  EventQueue queue;
+  std::vector<EmitFuture> futures;
+
+  queue.Connect(signal, &consumer, &Consumer::OnValue);
+  futures.reserve(count);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    futures.push_back(signal.EmitAsync(i));
+  }
+  auto emitted = std::chrono::steady_clock::now();
+  queue.ProcessEvents();
+  auto end = std::chrono::steady_clock::now();
+
+  for (auto &future : futures) ASSERT_TRUE(future.IsReady());
+
+  std::cout << count << " queued EmitAsync(): "
+            << std::chrono::duration_cast<std::chrono::microseconds>(emitted - start).count()
+            << " us, processed in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - emitted).count()
+            << " us, " << sizeof(sigcxx::internal::EmitLatch) << " bytes per latch" << std::endl;
+}
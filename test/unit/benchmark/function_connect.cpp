@@ -0,0 +1,104 @@
+// Benchmark code for connecting static functions
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/node_arena.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+
+namespace {
+
+size_t count = 0;
+
+void OnValue(int n) {
+  count++;
+}
+
+/**
+ * @brief The usual workaround: a Trackable object only to call a function
+ */
+class FunctionReceiver: public sigcxx::Trackable
+{
+ public:
+
+  explicit FunctionReceiver (void (*function)(int))
+      : function_(function)
+  { }
+
+  virtual ~FunctionReceiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    function_(n);
+  }
+
+ private:
+
+  void (*function_)(int);
+};
+
+}  // namespace
+
+/*
+ * 100k functions connected directly or through Trackable objects
+ */
+TEST_F(Test, function_connect)
+{
+  const size_t connections = 100000;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best_connect[2] = {Clock::duration::max(), Clock::duration::max()};
+  Clock::duration best_emit[2] = {Clock::duration::max(), Clock::duration::max()};
+  size_t nodes[2] = {0, 0};
+  size_t base = NodeArena::GetStats().node_count;
+
+  for (int k = 0; k < 5; k++) {
+    {
+      Clock::time_point start = Clock::now();
+      std::unique_ptr<Signal<int> > signal(new Signal<int>);
+      std::vector<std::unique_ptr<FunctionReceiver> > receivers;
+      receivers.reserve(connections);
+      for (size_t i = 0; i < connections; i++) {
+        receivers.emplace_back(new FunctionReceiver(OnValue));
+        signal->Connect(receivers.back().get(), &FunctionReceiver::OnValue);
+      }
+      best_connect[0] = std::min(best_connect[0], Clock::now() - start);
+      nodes[0] = NodeArena::GetStats().node_count - base;
+
+      start = Clock::now();
+      signal->Emit(1);
+      best_emit[0] = std::min(best_emit[0], Clock::now() - start);
+    }
+    {
+      Clock::time_point start = Clock::now();
+      std::unique_ptr<Signal<int> > signal(new Signal<int>);
+      for (size_t i = 0; i < connections; i++) {
+        signal->Connect(OnValue);
+      }
+      best_connect[1] = std::min(best_connect[1], Clock::now() - start);
+      nodes[1] = NodeArena::GetStats().node_count - base;
+
+      start = Clock::now();
+      signal->Emit(1);
+      best_emit[1] = std::min(best_emit[1], Clock::now() - start);
+    }
+  }
+  ASSERT_TRUE(count == 10 * connections);
+  ASSERT_TRUE(nodes[1] == connections);
+
+  const char *names[2] = {"Trackable objects", "Functions"};
+  for (int i = 0; i < 2; i++) {
+    std::cout << names[i] << " x " << connections << ": connect "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best_connect[i]).count() << " us, emit "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best_emit[i]).count() << " us, "
+              << nodes[i] << " nodes" << std::endl;
+  }
+}
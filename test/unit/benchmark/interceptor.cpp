@@ -0,0 +1,85 @@
+// Benchmark code for Signal interceptors
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using sigcxx::Signal;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    sum_ += n;
+  }
+
+ private:
+
+  long sum_;
+};
+
+class Guard
+{
+ public:
+
+  bool Double (int &n)
+  {
+    n *= 2;
+    return true;
+  }
+};
+
+}  // namespace
+
+/*
+ * Emission without interceptor, with an interceptor, and with the same check as an extra slot
+ */
+TEST_F(Test, interceptor)
+{
+  const int count = 2000000;
+
+  typedef std::chrono::steady_clock Clock;
+  Receiver receiver;
+  Guard guard;
+
+  Signal<int> plain;
+  plain.Connect(&receiver, &Receiver::OnValue);
+
+  Signal<int> intercepted;
+  intercepted.AddInterceptor(&guard, &Guard::Double);
+  intercepted.Connect(&receiver, &Receiver::OnValue);
+
+  Signal<int> extra_slot;
+  extra_slot.Connect(&receiver, &Receiver::OnValue);
+  extra_slot.Connect(&receiver, &Receiver::OnValue);
+
+  Clock::duration best[3] = {Clock::duration::max(), Clock::duration::max(), Clock::duration::max()};
+  Signal<int> *signals[3] = {&plain, &intercepted, &extra_slot};
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 3; i++) {
+      auto start = Clock::now();
+      for (int n = 0; n < count; n++) signals[i]->Emit(n & 0xFF);
+      auto elapsed = Clock::now() - start;
+      if (elapsed < best[i]) best[i] = elapsed;
+    }
+  }
+
+  const char *names[3] = {"no interceptor", "one interceptor", "two slots"};
+  for (int i = 0; i < 3; i++) {
+    std::cout << names[i] << ", " << count << " emissions: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(best[i]).count() << " us" << std::endl;
+  }
+}
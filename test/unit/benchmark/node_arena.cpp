@@ -0,0 +1,101 @@
+// Benchmark code for NodeArena
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/node_arena.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+using sigcxx::NodeArenaStats;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+  }
+
+  void Unbind ()
+  {
+    UnbindAllSignals();
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
+
+}  // namespace
+
+/*
+ * Connect and disconnect, and the pages used before and after Compact()
+ */
+TEST_F(Test, node_arena)
+{
+  const size_t count = 200000;
+  const int rounds = 5;
+
+  Signal<int> signal;
+  std::vector<Receiver> receivers(count);
+
+  // Warm up the pages:
+  for (size_t i = 0; i < count; i++) signal.Connect(&receivers[i], &Receiver::OnValue);
+  signal.DisconnectAll();
+
+  std::chrono::steady_clock::duration best = std::chrono::steady_clock::duration::max();
+  for (int round = 0; round < rounds; round++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) signal.Connect(&receivers[i], &Receiver::OnValue);
+    for (size_t i = 0; i < count; i++) receivers[i].Unbind();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed < best) best = elapsed;
+  }
+  ASSERT_TRUE(signal.CountConnections() == 0);
+
+  std::cout << "connect + disconnect " << count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best).count() << " us" << std::endl;
+
+  // Keep one connection of ten, spread over all pages:
+  Signal<int> other;
+  for (size_t i = 0; i < count; i++) {
+    signal.Connect(&receivers[i], &Receiver::OnValue);
+    other.Connect(&receivers[i], &Receiver::OnValue);
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (0 != i % 10) receivers[i].Unbind();
+  }
+
+  NodeArenaStats before = NodeArena::GetStats();
+  auto start = std::chrono::steady_clock::now();
+  size_t moved = NodeArena::Compact();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  NodeArenaStats after = NodeArena::GetStats();
+
+  std::cout << "Compact() moved " << moved << " bindings in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us" << std::endl;
+  std::cout << "pages: " << before.page_count << " -> " << after.page_count
+            << ", reserved KB: " << before.reserved_bytes / 1024 << " -> " << after.reserved_bytes / 1024
+            << ", fragmentation: " << before.fragmentation() << " -> " << after.fragmentation() << std::endl;
+
+  ASSERT_TRUE(after.page_count < before.page_count);
+
+  signal.Emit(1);
+  ASSERT_TRUE(receivers[10].count() == 1 && receivers[11].count() == 0);
+}
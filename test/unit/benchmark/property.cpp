@@ -0,0 +1,112 @@
+// Benchmark code for Property
+
+#include "test.hpp"
+
+#include <sigcxx/property.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+using sigcxx::Signal;
+using sigcxx::Property;
+using sigcxx::PropertyTransaction;
+
+namespace {
+
+class Counter: public sigcxx::Trackable
+{
+ public:
+
+  Counter ()
+      : count_(0)
+  { }
+
+  virtual ~Counter () { }
+
+  void OnChanged (const int &value, __SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
+
+// What the owners of a value write by hand without Property:
+struct HandWritten {
+  int value = 0;
+  Signal<const int &> changed;
+
+  void Set(int new_value) {
+    if (value == new_value) return;
+    value = new_value;
+    changed.Emit(value);
+  }
+};
+
+template<typename F>
+long Measure(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
+/*
+ * Update throughput on 1M properties
+ */
+TEST_F(Test, property)
+{
+  const int count = 1000000;
+  const int rounds = 4;
+
+  std::unique_ptr<Property<int>[]> properties(new Property<int>[count]);
+  std::unique_ptr<HandWritten[]> hand_written(new HandWritten[count]);
+
+  long property_time = Measure([&]() {
+    for (int r = 1; r <= rounds; r++) {
+      for (int i = 0; i < count; i++) properties[i].Set(r);
+    }
+  });
+  long hand_written_time = Measure([&]() {
+    for (int r = 1; r <= rounds; r++) {
+      for (int i = 0; i < count; i++) hand_written[i].Set(r);
+    }
+  });
+  long suppressed_time = Measure([&]() {
+    for (int i = 0; i < count; i++) properties[i].Set(rounds);
+  });
+
+  std::cout << "Unobserved, " << rounds * count << " updates: " << property_time << " us with Property ("
+            << sizeof(Property<int>) << " bytes), " << hand_written_time << " us with a value and a Signal ("
+            << sizeof(HandWritten) << " bytes), " << suppressed_time << " us for " << count
+            << " equal values" << std::endl;
+
+  Counter counter;
+  for (int i = 0; i < count; i++) properties[i].changed().Connect(&counter, &Counter::OnChanged);
+
+  long plain_time = Measure([&]() {
+    for (int r = 1; r <= rounds; r++) {
+      for (int i = 0; i < count; i++) properties[i].Set(rounds + r);
+    }
+  });
+  ASSERT_TRUE(counter.count() == rounds * count);
+
+  long transaction_time = Measure([&]() {
+    PropertyTransaction transaction;
+    for (int r = 1; r <= rounds; r++) {
+      for (int i = 0; i < count; i++) properties[i].Set(2 * rounds + r);
+    }
+  });
+  ASSERT_TRUE(counter.count() == (rounds + 1) * count);
+
+  std::cout << "Observed, " << rounds * count << " updates: " << plain_time << " us with "
+            << rounds * count << " emissions, " << transaction_time << " us in a PropertyTransaction with "
+            << count << " emissions" << std::endl;
+}
@@ -0,0 +1,83 @@
+// Benchmark code for EmissionRecorder and EmissionReplayer
+
+#include "test.hpp"
+
+#include <sigcxx/recorder.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+using sigcxx::Signal;
+using sigcxx::EmissionRecorder;
+using sigcxx::EmissionReplayer;
+
+namespace {
+
+class Widget: public sigcxx::Trackable
+{
+ public:
+
+  Widget ()
+      : click_count_(0)
+  { }
+
+  virtual ~Widget () { }
+
+  void OnClicked (int x, int y, bool right, __SLOT__)
+  {
+    click_count_++;
+  }
+
+  inline size_t click_count () const { return click_count_; }
+
+ private:
+
+  size_t click_count_;
+};
+
+}  // namespace
+
+/*
+ * Record 1M emissions and replay them
+ */
+TEST_F(Test, recorder)
+{
+  const int total = 1000000;
+  std::string path = "/tmp/sigcxx_benchmark_" + std::to_string(getpid()) + ".log";
+  Signal<int, int, bool> clicked;
+  Widget widget;
+
+  clicked.Connect(&widget, &Widget::OnClicked);
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    EmissionRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.c_str()));
+    recorder.Record(clicked, 0);
+    for (int i = 0; i < total; i++) clicked(i, i, false);
+  }
+  auto recorded = std::chrono::steady_clock::now();
+
+  Signal<int, int, bool> replayed;
+  replayed.Connect(&widget, &Widget::OnClicked);
+
+  EmissionReplayer replayer;
+  ASSERT_TRUE(replayer.Open(path.c_str()));
+  replayer.Bind(replayed, 0);
+  ASSERT_TRUE(replayer.Replay() == total);
+  auto replayed_time = std::chrono::steady_clock::now();
+
+  std::cout << "record " << total << " emissions: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(recorded - start).count() << " ms, "
+            << "replay: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(replayed_time - recorded).count() << " ms"
+            << std::endl;
+
+  ASSERT_TRUE(widget.click_count() == 2 * total);
+
+  remove(path.c_str());
+}
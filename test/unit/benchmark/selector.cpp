@@ -0,0 +1,35 @@
+// Benchmark code for SignalSelector
+
+#include "test.hpp"
+
+#include <sigcxx/selector.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using sigcxx::Signal;
+using sigcxx::SignalSelector;
+
+/*
+ * Emissions which set a ready bit in a selector
+ */
+TEST_F(Test, selector)
+{
+  const int count = 1000000;
+  Signal<int> signal;
+  SignalSelector selector;
+  selector.Add(signal);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    signal(i);
+    if ((i & 1023) == 0) selector.Take();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << count << " emissions to a selector: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+            << " us" << std::endl;
+
+  ASSERT_TRUE(selector.Take() == 0);
+}
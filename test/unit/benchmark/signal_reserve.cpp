@@ -0,0 +1,70 @@
+// Benchmark code for Signal::Reserve()
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/node_arena.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver () { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__) { }
+};
+
+}  // namespace
+
+/*
+ * 50k connections with and without Reserve()
+ */
+TEST_F(Test, signal_reserve)
+{
+  const size_t count = 50000;
+  const int rounds = 5;
+
+  typedef std::chrono::steady_clock Clock;
+  std::vector<Receiver> receivers(count);
+  Clock::duration best_plain = Clock::duration::max();
+  Clock::duration best_reserved = Clock::duration::max();
+
+  for (int round = 0; round < rounds; round++) {
+    {
+      Signal<int> signal;
+      NodeArena::TrimMemory();
+      auto start = Clock::now();
+      for (auto &receiver : receivers) signal.Connect(&receiver, &Receiver::OnValue);
+      auto elapsed = Clock::now() - start;
+      if (elapsed < best_plain) best_plain = elapsed;
+    }
+    {
+      Signal<int> signal;
+      signal.Reserve(count);
+      auto start = Clock::now();
+      for (auto &receiver : receivers) signal.Connect(&receiver, &Receiver::OnValue);
+      auto elapsed = Clock::now() - start;
+      if (elapsed < best_reserved) best_reserved = elapsed;
+      if (0 == round) {
+        std::cout << "memory usage: " << signal.MemoryUsage().bytes / 1024 << " KB for "
+                  << signal.MemoryUsage().connection_count << " connections" << std::endl;
+      }
+    }
+  }
+
+  std::cout << "Connect() x " << count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_plain).count() << " us" << std::endl;
+  std::cout << "Connect() x " << count << " after Reserve(): "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_reserved).count() << " us" << std::endl;
+}
@@ -0,0 +1,83 @@
+// Benchmark code for slot methods without the SLOT parameter
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using sigcxx::Signal;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnValueWithSlot (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  int count () const { return count_; }
+
+ private:
+
+  int count_;
+  int sum_;
+};
+
+}  // namespace
+
+/*
+ * Emit to 1000 slot methods with and without the SLOT parameter
+ */
+TEST_F(Test, slot_free)
+{
+  const size_t count = 1000;
+  const int emits = 1000;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best_slot = Clock::duration::max();
+  Clock::duration best_slot_free = Clock::duration::max();
+
+  std::vector<Receiver> receivers(count);
+  Signal<int> with_slot;
+  Signal<int> slot_free;
+  for (auto &receiver : receivers) {
+    with_slot.Connect(&receiver, &Receiver::OnValueWithSlot);
+    slot_free.Connect(&receiver, &Receiver::OnValue);
+  }
+
+  for (int k = 0; k < 5; k++) {
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < emits; i++) with_slot.Emit(1);
+    best_slot = std::min(best_slot, Clock::now() - start);
+
+    start = Clock::now();
+    for (int i = 0; i < emits; i++) slot_free.Emit(1);
+    best_slot_free = std::min(best_slot_free, Clock::now() - start);
+  }
+  ASSERT_TRUE(receivers[0].count() == 10 * emits);
+
+  std::cout << "Emit() x " << emits << " to " << count << " SLOT methods: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_slot).count() << " us" << std::endl;
+  std::cout << "Emit() x " << emits << " to " << count << " SLOT-free methods: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_slot_free).count() << " us" << std::endl;
+}
@@ -0,0 +1,69 @@
+// Benchmark code for TrackableTeardownScope
+
+#include "test.hpp"
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::TrackableTeardownScope;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver () { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__) { }
+};
+
+}  // namespace
+
+/*
+ * Destroy many receivers connected to a few signals, with and without a scope
+ */
+TEST_F(Test, teardown_scope)
+{
+  const int count = 500000;
+  const int signal_count = 64;
+
+  auto run = [](bool batched) {
+    std::vector<std::unique_ptr<Signal<int> > > signals;
+    for (int i = 0; i < signal_count; i++) signals.emplace_back(new Signal<int>);
+
+    std::vector<std::unique_ptr<Receiver> > receivers;
+    receivers.reserve(count);
+    for (int i = 0; i < count; i++) {
+      receivers.emplace_back(new Receiver);
+      signals[i % signal_count]->Connect(receivers.back().get(), &Receiver::OnValue);
+      signals[(i * 7) % signal_count]->Connect(receivers.back().get(), &Receiver::OnValue);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (batched) {
+      TrackableTeardownScope scope;
+      receivers.clear();
+    } else {
+      receivers.clear();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (auto &signal : signals) EXPECT_TRUE(signal->CountConnections() == 0);
+    return elapsed;
+  };
+
+  auto batched = run(true);
+  auto one_by_one = run(false);
+
+  std::cout << "Destroy " << count << " receivers with " << 2 * count << " connections: "
+            << one_by_one << " us one by one, " << batched << " us in a TrackableTeardownScope" << std::endl;
+}
@@ -0,0 +1,13 @@
+// Benchmark code, each file measures one feature, see test.hpp
+
+#include "test.hpp"
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
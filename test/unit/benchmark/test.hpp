@@ -0,0 +1,16 @@
+// Benchmark code, timings printed by the test_benchmark target only
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
@@ -0,0 +1,106 @@
+// Benchmark code for wiring tables
+
+#include "test.hpp"
+
+#include <sigcxx/wiring.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+using sigcxx::ApplyWiring;
+using sigcxx::NodeArena;
+using sigcxx::WiringEntry;
+
+namespace {
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver () { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__) { }
+
+  void OnPair (int a, double b, __SLOT__) { }
+
+  void OnNotify (__SLOT__) { }
+};
+
+class SubReceiver: public Receiver
+{
+ public:
+
+  SubReceiver () { }
+
+  virtual ~SubReceiver () { }
+};
+
+struct Context
+{
+  sigcxx::Signal<int> value;
+  sigcxx::Signal<int, double> pair;
+  sigcxx::Signal<> notify;
+
+  Receiver first;
+  SubReceiver second;
+};
+
+constexpr WiringEntry<Context> kWiring[] = {
+    WIZTK_WIRE(&Context::value, &Context::first, &Receiver::OnValue),
+    WIZTK_WIRE(&Context::value, &Context::second, &Receiver::OnValue),
+    WIZTK_WIRE(&Context::pair, &Context::first, &Receiver::OnPair),
+    WIZTK_WIRE(&Context::notify, &Context::second, &Receiver::OnNotify),
+};
+
+}  // namespace
+
+/*
+ * 300k connections with individual Connect() calls or a wiring table
+ */
+TEST_F(Test, wiring)
+{
+  const size_t count = 75000;  // 4 connections each
+  const int rounds = 3;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration best_connect = Clock::duration::max();
+  Clock::duration best_table = Clock::duration::max();
+
+  for (int round = 0; round < rounds; round++) {
+    {
+      std::unique_ptr<Context[]> contexts(new Context[count]);
+      NodeArena::TrimMemory();
+
+      auto start = Clock::now();
+      for (size_t i = 0; i < count; i++) {
+        Context &context = contexts[i];
+        context.value.Connect(&context.first, &Receiver::OnValue);
+        context.value.Connect(static_cast<Receiver *>(&context.second), &Receiver::OnValue);
+        context.pair.Connect(&context.first, &Receiver::OnPair);
+        context.notify.Connect(static_cast<Receiver *>(&context.second), &Receiver::OnNotify);
+      }
+      auto elapsed = Clock::now() - start;
+      if (elapsed < best_connect) best_connect = elapsed;
+    }
+
+    {
+      std::unique_ptr<Context[]> contexts(new Context[count]);
+      NodeArena::TrimMemory();
+
+      auto start = Clock::now();
+      ApplyWiring(contexts.get(), contexts.get() + count, kWiring);
+      auto elapsed = Clock::now() - start;
+      if (elapsed < best_table) best_table = elapsed;
+
+      ASSERT_TRUE(contexts[count - 1].value.CountConnections() == 2);
+    }
+  }
+
+  std::cout << "Connect() x " << 4 * count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_connect).count() << " us" << std::endl;
+  std::cout << "ApplyWiring() x " << 4 * count << ": "
+            << std::chrono::duration_cast<std::chrono::microseconds>(best_table).count() << " us" << std::endl;
+}
@@ -0,0 +1,88 @@
+// Unit test code for connections with bound arguments
+
+#include "test.hpp"
+
+#include <string>
+
+using sigcxx::Signal;
+using sigcxx::SignalRef;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * The bound value tells which signal emitted
+ */
+TEST_F(Test, bound_row)
+{
+  Table table;
+  Signal<int> rows[3];
+  for (int i = 0; i < 3; i++) rows[i].Connect(&table, &Table::OnCellChanged, i);
+
+  rows[2](10);
+  ASSERT_TRUE(table.last_row() == 2 && table.last_value() == 10);
+  rows[0](20);
+  ASSERT_TRUE(table.last_row() == 0 && table.last_value() == 20);
+  ASSERT_TRUE(table.count() == 2);
+
+  ASSERT_TRUE(rows[1].CountConnections() == 1);
+  ASSERT_TRUE(table.CountSignalBindings() == 3);
+}
+
+/*
+ * Several bound values, converted and copied into the connection
+ */
+TEST_F(Test, bound_values)
+{
+  Table table;
+  Signal<int> signal;
+
+  std::string name("width");
+  SignalRef<int>(signal).Connect(&table, &Table::OnNamedCellChanged, name, 3);
+  name = "height";
+
+  signal(640);
+  ASSERT_TRUE(table.last_name() == "width");
+  ASSERT_TRUE(table.last_row() == 3 && table.last_value() == 640);
+
+  // A reference parameter refers to the value stored in the connection:
+  Signal<int> counted;
+  counted.Connect(&table, &Table::OnCounted, 0);
+  counted(1);
+  counted(1);
+  ASSERT_TRUE(table.count() == 3);
+}
+
+/*
+ * Bound connections are broken like others
+ */
+TEST_F(Test, disconnect)
+{
+  Signal<int> signal;
+  Table table1;
+  {
+    Table table2;
+    signal.Connect(&table1, &Table::OnCellChanged, 1);
+    signal.Connect(&table2, &Table::OnCellChanged, 2);
+    signal.Connect(&table1, &Table::OnCellChanged, 3);
+    ASSERT_TRUE(signal.CountConnections() == 3);
+  }
+
+  ASSERT_TRUE(signal.CountConnections() == 2);
+  signal(0);
+  ASSERT_TRUE(table1.sum() == 4);
+
+  ASSERT_TRUE(signal.Disconnect(-1, 1) == 1);
+  signal(0);
+  ASSERT_TRUE(table1.last_row() == 1);
+
+  signal.DisconnectAll();
+  ASSERT_TRUE(table1.CountSignalBindings() == 0);
+}
@@ -0,0 +1,71 @@
+// Unit test code for connections with bound arguments
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <string>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Table: public sigcxx::Trackable
+{
+ public:
+
+  Table ()
+      : count_(0), last_row_(-1), last_value_(0), sum_(0)
+  { }
+
+  virtual ~Table () { }
+
+  void OnCellChanged (int row, int value, __SLOT__)
+  {
+    count_++;
+    last_row_ = row;
+    last_value_ = value;
+    sum_ += row + value;
+  }
+
+  void OnNamedCellChanged (const std::string &name, size_t column, int value, __SLOT__)
+  {
+    count_++;
+    last_name_ = name;
+    last_row_ = static_cast<int>(column);
+    last_value_ = value;
+  }
+
+  void OnCounted (int &calls, int value, __SLOT__)
+  {
+    calls++;
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+  inline int last_row () const { return last_row_; }
+
+  inline int last_value () const { return last_value_; }
+
+  inline long sum () const { return sum_; }
+
+  inline const std::string &last_name () const { return last_name_; }
+
+ private:
+
+  int count_;
+  int last_row_;
+  int last_value_;
+  long sum_;
+  std::string last_name_;
+};
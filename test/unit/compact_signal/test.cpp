@@ -0,0 +1,273 @@
+// Unit test code for CompactSignal
+
+#include "test.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using sigcxx::CompactSignal;
+using sigcxx::internal::CompactArena;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect, emit and disconnect
+ */
+TEST_F(Test, connect)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  {
+    CompactSignal<int> signal;
+    Receiver r1, r2;
+
+    signal.Connect(&r1, &Receiver::OnValue);
+    signal.Connect(&r2, &Receiver::OnValue);
+    signal.Connect(&r2, &Receiver::OnOther);
+    ASSERT_TRUE(signal.CountConnections() == 3);
+    ASSERT_TRUE(r1.CountCompactBindings() == 1);
+    ASSERT_TRUE(r2.CountCompactBindings() == 2);
+    ASSERT_TRUE(signal.IsConnectedTo(&r2, &Receiver::OnOther));
+    ASSERT_TRUE(!signal.IsConnectedTo(&r1, &Receiver::OnOther));
+
+    // 3 connections, 3 heads:
+    ASSERT_TRUE(CompactArena::GetStats().node_count == nodes + 6);
+
+    signal(3);
+    ASSERT_TRUE(r1.sum() == 3 && r2.sum() == 0 && r2.count() == 1);
+
+    signal.Disconnect(&r2, &Receiver::OnOther);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+    ASSERT_TRUE(r2.CountCompactBindings() == 1);
+
+    signal.Emit(2);
+    ASSERT_TRUE(r1.sum() == 5 && r2.sum() == 2);
+
+    r1.Unbind();
+    ASSERT_TRUE(signal.CountConnections() == 1);
+    ASSERT_TRUE(r1.CountCompactBindings() == 0);
+
+    signal.DisconnectAll();
+    ASSERT_TRUE(signal.CountConnections() == 0);
+    ASSERT_TRUE(r2.CountCompactBindings() == 0);
+  }
+
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes);
+}
+
+/*
+ * Destroying a receiver or a signal breaks the connections
+ */
+TEST_F(Test, destroy)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  CompactSignal<int> signal;
+  Receiver r1;
+  {
+    Receiver r2;
+    signal.Connect(&r1, &Receiver::OnValue);
+    signal.Connect(&r2, &Receiver::OnValue);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+  }
+  ASSERT_TRUE(signal.CountConnections() == 1);
+
+  {
+    CompactSignal<int> other;
+    other.Connect(&r1, &Receiver::OnOther);
+    ASSERT_TRUE(r1.CountCompactBindings() == 2);
+  }
+  ASSERT_TRUE(r1.CountCompactBindings() == 1);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r1.sum() == 1);
+
+  signal.DisconnectAll();
+  r1.Unbind();
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes + 2);  // the heads
+}
+
+/*
+ * A copied receiver has no connections
+ */
+TEST_F(Test, copy)
+{
+  CompactSignal<int> signal;
+  Receiver r1;
+  signal.Connect(&r1, &Receiver::OnValue);
+
+  Receiver r2(r1);
+  ASSERT_TRUE(r2.CountCompactBindings() == 0);
+  r2 = r1;
+  ASSERT_TRUE(r2.CountCompactBindings() == 0);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+}
+
+/*
+ * Disconnecting a receiver not called yet in a slot: it's skipped and its node is freed after the emission
+ */
+TEST_F(Test, disconnect_in_slot)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  {
+    CompactSignal<int> signal;
+    Breaker breaker;
+    Receiver receiver;
+    breaker.set_signal(&signal);
+    breaker.set_other(&receiver);
+
+    signal.Connect(&breaker, &Breaker::DisconnectOther);
+    signal.Connect(&receiver, &Receiver::OnValue);
+    signal.Emit(1);
+
+    ASSERT_TRUE(breaker.count() == 1);
+    ASSERT_TRUE(receiver.count() == 0);
+    ASSERT_TRUE(signal.CountConnections() == 1);
+    ASSERT_TRUE(receiver.CountCompactBindings() == 0);
+
+    // The broken node is free again, the receiver head is still there:
+    ASSERT_TRUE(CompactArena::GetStats().node_count == nodes + 4);
+  }
+
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes);
+}
+
+/*
+ * Deleting a receiver not called yet in a slot
+ */
+TEST_F(Test, delete_receiver_in_slot)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  {
+    CompactSignal<int> signal;
+    Breaker breaker;
+    Receiver *receiver = new Receiver;
+    Receiver last;
+    breaker.set_other(receiver);
+
+    signal.Connect(&breaker, &Breaker::DeleteOther);
+    signal.Connect(receiver, &Receiver::OnValue);
+    signal.Connect(receiver, &Receiver::OnOther);
+    signal.Connect(&last, &Receiver::OnValue);
+    signal.Emit(1);
+
+    ASSERT_TRUE(breaker.count() == 1);
+    ASSERT_TRUE(last.count() == 1);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+  }
+
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes);
+}
+
+/*
+ * Deleting the signal in a slot
+ */
+TEST_F(Test, delete_signal_in_slot)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  CompactSignal<int> *signal = new CompactSignal<int>;
+  Breaker breaker;
+  Receiver receiver;
+  breaker.set_signal(signal);
+
+  signal->Connect(&breaker, &Breaker::DeleteSignal);
+  signal->Connect(&receiver, &Receiver::OnValue);
+  signal->Emit(1);
+
+  ASSERT_TRUE(breaker.count() == 1);
+  ASSERT_TRUE(receiver.count() == 0);
+  ASSERT_TRUE(receiver.CountCompactBindings() == 0);
+  ASSERT_TRUE(breaker.CountCompactBindings() == 0);
+
+  // The receiver heads are left:
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes + 2);
+}
+
+/*
+ * Emitting a signal from a slot of another one
+ */
+class Relay: public sigcxx::CompactTrackable
+{
+ public:
+
+  void OnValue (int n)
+  {
+    next_->Emit(n + 1);
+    next_->DisconnectAll();
+  }
+
+  void set_next (CompactSignal<int> *next) { next_ = next; }
+
+ private:
+
+  CompactSignal<int> *next_ = nullptr;
+};
+
+TEST_F(Test, nested_emit)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  {
+    CompactSignal<int> first, second;
+    Relay relay;
+    Receiver receiver;
+    relay.set_next(&second);
+
+    first.Connect(&relay, &Relay::OnValue);
+    second.Connect(&receiver, &Receiver::OnValue);
+    first.Emit(1);
+
+    ASSERT_TRUE(receiver.sum() == 2);
+    ASSERT_TRUE(second.CountConnections() == 0);
+
+    // Freed when the outer emission ends:
+    ASSERT_TRUE(CompactArena::GetStats().node_count == nodes + 5);
+  }
+
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes);
+}
+
+/*
+ * A slot throwing an exception ends the emission, later disconnections are not deferred
+ */
+class Thrower: public sigcxx::CompactTrackable
+{
+ public:
+
+  void OnValue (int n)
+  {
+    throw std::runtime_error("Thrown in a slot");
+  }
+};
+
+TEST_F(Test, throw_in_slot)
+{
+  size_t nodes = CompactArena::GetStats().node_count;
+
+  {
+    CompactSignal<int> signal;
+    Thrower thrower;
+    Receiver receiver;
+
+    signal.Connect(&thrower, &Thrower::OnValue);
+    ASSERT_THROW(signal.Emit(1), std::runtime_error);
+
+    signal.Connect(&receiver, &Receiver::OnValue);
+    size_t connected = CompactArena::GetStats().node_count;
+    signal.Disconnect(&receiver, &Receiver::OnValue);
+    ASSERT_TRUE(CompactArena::GetStats().node_count < connected);
+  }
+
+  ASSERT_TRUE(CompactArena::GetStats().node_count == nodes);
+}
@@ -0,0 +1,101 @@
+// Unit test code for CompactSignal
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/compact_signal.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::CompactTrackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnOther (int n)
+  {
+    sum_ -= n;
+  }
+
+  void Unbind ()
+  {
+    UnbindAllCompactSignals();
+  }
+
+  int count () const { return count_; }
+
+  int sum () const { return sum_; }
+
+ private:
+
+  int count_;
+  int sum_;
+};
+
+/**
+ * @brief A receiver which breaks connections from its slot
+ */
+class Breaker: public sigcxx::CompactTrackable
+{
+ public:
+
+  Breaker ()
+      : count_(0)
+  { }
+
+  virtual ~Breaker () { }
+
+  void DisconnectOther (int n)
+  {
+    count_++;
+    signal_->Disconnect(other_, &Receiver::OnValue);
+  }
+
+  void DeleteOther (int n)
+  {
+    count_++;
+    delete other_;
+    other_ = nullptr;
+  }
+
+  void DeleteSignal (int n)
+  {
+    count_++;
+    delete signal_;
+    signal_ = nullptr;
+  }
+
+  void set_signal (sigcxx::CompactSignal<int> *signal) { signal_ = signal; }
+
+  void set_other (Receiver *other) { other_ = other; }
+
+  int count () const { return count_; }
+
+ private:
+
+  int count_;
+  sigcxx::CompactSignal<int> *signal_ = nullptr;
+  Receiver *other_ = nullptr;
+};
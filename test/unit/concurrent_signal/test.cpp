@@ -0,0 +1,226 @@
+// Unit test code for ConcurrentSignal
+
+#include "test.hpp"
+
+#include <iostream>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using sigcxx::ConcurrentSignal;
+using sigcxx::internal::EpochDomain;
+
+std::atomic<int> Receiver::violations_(0);
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect, emit and disconnect in one thread
+ */
+TEST_F(Test, connect_and_disconnect)
+{
+  ConcurrentSignal<int> signal;
+  Receiver r1, r2;
+
+  signal.Connect(&r1, &Receiver::OnValue);
+  signal.Connect(&r2, &Receiver::OnValue);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  ASSERT_TRUE(signal.CountConnections() == 3);
+  ASSERT_TRUE(signal.IsConnectedTo(&r1, &Receiver::OnValue));
+  ASSERT_TRUE(r2.CountSignalBindings() == 2);
+
+  signal(1);
+  ASSERT_TRUE(r1.count() == 1 && r2.count() == 2);
+
+  ASSERT_TRUE(signal.DisconnectAll(&r2, &Receiver::OnValue) == 2);
+  ASSERT_TRUE(r2.CountSignalBindings() == 0);
+
+  signal(2);
+  ASSERT_TRUE(r1.count() == 2 && r2.count() == 2);
+
+  {
+    Receiver r3;
+    signal.Connect(&r3, &Receiver::OnValue);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+  }
+  ASSERT_TRUE(signal.CountConnections() == 1);
+
+  ASSERT_TRUE(signal.DisconnectAll() == 1);
+  ASSERT_TRUE(r1.CountSignalBindings() == 0);
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * A receiver deleted in its own slot, the next one is still called
+ */
+TEST_F(Test, delete_in_slot)
+{
+  ConcurrentSignal<int> signal;
+  Receiver *r1 = new Receiver;
+  Receiver r2;
+
+  signal.Connect(r1, &Receiver::OnDeleteThis);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  signal(1);
+
+  ASSERT_TRUE(r2.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+  // Freed when the emission left the epoch:
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * Receivers destroyed while other threads keep emitting, no slot is called after its destructor returns
+ */
+TEST_F(Test, destroy_while_emitting)
+{
+  typedef std::aligned_storage<sizeof(Receiver), alignof(Receiver)>::type Storage;
+  const int count = 2000;
+
+  ConcurrentSignal<int> signal;
+  std::vector<Storage> storage(count);  // kept alive to detect late calls
+  std::atomic<bool> stop(false);
+  std::atomic<long> emissions(0);
+  Receiver::violations_.store(0);
+
+  std::vector<std::thread> emitters;
+  for (int i = 0; i < 3; i++) {
+    emitters.emplace_back([&signal, &stop, &emissions]() {
+      while (!stop.load()) {
+        signal.Emit(1);
+        emissions++;
+      }
+    });
+  }
+
+  for (int i = 0; i < count; i++) {
+    Receiver *receiver = new(&storage[i]) Receiver;
+    signal.Connect(receiver, &Receiver::OnValue);
+    if (i % 16 == 0) std::this_thread::yield();
+    receiver->~Receiver();
+    receiver->set_destroyed();
+  }
+
+  stop.store(true);
+  for (auto &t : emitters) t.join();
+
+  ASSERT_TRUE(Receiver::violations_.load() == 0);
+  ASSERT_TRUE(signal.CountConnections() == 0);
+
+  EpochDomain::Reclaim();
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+  std::cout << emissions.load() << " emissions while destroying " << count << " receivers" << std::endl;
+}
+
+/*
+ * Two threads destroy receivers in their slots at the same time, they must not wait for each other
+ */
+TEST_F(Test, destroy_in_slots_of_two_threads)
+{
+  ConcurrentSignal<int> signal1;
+  ConcurrentSignal<int> signal2;
+  ConcurrentSignal<int> shared;
+  std::atomic<int> arrived(0);
+  Killer k1(&arrived, 2), k2(&arrived, 2);
+  Receiver *r1 = new Receiver;
+  Receiver *r2 = new Receiver;
+
+  shared.Connect(r1, &Receiver::OnValue);
+  shared.Connect(r2, &Receiver::OnValue);
+  k1.set_target(r1);
+  k2.set_target(r2);
+  signal1.Connect(&k1, &Killer::OnValue);
+  signal2.Connect(&k2, &Killer::OnValue);
+
+  std::thread t1([&signal1]() { signal1(1); });
+  std::thread t2([&signal2]() { signal2(2); });
+  t1.join();
+  t2.join();
+
+  ASSERT_TRUE(arrived.load() == 2);
+  ASSERT_TRUE(shared.CountConnections() == 0);
+  EpochDomain::Reclaim();
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * A receiver destroyed while another thread destroys a receiver in its slot: wait until that slot returns
+ */
+TEST_F(Test, nested_destroy_in_two_threads)
+{
+  ConcurrentSignal<int> blocking;
+  ConcurrentSignal<int> outer;
+  ConcurrentSignal<int> inner;
+  std::atomic<bool> blocker_inside(false);
+  std::atomic<bool> nester_inside(false);
+  Nester blocker(&blocker_inside, 100);
+  Nester *nester = new Nester(&nester_inside, 50);
+  Receiver *receiver = new Receiver;
+
+  blocking.Connect(&blocker, &Nester::OnValue);
+  outer.Connect(nester, &Nester::OnValue);
+  inner.Connect(receiver, &Receiver::OnValue);
+  nester->set_target(receiver);
+
+  // The first thread stays in a critical section, the second one waits for it while in the slot of the nester:
+  std::thread t1([&blocking]() { blocking(1); });
+  while (!blocker_inside.load()) std::this_thread::yield();
+  std::thread t2([&outer]() { outer(2); });
+  while (!nester_inside.load()) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  delete nester;
+  EXPECT_FALSE(nester_inside.load());
+
+  t1.join();
+  t2.join();
+  ASSERT_TRUE(outer.CountConnections() == 0 && inner.CountConnections() == 0);
+  EpochDomain::Reclaim();
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * A signal confined to one thread, receivers deleted in the slot are freed when the emission returns
+ */
+TEST_F(Test, confined)
+{
+  ConcurrentSignal<int> signal;
+  Receiver *r1 = new Receiver;
+  Receiver r2;
+
+  signal.SetThreadAffinity();
+  ASSERT_TRUE(signal.IsThreadConfined());
+
+  signal.Connect(r1, &Receiver::OnDeleteThis);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  signal(1);
+  ASSERT_TRUE(r2.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+
+  {
+    Receiver r3;
+    signal.Connect(&r3, &Receiver::OnValue);
+    signal(2);
+    ASSERT_TRUE(r3.count() == 1);
+  }
+  ASSERT_TRUE(signal.CountConnections() == 1);
+
+  // Back to the thread-safe path:
+  signal.ClearThreadAffinity();
+  std::thread worker([&signal]() { signal(3); });
+  worker.join();
+  ASSERT_TRUE(r2.count() == 3);
+}
@@ -0,0 +1,122 @@
+// Unit test code for ConcurrentSignal
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/concurrent_signal.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  enum State {
+    kAlive = 1,
+    kDestroyed = 2
+  };
+
+  Receiver ()
+      : state_(kAlive), count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    if (state_.load() != kAlive) violations_++;
+    count_++;
+  }
+
+  void OnDeleteThis (int n, __SLOT__)
+  {
+    count_++;
+    delete this;
+  }
+
+  void set_destroyed () { state_.store(kDestroyed); }
+
+  inline int count () const { return count_.load(); }
+
+  static std::atomic<int> violations_;
+
+ private:
+
+  std::atomic<int> state_;
+  std::atomic<int> count_;
+};
+
+/**
+ * @brief A receiver destroying another one in its slot once all threads have arrived
+ */
+class Killer: public sigcxx::Trackable
+{
+ public:
+
+  Killer (std::atomic<int> *arrived, int threads)
+      : arrived_(arrived), threads_(threads), target_(nullptr)
+  { }
+
+  virtual ~Killer () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    (*arrived_)++;
+    while (arrived_->load() < threads_) std::this_thread::yield();
+    delete target_;
+    target_ = nullptr;
+  }
+
+  void set_target (sigcxx::Trackable *target) { target_ = target; }
+
+ private:
+
+  std::atomic<int> *arrived_;
+  int threads_;
+  sigcxx::Trackable *target_;
+};
+
+/**
+ * @brief A receiver destroying another one in its slot, then staying in the slot for a while
+ */
+class Nester: public sigcxx::Trackable
+{
+ public:
+
+  Nester (std::atomic<bool> *inside, int delay_ms)
+      : inside_(inside), delay_ms_(delay_ms), target_(nullptr)
+  { }
+
+  virtual ~Nester () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    inside_->store(true);
+    delete target_;
+    target_ = nullptr;
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+    inside_->store(false);
+  }
+
+  void set_target (sigcxx::Trackable *target) { target_ = target; }
+
+ private:
+
+  std::atomic<bool> *inside_;
+  int delay_ms_;
+  sigcxx::Trackable *target_;
+};
@@ -0,0 +1,25 @@
+// Unit test code for constant-initialized signals
+
+#include "test.hpp"
+
+/*
+ * A plugin object connecting to a signal of another translation unit while
+ * being dynamically initialized, this file is linked before test.cpp
+ */
+class Plugin
+{
+ public:
+
+  Plugin ()
+  {
+    g_late_signal.Connect(&g_plugin_receiver, &Receiver::OnValue);
+    g_plugin_connected = g_late_signal.CountConnections() == 1;
+  }
+
+};
+
+Receiver g_plugin_receiver;
+
+bool g_plugin_connected = false;
+
+Plugin g_plugin;
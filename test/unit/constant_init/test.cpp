@@ -0,0 +1,71 @@
+// Unit test code for constant-initialized signals
+
+#include "test.hpp"
+
+using sigcxx::Signal;
+using sigcxx::Trackable;
+
+#ifdef __cpp_constinit
+constinit Signal<int> g_late_signal;
+constinit Signal<> g_empty_signal;
+constinit Trackable g_trackable;
+#else
+Signal<int> g_late_signal;
+Signal<> g_empty_signal;
+Trackable g_trackable;
+#endif
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * A global signal is ready before any dynamic initializer runs, a connection made from another file is kept
+ */
+TEST_F(Test, init_order)
+{
+  ASSERT_TRUE(g_plugin_connected);
+  ASSERT_TRUE(g_late_signal.CountConnections() == 1);
+
+  g_late_signal.Emit(3);
+  ASSERT_TRUE(g_plugin_receiver.count() == 3);
+}
+
+/*
+ * An empty global signal works as usual
+ */
+TEST_F(Test, global)
+{
+  ASSERT_TRUE(g_empty_signal.CountConnections() == 0);
+  ASSERT_TRUE(g_trackable.CountSignalBindings() == 0);
+  g_empty_signal.Emit();
+
+  Receiver receiver;
+  g_late_signal.Connect(&receiver, &Receiver::OnValue);
+  ASSERT_TRUE(g_late_signal.CountConnections() == 2);
+
+  g_late_signal.Emit(1);
+  ASSERT_TRUE(receiver.count() == 1);
+
+  g_late_signal.Disconnect(&receiver, &Receiver::OnValue);
+  ASSERT_TRUE(g_late_signal.CountConnections() == 1);
+}
+
+/*
+ * A function-static signal
+ */
+TEST_F(Test, function_static)
+{
+  static Signal<int> signal;
+  Receiver receiver;
+
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.Emit(2);
+  ASSERT_TRUE(receiver.count() == 2);
+}
@@ -0,0 +1,49 @@
+// Unit test code for constant-initialized signals
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_ += n;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
+
+/*
+ * Defined in test.cpp, connected by the dynamic initializer of a global in plugin.cpp
+ */
+extern sigcxx::Signal<int> g_late_signal;
+
+extern Receiver g_plugin_receiver;
+
+extern bool g_plugin_connected;
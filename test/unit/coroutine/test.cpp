@@ -0,0 +1,158 @@
+// Unit test code for awaiting signals in coroutines
+
+#include "test.hpp"
+
+#include <vector>
+
+using sigcxx::Signal;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+static Task WaitTwice(Signal<int, double> &signal, std::vector<int> *values, int *cancelled)
+{
+  for (int i = 0; i < 2; i++) {
+    auto args = co_await signal.Next();
+    if (!args) {
+      (*cancelled)++;
+      co_return;
+    }
+    values->push_back(std::get<0>(*args));
+  }
+}
+
+static Task WaitForEven(Signal<int, double> &signal, int *result)
+{
+  auto args = co_await signal.When([](int n, double) { return n % 2 == 0; });
+  *result = args ? std::get<0>(*args) : -1;
+}
+
+/*
+ * co_await Next() resumes with the arguments of each emission
+ */
+TEST_F(Test, await_next)
+{
+  Signal<int, double> signal;
+  std::vector<int> values;
+  int cancelled = 0;
+
+  Task task = WaitTwice(signal, &values, &cancelled);
+  ASSERT_FALSE(task.done());
+
+  signal.Emit(1, 0.5);
+  ASSERT_TRUE(values.size() == 1 && values[0] == 1);
+
+  signal.Emit(2, 0.5);
+  signal.Emit(3, 0.5);
+  ASSERT_TRUE(task.done() && values.size() == 2 && values[1] == 2);
+  ASSERT_TRUE(cancelled == 0);
+}
+
+/*
+ * co_await When() skips emissions not matching the predicate
+ */
+TEST_F(Test, await_when)
+{
+  Signal<int, double> signal;
+  int result = 0;
+
+  Task task = WaitForEven(signal, &result);
+
+  signal.Emit(1, 0.0);
+  signal.Emit(3, 0.0);
+  ASSERT_TRUE(result == 0 && !task.done());
+
+  signal.Emit(4, 0.0);
+  ASSERT_TRUE(result == 4 && task.done());
+}
+
+/*
+ * Waiting coroutines are resumed in the order they started
+ */
+TEST_F(Test, resume_in_order)
+{
+  Signal<int, double> signal;
+  std::vector<int> order;
+
+  auto wait = [](Signal<int, double> &s, std::vector<int> *order, int id) -> Task {
+    co_await s.Next();
+    order->push_back(id);
+  };
+
+  Task t1 = wait(signal, &order, 1);
+  Task t2 = wait(signal, &order, 2);
+  Task t3 = wait(signal, &order, 3);
+
+  signal.Emit(0, 0.0);
+  ASSERT_TRUE((order == std::vector<int>{1, 2, 3}));
+}
+
+/*
+ * Destroying the signal resumes waiting coroutines with an empty result
+ */
+TEST_F(Test, cancel_on_signal_destroyed)
+{
+  std::vector<int> values;
+  int cancelled = 0;
+  int result = 0;
+
+  auto *signal = new Signal<int, double>;
+  Task t1 = WaitTwice(*signal, &values, &cancelled);
+  Task t2 = WaitForEven(*signal, &result);
+
+  signal->Emit(1, 0.0);
+  delete signal;
+
+  ASSERT_TRUE(t1.done() && t2.done());
+  ASSERT_TRUE(values.size() == 1 && cancelled == 1 && result == -1);
+}
+
+/*
+ * Destroying a waiting coroutine unlinks its awaiter
+ */
+TEST_F(Test, destroy_waiting_coroutine)
+{
+  Signal<int, double> signal;
+  int result = 0;
+
+  {
+    Task task = WaitForEven(signal, &result);
+  }
+
+  signal.Emit(2, 0.0);
+  ASSERT_TRUE(result == 0);
+}
+
+/*
+ * A zero-argument signal deleted by its own slot still resumes the waiters
+ */
+class Closer : public sigcxx::Trackable {
+ public:
+  void OnClose(__SLOT__) { delete signal; }
+  Signal<> *signal = nullptr;
+};
+
+TEST_F(Test, signal_deleted_in_slot)
+{
+  Closer closer;
+  closer.signal = new Signal<>;
+  closer.signal->Connect(&closer, &Closer::OnClose);
+
+  bool resumed = false;
+  auto wait = [](Signal<> &s, bool *resumed) -> Task {
+    auto args = co_await s.Next();
+    *resumed = args.has_value();
+  };
+
+  Task task = wait(*closer.signal, &resumed);
+  closer.signal->Emit();
+
+  ASSERT_TRUE(task.done() && resumed);
+}
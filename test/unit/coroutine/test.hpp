@@ -0,0 +1,53 @@
+// Unit test code for awaiting signals in coroutines
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <coroutine>
+
+#include <sigcxx/coroutine.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+/**
+ * @brief A minimal coroutine type which starts immediately and can be destroyed by the caller.
+ */
+struct Task {
+
+  struct promise_type {
+    Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  explicit Task (std::coroutine_handle<promise_type> h)
+      : handle(h)
+  { }
+
+  Task (Task &&other) noexcept
+      : handle(other.handle)
+  {
+    other.handle = nullptr;
+  }
+
+  ~Task ()
+  {
+    if (handle) handle.destroy();
+  }
+
+  bool done () const { return handle.done(); }
+
+  std::coroutine_handle<promise_type> handle;
+};
@@ -0,0 +1,194 @@
+// Unit test code for Deque and CountedDeque
+
+#include "test.hpp"
+
+#include <memory>
+#include <vector>
+
+using sigcxx::Deque;
+using sigcxx::CountedDeque;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+template<typename DequeType>
+static std::vector<int> Values(const DequeType &deque)
+{
+  std::vector<int> values;
+  for (auto it = deque.cbegin(); it != deque.cend(); ++it) values.push_back(it->value());
+  return values;
+}
+
+/*
+ * Push, insert, pop and iterate
+ */
+TEST_F(Test, push)
+{
+  Node n1(1), n2(2), n3(3), n4(4);
+  Deque<Node> deque;
+  ASSERT_TRUE(deque.is_empty());
+  ASSERT_TRUE(nullptr == deque.front() && nullptr == deque.pop_back());
+
+  deque.push_back(&n2);
+  deque.push_front(&n1);
+  deque.push_back(&n4);
+  deque.insert(&n3, 2);
+  ASSERT_TRUE(Values(deque) == std::vector<int>({1, 2, 3, 4}));
+  ASSERT_TRUE(deque.count() == 4);
+  ASSERT_TRUE(deque.front() == &n1 && deque.back() == &n4);
+
+  // Negative positions from the end:
+  Node n5(5);
+  deque.insert(&n5, -2);
+  ASSERT_TRUE(Values(deque) == std::vector<int>({1, 2, 3, 5, 4}));
+  deque.insert(&n5, -6);
+  ASSERT_TRUE(Values(deque) == std::vector<int>({5, 1, 2, 3, 4}));
+  n5.unlink();
+
+  std::vector<int> reversed;
+  for (auto it = deque.rbegin(); it != deque.rend(); ++it) reversed.push_back(it->value());
+  ASSERT_TRUE(reversed == std::vector<int>({4, 3, 2, 1}));
+
+  ASSERT_TRUE(deque.pop_front() == &n1);
+  ASSERT_TRUE(deque.pop_back() == &n4);
+  ASSERT_TRUE(!n1.is_linked() && !n4.is_linked());
+  ASSERT_TRUE(Values(deque) == std::vector<int>({2, 3}));
+}
+
+/*
+ * Nodes leave the deque when unlinked, destroyed or pushed in another one
+ */
+TEST_F(Test, unlink)
+{
+  Deque<Node> deque;
+  Node n1(1), n3(3);
+  {
+    Node n2(2);
+    deque.push_back(&n1);
+    deque.push_back(&n2);
+    deque.push_back(&n3);
+  }
+  ASSERT_TRUE(Values(deque) == std::vector<int>({1, 3}));
+
+  n1.unlink();
+  ASSERT_TRUE(Values(deque) == std::vector<int>({3}));
+
+  Deque<Node> other;
+  other.push_back(&n3);
+  ASSERT_TRUE(deque.is_empty() && other.count() == 1);
+
+  // Unlinked when the deque is destroyed:
+  {
+    Deque<Node> tmp;
+    tmp.push_back(&n1);
+  }
+  ASSERT_TRUE(!n1.is_linked());
+}
+
+/*
+ * Erase nodes while iterating
+ */
+TEST_F(Test, erase)
+{
+  std::vector<std::unique_ptr<Node> > nodes;
+  Deque<Node> deque;
+  for (int i = 0; i < 10; i++) {
+    nodes.emplace_back(new Node(i));
+    deque.push_back(nodes.back().get());
+  }
+
+  for (auto it = deque.begin(); it != deque.end();) {
+    if (it->value() % 2) {
+      it = deque.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_TRUE(Values(deque) == std::vector<int>({0, 2, 4, 6, 8}));
+
+  // Destroy the node behind the iterator:
+  for (auto it = deque.begin(); it != deque.end();) {
+    Node *node = it.get();
+    ++it;
+    if (node->value() >= 4) nodes[node->value()].reset();
+  }
+  ASSERT_TRUE(Values(deque) == std::vector<int>({0, 2}));
+
+  for (auto it = deque.rbegin(); it != deque.rend();) it = deque.erase(it);
+  ASSERT_TRUE(deque.is_empty());
+}
+
+/*
+ * Splice in constant time
+ */
+TEST_F(Test, splice)
+{
+  Node n1(1), n2(2), n3(3);
+  Deque<Node> d1, d2;
+  d1.push_back(&n1);
+  d2.push_back(&n2);
+  d2.push_back(&n3);
+
+  d1.splice(d2);
+  ASSERT_TRUE(d2.is_empty());
+  ASSERT_TRUE(Values(d1) == std::vector<int>({1, 2, 3}));
+
+  d2.splice(d1);
+  ASSERT_TRUE(d1.is_empty());
+  ASSERT_TRUE(Values(d2) == std::vector<int>({1, 2, 3}));
+
+  d2.splice(d1);
+  d2.splice(d2);
+  ASSERT_TRUE(Values(d2) == std::vector<int>({1, 2, 3}));
+}
+
+/*
+ * The size of a CountedDeque follows the nodes leaving it
+ */
+TEST_F(Test, counted)
+{
+  CountedDeque<CountedNode> d1, d2;
+  CountedNode n1(1), n2(2);
+  {
+    CountedNode n3(3);
+    d1.push_back(&n1);
+    d1.push_back(&n2);
+    d1.push_front(&n3);
+    ASSERT_TRUE(d1.size() == 3);
+    ASSERT_TRUE(n3.deque() == &d1);
+    ASSERT_TRUE(Values(d1) == std::vector<int>({3, 1, 2}));
+  }
+  ASSERT_TRUE(d1.size() == 2);
+
+  n1.unlink();
+  ASSERT_TRUE(d1.size() == 1 && nullptr == n1.deque());
+
+  d2.push_back(&n1);
+  d2.insert(&n2, 0);
+  ASSERT_TRUE(d1.size() == 0 && d1.is_empty());
+  ASSERT_TRUE(d2.size() == 2);
+  ASSERT_TRUE(Values(d2) == std::vector<int>({2, 1}));
+
+  d1.splice(d2);
+  ASSERT_TRUE(d1.size() == 2 && d2.size() == 0);
+  ASSERT_TRUE(n1.deque() == &d1 && n2.deque() == &d1);
+
+  d1.erase(d1.begin());
+  ASSERT_TRUE(d1.size() == 1 && !n2.is_linked());
+
+  ASSERT_TRUE(d1.pop_back() == &n1);
+  ASSERT_TRUE(d1.size() == 0);
+
+  {
+    CountedDeque<CountedNode> tmp;
+    tmp.push_back(&n1);
+  }
+  ASSERT_TRUE(!n1.is_linked() && nullptr == n1.deque());
+}
@@ -0,0 +1,52 @@
+// Unit test code for Deque and CountedDeque
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/binode.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Node: public sigcxx::Binode<Node>
+{
+ public:
+
+  explicit Node (int value = 0)
+      : value_(value)
+  { }
+
+  virtual ~Node () { }
+
+  int value () const { return value_; }
+
+ private:
+
+  int value_;
+};
+
+class CountedNode: public sigcxx::CountedDequeNode<CountedNode>
+{
+ public:
+
+  explicit CountedNode (int value = 0)
+      : value_(value)
+  { }
+
+  virtual ~CountedNode () { }
+
+  int value () const { return value_; }
+
+ private:
+
+  int value_;
+};
@@ -0,0 +1,116 @@
+// Unit test code for EmbeddedConnection
+
+#include "test.hpp"
+
+#include <memory>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+using sigcxx::TrackableTeardownScope;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect and emit without allocating any node
+ */
+TEST_F(Test, connect)
+{
+  size_t nodes = NodeArena::GetStats().node_count;
+
+  Signal<int> signal;
+  Receiver r1, r2;
+  r1.Attach(signal);
+  r2.Attach(signal, 0);
+
+  ASSERT_TRUE(NodeArena::GetStats().node_count == nodes);
+  ASSERT_TRUE(r1.IsAttached() && r2.IsAttached());
+  ASSERT_TRUE(signal.CountConnections() == 2);
+  ASSERT_TRUE(r1.CountSignalBindings() == 1);
+  ASSERT_TRUE(signal.IsConnectedTo(&r1, &Receiver::OnValue));
+
+  signal.Emit(2);
+  ASSERT_TRUE(r1.sum() == 2 && r2.sum() == 2);
+
+  r1.Detach();
+  ASSERT_TRUE(!r1.IsAttached());
+  ASSERT_TRUE(signal.CountConnections() == 1);
+  ASSERT_TRUE(r1.CountSignalBindings() == 0);
+
+  // Connected again in the same storage:
+  r1.Attach(signal);
+  signal.Emit(1);
+  ASSERT_TRUE(r1.sum() == 3 && r2.sum() == 3);
+
+  // Connecting again breaks the previous connection:
+  Signal<int> other;
+  r1.Attach(other);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+  ASSERT_TRUE(other.CountConnections() == 1);
+}
+
+/*
+ * The connection is broken like others by the signal or the receiver
+ */
+TEST_F(Test, disconnect)
+{
+  Receiver r1, r2;
+  {
+    Signal<int> signal;
+    r1.Attach(signal);
+    r2.Attach(signal);
+
+    signal.Disconnect(&r1, &Receiver::OnValue);
+    ASSERT_TRUE(!r1.IsAttached());
+    ASSERT_TRUE(signal.CountConnections() == 1);
+
+    r1.Attach(signal);
+    r1.Unbind();
+    ASSERT_TRUE(!r1.IsAttached());
+    ASSERT_TRUE(signal.CountConnections() == 1);
+  }
+
+  // Destroyed with the signal:
+  ASSERT_TRUE(!r2.IsAttached());
+  ASSERT_TRUE(r2.CountSignalBindings() == 0);
+
+  Signal<int> signal;
+  {
+    Receiver r3;
+    r3.Attach(signal);
+    ASSERT_TRUE(signal.CountConnections() == 1);
+  }
+  ASSERT_TRUE(signal.CountConnections() == 0);
+}
+
+/*
+ * Disconnect in the slot it calls, or destroy receivers in a teardown scope
+ */
+TEST_F(Test, disconnect_in_slot)
+{
+  Signal<int> signal;
+  Receiver r1, r2;
+  r1.AttachAndDetachInSlot(signal);
+  r2.Attach(signal);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r1.count() == 1 && !r1.IsAttached());
+  ASSERT_TRUE(r2.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+
+  {
+    TrackableTeardownScope scope;
+    std::unique_ptr<Receiver> r3(new Receiver);
+    r3->Attach(signal);
+    r3.reset();
+    ASSERT_TRUE(scope.pending_count() == 0);
+    ASSERT_TRUE(signal.CountConnections() == 1);
+  }
+}
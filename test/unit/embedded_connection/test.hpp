@@ -0,0 +1,81 @@
+// Unit test code for EmbeddedConnection
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/embedded_connection.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+/**
+ * @brief A receiver with its connection as a member
+ */
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void Attach (sigcxx::Signal<int> &signal, int index = -1)
+  {
+    connection_.Connect(signal, this, &Receiver::OnValue, index);
+  }
+
+  void Detach ()
+  {
+    connection_.Disconnect();
+  }
+
+  bool IsAttached () const
+  {
+    return connection_.IsConnected();
+  }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnValueAndDetach (int n, __SLOT__)
+  {
+    count_++;
+    connection_.Disconnect();
+  }
+
+  void AttachAndDetachInSlot (sigcxx::Signal<int> &signal)
+  {
+    connection_.Connect(signal, this, &Receiver::OnValueAndDetach);
+  }
+
+  void Unbind ()
+  {
+    UnbindAllSignals();
+  }
+
+  int count () const { return count_; }
+
+  int sum () const { return sum_; }
+
+ private:
+
+  int count_;
+  int sum_;
+
+  sigcxx::EmbeddedConnection<sigcxx::Signal<int> > connection_;
+};
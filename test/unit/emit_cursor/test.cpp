@@ -0,0 +1,197 @@
+// Unit test code for EmitCursor
+
+#include "test.hpp"
+
+#include <memory>
+
+using sigcxx::Signal;
+using sigcxx::EmitCursor;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * An emission in slices of slots
+ */
+TEST_F(Test, resume)
+{
+  Signal<int> signal;
+  Receiver receivers[10];
+  for (auto &receiver : receivers) signal.Connect(&receiver, &Receiver::OnValue);
+
+  EmitCursor<int> cursor(signal, 5);
+  ASSERT_FALSE(cursor.IsDone());
+  ASSERT_TRUE(receivers[0].count() == 0);
+
+  ASSERT_FALSE(cursor.Resume(4));
+  ASSERT_TRUE(cursor.invoked_count() == 4);
+  ASSERT_TRUE(receivers[3].count() == 1 && receivers[4].count() == 0);
+
+  ASSERT_FALSE(cursor.Resume(4));
+  ASSERT_TRUE(cursor.Resume(4));
+  ASSERT_TRUE(cursor.IsDone() && cursor.invoked_count() == 10);
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver.count() == 1 && receiver.sum() == 5);
+
+  // Nothing more once done:
+  ASSERT_TRUE(cursor.Resume());
+  ASSERT_TRUE(receivers[0].count() == 1);
+
+  // An emission of a signal without connection is done at once:
+  Signal<int> empty;
+  EmitCursor<int> empty_cursor(empty, 1);
+  ASSERT_TRUE(empty_cursor.IsDone());
+}
+
+/*
+ * The arguments are copied into the cursor
+ */
+TEST_F(Test, arguments)
+{
+  Signal<const std::string &> signal;
+  Receiver receiver1, receiver2;
+  signal.Connect(&receiver1, &Receiver::OnText);
+  signal.Connect(&receiver2, &Receiver::OnText);
+
+  std::unique_ptr<EmitCursor<const std::string &> > cursor;
+  {
+    std::string text("frame");
+    cursor.reset(new EmitCursor<const std::string &>(signal, text));
+    ASSERT_FALSE(cursor->Resume(1));
+  }
+
+  ASSERT_TRUE(cursor->Resume(1));
+  ASSERT_TRUE(receiver1.text() == "frame" && receiver2.text() == "frame");
+}
+
+/*
+ * Connections broken or added between slices
+ */
+TEST_F(Test, disconnect_between_slices)
+{
+  Signal<int> signal;
+  Receiver *receivers[6];
+  for (auto &receiver : receivers) {
+    receiver = new Receiver;
+    signal.Connect(receiver, &Receiver::OnValue);
+  }
+
+  EmitCursor<int> cursor(signal, 1);
+  ASSERT_FALSE(cursor.Resume(2));
+
+  // The next one to call, one already called, and the one after the next:
+  delete receivers[2];
+  delete receivers[1];
+  signal.DisconnectAll(receivers[4], &Receiver::OnValue);
+
+  // Added after the position, it's called:
+  Receiver added;
+  signal.Connect(&added, &Receiver::OnValue);
+
+  ASSERT_TRUE(cursor.Resume());
+  ASSERT_TRUE(cursor.invoked_count() == 5);
+  ASSERT_TRUE(receivers[0]->count() == 1);
+  ASSERT_TRUE(receivers[3]->count() == 1);
+  ASSERT_TRUE(receivers[4]->count() == 0);
+  ASSERT_TRUE(receivers[5]->count() == 1);
+  ASSERT_TRUE(added.count() == 1);
+
+  for (int i : {0, 3, 4, 5}) delete receivers[i];
+}
+
+/*
+ * The cursor is done when the signal is destroyed between slices
+ */
+TEST_F(Test, destroy_signal)
+{
+  Receiver receivers[4];
+  std::unique_ptr<Signal<int> > signal(new Signal<int>);
+  for (auto &receiver : receivers) signal->Connect(&receiver, &Receiver::OnValue);
+
+  EmitCursor<int> cursor(*signal, 1);
+  ASSERT_FALSE(cursor.Resume(1));
+
+  signal.reset();
+  ASSERT_TRUE(cursor.Resume());
+  ASSERT_TRUE(cursor.invoked_count() == 1);
+  ASSERT_TRUE(receivers[1].count() == 0);
+}
+
+/*
+ * The last slot of a slice destroys the signal, the next slice is done without calling anything
+ */
+TEST_F(Test, destroy_signal_in_slot)
+{
+  Receiver receivers[4];
+  Signal<int> *signal = new Signal<int>;
+  signal->Connect(&receivers[0], &Receiver::OnValue);
+  signal->Connect(&receivers[1], &Receiver::OnDeleteSignal);
+  signal->Connect(&receivers[2], &Receiver::OnValue);
+  signal->Connect(&receivers[3], &Receiver::OnValue);
+
+  EmitCursor<int> cursor(*signal, 1);
+  ASSERT_TRUE(cursor.Resume(2));
+  ASSERT_TRUE(cursor.invoked_count() == 2);
+
+  ASSERT_TRUE(cursor.Resume());
+  ASSERT_TRUE(receivers[2].count() == 0 && receivers[3].count() == 0);
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver.CountSignalBindings() == 0);
+}
+
+/*
+ * Receivers and the signal destroyed in a TrackableTeardownScope between slices
+ */
+TEST_F(Test, destroy_signal_in_teardown_scope)
+{
+  std::unique_ptr<Receiver> receivers[4];
+  std::unique_ptr<Signal<int> > signal(new Signal<int>);
+  for (auto &receiver : receivers) {
+    receiver.reset(new Receiver);
+    signal->Connect(receiver.get(), &Receiver::OnValue);
+  }
+
+  EmitCursor<int> cursor(*signal, 1);
+  ASSERT_FALSE(cursor.Resume(1));
+
+  {
+    sigcxx::TrackableTeardownScope scope;
+    receivers[1].reset();
+    receivers[2].reset();
+    signal.reset();
+  }
+
+  ASSERT_TRUE(cursor.Resume());
+  ASSERT_TRUE(cursor.invoked_count() == 1);
+  ASSERT_TRUE(receivers[3]->count() == 0);
+  ASSERT_TRUE(receivers[3]->CountSignalBindings() == 0);
+}
+
+/*
+ * The last slot of a slice deletes its receiver, or stops the propagation
+ */
+TEST_F(Test, delete_and_stop)
+{
+  Signal<int> signal;
+  Receiver *deleted = new Receiver;
+  Receiver receiver1, stopper, receiver2;
+  signal.Connect(deleted, &Receiver::OnDeleteThis);
+  signal.Connect(&receiver1, &Receiver::OnValue);
+  signal.Connect(&stopper, &Receiver::OnStop);
+  signal.Connect(&receiver2, &Receiver::OnValue);
+
+  EmitCursor<int> cursor(signal, 1);
+  ASSERT_FALSE(cursor.Resume(1));
+  ASSERT_TRUE(signal.CountConnections() == 3);
+
+  ASSERT_FALSE(cursor.Resume(1));
+  ASSERT_TRUE(receiver1.count() == 1);
+
+  ASSERT_TRUE(cursor.Resume(1));
+  ASSERT_TRUE(stopper.count() == 1 && receiver2.count() == 0);
+}
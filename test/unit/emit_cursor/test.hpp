@@ -0,0 +1,72 @@
+// Unit test code for EmitCursor
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/emit_cursor.hpp>
+
+#include <string>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnText (const std::string &text, __SLOT__)
+  {
+    count_++;
+    text_ = text;
+  }
+
+  void OnStop (int n, __SLOT__)
+  {
+    count_++;
+    slot->StopPropagation();
+  }
+
+  void OnDeleteThis (int n, __SLOT__)
+  {
+    delete this;
+  }
+
+  void OnDeleteSignal (int n, __SLOT__)
+  {
+    count_++;
+    delete slot->signal<int>();
+  }
+
+  inline int count () const { return count_; }
+
+  inline long sum () const { return sum_; }
+
+  inline const std::string &text () const { return text_; }
+
+ private:
+
+  int count_;
+  long sum_;
+  std::string text_;
+};
@@ -0,0 +1,153 @@
+// Unit test code for EventBus
+
+#include "test.hpp"
+
+using sigcxx::EventBus;
+using sigcxx::EventId;
+using sigcxx::HashEventName;
+
+using namespace sigcxx::literals;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Names are hashed at compile time
+ */
+TEST_F(Test, hash)
+{
+  static_assert("order.filled"_ev == HashEventName("order.filled"), "Same hash");
+  static_assert("order.filled"_ev != "order.cancelled"_ev, "Different hashes");
+
+  // FNV-1a of an empty string and of "a":
+  static_assert(""_ev == 14695981039346656037ull, "FNV-1a offset basis");
+  static_assert("a"_ev == 0xaf63dc4c8601ec8cull, "FNV-1a of a");
+
+  std::string name("order.filled");
+  ASSERT_TRUE(HashEventName(name.c_str()) == "order.filled"_ev);
+  ASSERT_TRUE(std::string(sigcxx::EventTraits<"order.filled"_ev>::name()) == name);
+}
+
+/*
+ * Each event has its own typed channel
+ */
+TEST_F(Test, emit)
+{
+  EventBus bus;
+  Book book;
+
+  bus.channel<"order.filled"_ev>().Connect(&book, &Book::OnOrderFilled);
+  bus.channel<"order.cancelled"_ev>().Connect(&book, &Book::OnOrderCancelled);
+  bus.channel<"plugin.loaded"_ev>().Connect(&book, &Book::OnPluginLoaded);
+  bus.channel<"app.quit"_ev>().Connect(&book, &Book::OnQuit);
+  ASSERT_TRUE(bus.channel_count() == 4);
+
+  bus.Emit<"order.filled"_ev>(42, 10.5);
+  ASSERT_TRUE(book.count() == 1 && book.last_id() == 42 && book.last_price() == 10.5);
+
+  bus.Emit<"order.cancelled"_ev>(7);
+  ASSERT_TRUE(book.count() == 2 && book.last_id() == 7);
+
+  bus.Emit<"plugin.loaded"_ev>(std::string("shm_channel"));
+  ASSERT_TRUE(book.count() == 3 && book.last_name() == "shm_channel");
+
+  bus.Emit<"app.quit"_ev>();
+  ASSERT_TRUE(book.count() == 4);
+}
+
+/*
+ * Emitting an event nobody has connected to does nothing
+ */
+TEST_F(Test, no_channel)
+{
+  EventBus bus;
+  bus.Emit<"order.filled"_ev>(1, 2.0);
+
+  ASSERT_TRUE(bus.channel_count() == 0);
+  ASSERT_TRUE(bus.CountConnections<"order.filled"_ev>() == 0);
+}
+
+/*
+ * Connections are broken when the receiver or the bus is destroyed
+ */
+TEST_F(Test, disconnect)
+{
+  Book book;
+  {
+    EventBus bus;
+    {
+      Book temporary;
+      bus.channel<"order.cancelled"_ev>().Connect(&temporary, &Book::OnOrderCancelled);
+      bus.channel<"order.cancelled"_ev>().Connect(&book, &Book::OnOrderCancelled);
+      ASSERT_TRUE(bus.CountConnections<"order.cancelled"_ev>() == 2);
+    }
+
+    ASSERT_TRUE(bus.CountConnections<"order.cancelled"_ev>() == 1);
+    bus.Emit<"order.cancelled"_ev>(3);
+    ASSERT_TRUE(book.count() == 1);
+  }
+
+  ASSERT_TRUE(book.CountSignalBindings() == 0);
+}
+
+WIZTK_DECLARE_EVENT("bench.0", int);
+WIZTK_DECLARE_EVENT("bench.1", int);
+WIZTK_DECLARE_EVENT("bench.2", int);
+WIZTK_DECLARE_EVENT("bench.3", int);
+WIZTK_DECLARE_EVENT("bench.4", int);
+WIZTK_DECLARE_EVENT("bench.5", int);
+WIZTK_DECLARE_EVENT("bench.6", int);
+WIZTK_DECLARE_EVENT("bench.7", int);
+WIZTK_DECLARE_EVENT("bench.8", int);
+WIZTK_DECLARE_EVENT("bench.9", int);
+
+namespace {
+
+class Counter: public sigcxx::Trackable
+{
+ public:
+
+  void OnValue (int value, __SLOT__)
+  {
+    sum += value;
+  }
+
+  long sum = 0;
+};
+
+}  // namespace
+
+/*
+ * The table grows and keeps finding every channel
+ */
+TEST_F(Test, grow)
+{
+  EventBus bus;
+  Counter counter;
+
+  bus.channel<"bench.0"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.1"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.2"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.3"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.4"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.5"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.6"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.7"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.8"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"bench.9"_ev>().Connect(&counter, &Counter::OnValue);
+  bus.channel<"order.cancelled"_ev>().Connect(&counter, &Counter::OnValue);
+  ASSERT_TRUE(bus.channel_count() == 11);
+
+  bus.Emit<"bench.0"_ev>(1);
+  bus.Emit<"bench.5"_ev>(10);
+  bus.Emit<"bench.9"_ev>(100);
+  bus.Emit<"order.cancelled"_ev>(1000);
+  ASSERT_TRUE(counter.sum == 1111);
+}
@@ -0,0 +1,75 @@
+// Unit test code for EventBus
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/event_bus.hpp>
+
+#include <string>
+
+WIZTK_DECLARE_EVENT("order.filled", int, double);
+WIZTK_DECLARE_EVENT("order.cancelled", int);
+WIZTK_DECLARE_EVENT("plugin.loaded", const std::string &);
+WIZTK_DECLARE_EVENT("app.quit");
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Book: public sigcxx::Trackable
+{
+ public:
+
+  Book ()
+      : count_(0), last_id_(0), last_price_(0.0)
+  { }
+
+  virtual ~Book () { }
+
+  void OnOrderFilled (int id, double price, __SLOT__)
+  {
+    count_++;
+    last_id_ = id;
+    last_price_ = price;
+  }
+
+  void OnOrderCancelled (int id, __SLOT__)
+  {
+    count_++;
+    last_id_ = id;
+  }
+
+  void OnPluginLoaded (const std::string &name, __SLOT__)
+  {
+    count_++;
+    last_name_ = name;
+  }
+
+  void OnQuit (__SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+  inline int last_id () const { return last_id_; }
+
+  inline double last_price () const { return last_price_; }
+
+  inline const std::string &last_name () const { return last_name_; }
+
+ private:
+
+  int count_;
+  int last_id_;
+  double last_price_;
+  std::string last_name_;
+};
@@ -0,0 +1,142 @@
+// Unit test code for EventQueue and Signal::EmitAsync
+
+#include "test.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::EmitFuture;
+using sigcxx::EventQueue;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * A future is ready at once when all receivers are direct
+ */
+TEST_F(Test, emit_async_direct)
+{
+  Signal<int> signal;
+  Consumer consumer;
+
+  signal.Connect(&consumer, &Consumer::OnValue);
+
+  EmitFuture future = signal.EmitAsync(1);
+  ASSERT_TRUE(future.IsReady());
+  ASSERT_TRUE(consumer.count() == 1);
+
+  EmitFuture empty;
+  ASSERT_TRUE(empty.IsReady());
+}
+
+/*
+ * A future is ready when all queued calls have run, including the ones of a chained signal
+ */
+TEST_F(Test, emit_async_queued)
+{
+  Signal<const std::string &, int> signal;
+  Signal<const std::string &, int> chained;
+  Consumer direct, queued1, queued2;
+  EventQueue queue;
+
+  signal.Connect(&direct, &Consumer::OnMessage);
+  queue.Connect(signal, &queued1, &Consumer::OnMessage);
+  signal.Connect(chained);
+  queue.Connect(chained, &queued2, &Consumer::OnMessage);
+
+  EmitFuture future;
+  {
+    std::string text("hello");
+    future = signal.EmitAsync(text, 2);
+    text = "changed";
+  }
+
+  ASSERT_TRUE(direct.count() == 1);
+  ASSERT_TRUE(queued1.count() == 0 && queued2.count() == 0);
+  ASSERT_TRUE(queue.pending_count() == 2);
+  ASSERT_TRUE(!future.IsReady());
+  ASSERT_TRUE(!future.WaitFor(1));
+
+  ASSERT_TRUE(queue.ProcessEvents() == 2);
+  ASSERT_TRUE(future.IsReady());
+  ASSERT_TRUE(queued1.last() == "hello" && queued2.last() == "hello");
+  ASSERT_TRUE(queued1.sum() == 2 && queued2.sum() == 2);
+
+  // Emit() is queued as well but not tracked:
+  signal.Emit("again", 3);
+  ASSERT_TRUE(queue.ProcessEvents() == 2);
+  ASSERT_TRUE(queued1.count() == 2);
+}
+
+/*
+ * Calls to a disconnected receiver or a destroyed queue are dropped and complete the future
+ */
+TEST_F(Test, dropped_calls)
+{
+  Signal<int> signal;
+  EmitFuture future1, future2;
+
+  {
+    Consumer consumer;
+    EventQueue queue;
+    queue.Connect(signal, &consumer, &Consumer::OnValue);
+
+    {
+      Consumer temp;
+      queue.Connect(signal, &temp, &Consumer::OnValue);
+      future1 = signal.EmitAsync(1);
+      ASSERT_TRUE(signal.CountConnections() == 2);
+    }
+    ASSERT_TRUE(signal.CountConnections() == 1);
+
+    ASSERT_TRUE(queue.ProcessEvents() == 2);
+    ASSERT_TRUE(future1.IsReady());
+    ASSERT_TRUE(consumer.count() == 1);
+
+    future2 = signal.EmitAsync(2);
+    ASSERT_TRUE(!future2.IsReady());
+  }
+
+  ASSERT_TRUE(future2.IsReady());
+  ASSERT_TRUE(signal.CountConnections() == 0);
+}
+
+/*
+ * Wait for a worker thread processing the queue
+ */
+TEST_F(Test, wait_in_another_thread)
+{
+  const int count = 1000;
+  Signal<int> signal;
+  Consumer consumer;
+  EventQueue queue;
+  std::atomic<bool> stop(false);
+
+  queue.Connect(signal, &consumer, &Consumer::OnValue);
+
+  std::thread worker([&queue, &stop]() {
+    while (!stop.load()) {
+      if (queue.WaitForEvents(10)) queue.ProcessEvents();
+    }
+    queue.ProcessEvents();
+  });
+
+  for (int i = 0; i < count; i++) {
+    EmitFuture future = signal.EmitAsync(i);
+    future.Wait();
+    ASSERT_TRUE(consumer.count() == i + 1);
+  }
+
+  stop.store(true);
+  worker.join();
+  ASSERT_TRUE(consumer.sum() == (long) count * (count - 1) / 2);
+}
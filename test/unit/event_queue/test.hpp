@@ -0,0 +1,57 @@
+// Unit test code for EventQueue and Signal::EmitAsync
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/event_queue.hpp>
+
+#include <atomic>
+#include <string>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Consumer: public sigcxx::Trackable
+{
+ public:
+
+  Consumer ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Consumer () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnMessage (const std::string &text, int n, __SLOT__)
+  {
+    count_++;
+    last_ = text;
+    sum_ += n;
+  }
+
+  inline int count () const { return count_.load(); }
+
+  inline long sum () const { return sum_.load(); }
+
+  inline const std::string &last () const { return last_; }
+
+ private:
+
+  std::atomic<int> count_;
+  std::atomic<long> sum_;
+  std::string last_;
+};
@@ -0,0 +1,161 @@
+// Unit test code for connecting static functions
+
+#include "test.hpp"
+
+#include <memory>
+
+using sigcxx::Signal;
+using sigcxx::SLOT;
+using sigcxx::FunctionHandle;
+using sigcxx::NodeArena;
+using sigcxx::TrackableTeardownScope;
+
+namespace {
+
+int count = 0;
+int sum = 0;
+
+Signal<int> *target = nullptr;
+FunctionHandle handle;
+
+void OnValue(int n) {
+  count++;
+  sum += n;
+}
+
+void OnValueAndStop(int n, SLOT slot) {
+  count++;
+  slot->StopPropagation();
+}
+
+void OnValueAndDisconnect(int n) {
+  count++;
+  target->Disconnect(handle);
+}
+
+void OnValueAndDeleteSignal(int n) {
+  count++;
+  delete target;
+  target = nullptr;
+}
+
+}  // namespace
+
+Test::Test()
+    : testing::Test()
+{
+  count = 0;
+  sum = 0;
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect a function and a lambda, each connection is one token
+ */
+TEST_F(Test, connect)
+{
+  Signal<int> signal;
+  size_t nodes = NodeArena::GetStats().node_count;
+
+  FunctionHandle h1 = signal.Connect(OnValue);
+  FunctionHandle h2 = signal.Connect([](int n) { sum += 10 * n; }, 0);
+  ASSERT_TRUE(NodeArena::GetStats().node_count == nodes + 2);
+  ASSERT_TRUE(h1 && h2);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+  ASSERT_TRUE(signal.IsConnectedTo(h1) && signal.IsConnectedTo(h2));
+
+  signal.Emit(1);
+  ASSERT_TRUE(count == 1 && sum == 11);
+
+  ASSERT_TRUE(signal.Disconnect(h2));
+  ASSERT_TRUE(!signal.Disconnect(h2));
+  ASSERT_TRUE(!signal.IsConnectedTo(h2));
+  ASSERT_TRUE(!signal.Disconnect(FunctionHandle()));
+  ASSERT_TRUE(NodeArena::GetStats().node_count == nodes + 1);
+
+  // A handle of another signal matches nothing:
+  Signal<int> other;
+  ASSERT_TRUE(!other.IsConnectedTo(h1));
+
+  signal.Emit(1);
+  ASSERT_TRUE(count == 2 && sum == 12);
+}
+
+/*
+ * A function taking the SLOT parameter can stop the propagation
+ */
+TEST_F(Test, slot)
+{
+  Signal<int> signal;
+  signal.Connect(OnValueAndStop);
+  signal.Connect(OnValue);
+  signal.Connect([](int n, SLOT slot) { sum += n; }, 0);
+
+  signal.Emit(5);
+  ASSERT_TRUE(count == 1 && sum == 5);
+}
+
+/*
+ * Disconnect the function being called, or delete the signal
+ */
+TEST_F(Test, disconnect_in_slot)
+{
+  target = new Signal<int>;
+  handle = target->Connect(OnValueAndDisconnect);
+  target->Connect(OnValue);
+
+  target->Emit(1);
+  ASSERT_TRUE(count == 2);
+  ASSERT_TRUE(target->CountConnections() == 1);
+
+  target->Connect(OnValueAndDeleteSignal, 0);
+  target->Emit(1);
+  ASSERT_TRUE(count == 3);
+  ASSERT_TRUE(nullptr == target);
+}
+
+/*
+ * Function connections are broken by the signal only
+ */
+TEST_F(Test, disconnect)
+{
+  Signal<int> signal;
+  signal.Connect(OnValue);
+  signal.Connect(OnValue);
+  signal.Connect(OnValue);
+
+  {
+    TrackableTeardownScope scope;
+    std::unique_ptr<FunctionReceiver> receiver(new FunctionReceiver(OnValue));
+    signal.Connect(receiver.get(), &FunctionReceiver::OnValue);
+    receiver.reset();
+    ASSERT_TRUE(signal.CountConnections() == 3);
+  }
+
+  ASSERT_TRUE(signal.Disconnect(0, 1) == 1);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+
+  signal.DisconnectAll();
+  ASSERT_TRUE(signal.CountConnections() == 0);
+}
+
+/*
+ * A handle doesn't match a new connection to the same function reusing the memory of its token
+ */
+TEST_F(Test, stale_handle)
+{
+  Signal<int> signal;
+
+  FunctionHandle h1 = signal.Connect(OnValue);
+  ASSERT_TRUE(signal.Disconnect(h1));
+
+  FunctionHandle h2 = signal.Connect(OnValue);
+  ASSERT_TRUE(!signal.IsConnectedTo(h1));
+  ASSERT_TRUE(!signal.Disconnect(h1));
+  ASSERT_TRUE(signal.IsConnectedTo(h2));
+  ASSERT_TRUE(signal.CountConnections() == 1);
+}
@@ -0,0 +1,41 @@
+// Unit test code for connecting static functions
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+/**
+ * @brief The usual workaround: a Trackable object only to call a function
+ */
+class FunctionReceiver: public sigcxx::Trackable
+{
+ public:
+
+  explicit FunctionReceiver (void (*function)(int))
+      : function_(function)
+  { }
+
+  virtual ~FunctionReceiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    function_(n);
+  }
+
+ private:
+
+  void (*function_)(int);
+};
@@ -0,0 +1,198 @@
+// Unit test code for Signal interceptors
+
+#include "test.hpp"
+
+#include <sigcxx/emit_cursor.hpp>
+
+using sigcxx::Signal;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+namespace {
+
+int g_static_calls = 0;
+
+bool CountCall(int &n)
+{
+  g_static_calls++;
+  return true;
+}
+
+}  // namespace
+
+/*
+ * Interceptors are called before the slots and can cancel an emission
+ */
+TEST_F(Test, cancel)
+{
+  Signal<int> signal;
+  Receiver receiver;
+  Guard guard;
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.AddInterceptor(&guard, &Guard::CheckLimit);
+  ASSERT_TRUE(signal.CountInterceptors() == 1);
+
+  signal.Emit(50);
+  signal.Emit(150);
+  signal.Emit(100);
+
+  ASSERT_TRUE(guard.log().size() == 3);
+  ASSERT_TRUE(receiver.count() == 2 && receiver.sum() == 150);
+}
+
+/*
+ * Interceptors run in order and can rewrite the arguments passed by value
+ */
+TEST_F(Test, transform)
+{
+  Signal<int> signal;
+  Receiver receiver;
+  Guard guard;
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.AddInterceptor(&guard, &Guard::Double);
+  signal.AddInterceptor(&guard, &Guard::CheckLimit);
+
+  signal.Emit(30);  // 60
+  signal.Emit(60);  // 120, cancelled
+
+  ASSERT_TRUE(guard.log().size() == 2 && guard.log()[0] == 60 && guard.log()[1] == 120);
+  ASSERT_TRUE(receiver.count() == 1 && receiver.sum() == 60);
+
+  // Arguments passed by reference are seen, not copied:
+  Signal<int, const std::string &> text_signal;
+  text_signal.Connect(&receiver, &Receiver::OnText);
+  text_signal.AddInterceptor(&guard, &Guard::LogText);
+  text_signal.Emit(1, "hello");
+  ASSERT_TRUE(guard.texts().size() == 1 && guard.texts()[0] == "hello");
+  ASSERT_TRUE(receiver.text() == "hello");
+}
+
+/*
+ * Remove interceptors, static functions as interceptors
+ */
+TEST_F(Test, remove)
+{
+  Signal<int> signal;
+  Receiver receiver;
+  Guard guard;
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.AddInterceptor(&guard, &Guard::Double);
+  signal.AddInterceptor(&CountCall);
+  ASSERT_TRUE(signal.CountInterceptors() == 2);
+
+  g_static_calls = 0;
+  signal.Emit(1);
+  ASSERT_TRUE(g_static_calls == 1 && receiver.sum() == 2);
+
+  ASSERT_TRUE(signal.RemoveInterceptor(&guard, &Guard::Double));
+  ASSERT_FALSE(signal.RemoveInterceptor(&guard, &Guard::Double));
+  signal.Emit(1);
+  ASSERT_TRUE(g_static_calls == 2 && receiver.sum() == 3);
+
+  ASSERT_TRUE(signal.RemoveInterceptor(&CountCall));
+  ASSERT_TRUE(signal.CountInterceptors() == 0);
+  signal.Emit(1);
+  ASSERT_TRUE(g_static_calls == 2 && receiver.sum() == 4);
+}
+
+/*
+ * An interceptor removing itself, the next one is still called
+ */
+TEST_F(Test, remove_in_interceptor)
+{
+  Signal<int> signal;
+  Receiver receiver;
+  Guard guard;
+  guard.set_signal(&signal);
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.AddInterceptor(&guard, &Guard::RemoveSelf);
+  signal.AddInterceptor(&CountCall);
+
+  g_static_calls = 0;
+  signal.Emit(1);
+  ASSERT_TRUE(guard.log().size() == 1 && g_static_calls == 1);
+  ASSERT_TRUE(receiver.count() == 1);
+  ASSERT_TRUE(signal.CountInterceptors() == 1);
+
+  signal.Emit(1);
+  ASSERT_TRUE(guard.log().size() == 1 && g_static_calls == 2);
+  ASSERT_TRUE(receiver.count() == 2);
+}
+
+/*
+ * An interceptor throwing ends the run, the ones removed meanwhile are still erased
+ */
+TEST_F(Test, throw_in_interceptor)
+{
+  typedef sigcxx::internal::InterceptorChain<int> ChainType;
+
+  Guard guard;
+  ChainType chain;
+  chain.interceptors.push_back(ChainType::DelegateType::FromStatic(&CountCall));
+  chain.interceptors.push_back(ChainType::DelegateType::FromMethod(&guard, &Guard::Throw));
+
+  int n = 1;
+  ASSERT_THROW(chain.Run(n), std::runtime_error);
+  ASSERT_TRUE(chain.running == 0);
+
+  ASSERT_TRUE(chain.Remove(ChainType::DelegateType::FromMethod(&guard, &Guard::Throw)));
+  ASSERT_TRUE(chain.interceptors.size() == 1 && chain.size() == 1);
+
+  g_static_calls = 0;
+  ASSERT_TRUE(chain.Run(n));
+  ASSERT_TRUE(g_static_calls == 1);
+
+  // Through a signal:
+  Signal<int> signal;
+  Receiver receiver;
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal.AddInterceptor(&guard, &Guard::Throw);
+  ASSERT_THROW(signal.Emit(1), std::runtime_error);
+  ASSERT_TRUE(signal.RemoveInterceptor(&guard, &Guard::Throw));
+  signal.Emit(2);
+  ASSERT_TRUE(receiver.sum() == 2);
+}
+
+/*
+ * A chained signal applies its own interceptors, an EmitCursor runs them once
+ */
+TEST_F(Test, chain_and_cursor)
+{
+  Signal<int> signal1;
+  Signal<int> signal2;
+  Receiver receiver1;
+  Receiver receiver2;
+  Guard guard;
+  guard.set_limit(10);
+
+  signal1.Connect(&receiver1, &Receiver::OnValue);
+  signal1.Connect(signal2);
+  signal2.Connect(&receiver2, &Receiver::OnValue);
+  signal2.AddInterceptor(&guard, &Guard::CheckLimit);
+
+  signal1.Emit(20);
+  ASSERT_TRUE(receiver1.count() == 1 && receiver2.count() == 0);
+
+  Signal<int> signal3;
+  Receiver receivers[4];
+  for (auto &receiver : receivers) signal3.Connect(&receiver, &Receiver::OnValue);
+  signal3.AddInterceptor(&guard, &Guard::Double);
+
+  sigcxx::EmitCursor<int> cursor(signal3, 3);
+  ASSERT_FALSE(cursor.Resume(2));
+  ASSERT_TRUE(cursor.Resume(2));
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver.sum() == 6);
+
+  signal3.AddInterceptor(&guard, &Guard::CheckLimit);
+  sigcxx::EmitCursor<int> cancelled(signal3, 6);
+  ASSERT_TRUE(cancelled.IsDone());
+  ASSERT_TRUE(receivers[0].count() == 1);
+}
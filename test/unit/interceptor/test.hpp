@@ -0,0 +1,114 @@
+// Unit test code for Signal interceptors
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnText (int n, const std::string &text, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+    text_ = text;
+  }
+
+  inline int count () const { return count_; }
+
+  inline long sum () const { return sum_; }
+
+  inline const std::string &text () const { return text_; }
+
+ private:
+
+  int count_;
+  long sum_;
+  std::string text_;
+};
+
+class Guard
+{
+ public:
+
+  Guard ()
+      : limit_(100), signal_(nullptr)
+  { }
+
+  bool CheckLimit (int &n)
+  {
+    log_.push_back(n);
+    return n <= limit_;
+  }
+
+  bool Double (int &n)
+  {
+    n *= 2;
+    return true;
+  }
+
+  bool LogText (int &n, const std::string &text)
+  {
+    log_.push_back(n);
+    texts_.push_back(text);
+    return true;
+  }
+
+  bool Throw (int &n)
+  {
+    log_.push_back(n);
+    throw std::runtime_error("intercepted");
+  }
+
+  bool RemoveSelf (int &n)
+  {
+    log_.push_back(n);
+    signal_->RemoveInterceptor(this, &Guard::RemoveSelf);
+    return true;
+  }
+
+  inline void set_limit (int limit) { limit_ = limit; }
+
+  inline void set_signal (sigcxx::Signal<int> *signal) { signal_ = signal; }
+
+  inline const std::vector<int> &log () const { return log_; }
+
+  inline const std::vector<std::string> &texts () const { return texts_; }
+
+ private:
+
+  int limit_;
+  std::vector<int> log_;
+  std::vector<std::string> texts_;
+  sigcxx::Signal<int> *signal_;
+};
@@ -0,0 +1,133 @@
+// Unit test code for NodeArena
+
+#include "test.hpp"
+
+#include <memory>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+using sigcxx::NodeArenaStats;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connections are counted in the arena, and every other disconnection leaves the pages half used
+ */
+TEST_F(Test, stats)
+{
+  const size_t count = 20000;
+
+  NodeArena::TrimMemory();
+  NodeArenaStats base = NodeArena::GetStats();
+  ASSERT_TRUE(base.empty_page_count == 0);
+
+  Signal<int> signal;
+  std::vector<std::unique_ptr<Receiver> > receivers;
+  for (size_t i = 0; i < count; i++) {
+    receivers.emplace_back(new Receiver);
+    signal.Connect(receivers.back().get(), &Receiver::OnValue);
+  }
+
+  // A token and a binding for each connection:
+  NodeArenaStats stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.node_count == base.node_count + 2 * count);
+  ASSERT_TRUE(stats.page_count > base.page_count);
+  ASSERT_TRUE(stats.reserved_bytes == stats.page_count * sigcxx::internal::NodePool::kPageSize);
+  ASSERT_TRUE(stats.fragmentation() < 0.1);
+
+  for (size_t i = 0; i < count; i += 2) receivers[i].reset();
+
+  stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.node_count == base.node_count + count);
+  ASSERT_TRUE(stats.fragmentation() > 0.4);
+
+  receivers.clear();
+  stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.node_count == base.node_count);
+}
+
+/*
+ * Compact() moves the bindings into fewer pages, the connections still work
+ */
+TEST_F(Test, compact)
+{
+  const size_t count = 20000;
+
+  Signal<int> signal1;
+  Signal<int> signal2;
+  std::vector<std::unique_ptr<Receiver> > receivers;
+  for (size_t i = 0; i < count; i++) {
+    receivers.emplace_back(new Receiver);
+    signal1.Connect(receivers.back().get(), &Receiver::OnValue);
+    signal2.Connect(receivers.back().get(), &Receiver::OnValue);
+  }
+  for (size_t i = 0; i < count; i += 2) receivers[i].reset();
+
+  NodeArenaStats before = NodeArena::GetStats();
+  size_t moved = NodeArena::Compact();
+  NodeArenaStats after = NodeArena::GetStats();
+
+  ASSERT_TRUE(moved > 0);
+  ASSERT_TRUE(after.node_count == before.node_count);
+  ASSERT_TRUE(after.page_count < before.page_count);
+  ASSERT_TRUE(after.fragmentation() < before.fragmentation());
+  ASSERT_TRUE(after.empty_page_count == 0);
+
+  signal1.Emit(1);
+  signal2.Emit(2);
+  for (size_t i = 1; i < count; i += 2) {
+    ASSERT_TRUE(receivers[i]->count() == 2 && receivers[i]->sum() == 3);
+    ASSERT_TRUE(receivers[i]->CountSignalBindings() == 2);
+  }
+  ASSERT_TRUE(signal1.CountConnections() == count / 2);
+
+  // Disconnect from both sides after the move:
+  signal1.DisconnectAll();
+  for (size_t i = 1; i < count; i += 2) ASSERT_TRUE(receivers[i]->CountSignalBindings() == 1);
+  for (size_t i = 1; i < count; i += 4) receivers[i].reset();
+  ASSERT_TRUE(signal2.CountConnections() == count / 4);
+
+  signal2.Emit(1);
+  for (size_t i = 3; i < count; i += 4) ASSERT_TRUE(receivers[i]->count() == 3);
+}
+
+/*
+ * TrimMemory() returns the empty pages
+ */
+TEST_F(Test, trim_memory)
+{
+  const size_t count = 20000;
+
+  NodeArena::TrimMemory();
+  NodeArenaStats base = NodeArena::GetStats();
+
+  {
+    Signal<int> signal;
+    std::vector<std::unique_ptr<Receiver> > receivers;
+    for (size_t i = 0; i < count; i++) {
+      receivers.emplace_back(new Receiver);
+      signal.Connect(receivers.back().get(), &Receiver::OnValue);
+    }
+  }
+
+  NodeArenaStats stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.node_count == base.node_count);
+  ASSERT_TRUE(stats.empty_page_count > 0);
+
+  size_t bytes = NodeArena::TrimMemory();
+  ASSERT_TRUE(bytes == stats.empty_page_count * sigcxx::internal::NodePool::kPageSize);
+
+  stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.empty_page_count == 0);
+  ASSERT_TRUE(stats.page_count == base.page_count);
+  ASSERT_TRUE(NodeArena::TrimMemory() == 0);
+}
@@ -0,0 +1,180 @@
+// Unit test code for Property
+
+#include "test.hpp"
+
+#include <memory>
+#include <string>
+
+using sigcxx::Signal;
+using sigcxx::Property;
+using sigcxx::PropertyTransaction;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Setting an equal value emits nothing
+ */
+TEST_F(Test, suppress)
+{
+  Property<int> width(100);
+  Observer observer;
+
+  ASSERT_FALSE(width.IsObserved());
+  width.changed().Connect(&observer, &Observer::OnChanged);
+  ASSERT_TRUE(width.IsObserved());
+
+  ASSERT_TRUE(width.Set(200));
+  ASSERT_FALSE(width.Set(200));
+  width = 200;
+  width = 300;
+
+  ASSERT_TRUE(observer.count() == 2);
+  ASSERT_TRUE(observer.values()[0] == 200 && observer.values()[1] == 300);
+  ASSERT_TRUE(width.value() == 300);
+
+  Property<std::string> title("sigcxx");
+  ASSERT_FALSE(title.Set(std::string("sigcxx")));
+  ASSERT_TRUE(title.Set(std::string("wiztk")));
+  ASSERT_TRUE(title.value() == "wiztk");
+}
+
+/*
+ * An unobserved property is a value and a pointer
+ */
+TEST_F(Test, compact)
+{
+  Property<int> value;
+  value = 1;
+
+  ASSERT_FALSE(value.IsObserved());
+  ASSERT_TRUE(sizeof(Property<int>) == sizeof(int *) * 2);
+  ASSERT_TRUE(sizeof(Property<int>) < sizeof(Signal<const int &>));
+}
+
+/*
+ * Notifications are sent once at commit, with the final value
+ */
+TEST_F(Test, transaction)
+{
+  Property<int> width(0);
+  Property<int> height(0);
+  Observer observer;
+  width.changed().Connect(&observer, &Observer::OnChanged);
+  height.changed().Connect(&observer, &Observer::OnChanged);
+
+  {
+    PropertyTransaction transaction;
+    ASSERT_TRUE(PropertyTransaction::current() == &transaction);
+
+    width = 640;
+    height = 480;
+    width = 800;
+    ASSERT_TRUE(transaction.pending_count() == 2);
+    ASSERT_TRUE(observer.count() == 0);
+    ASSERT_TRUE(width.value() == 800);
+  }
+
+  ASSERT_TRUE(PropertyTransaction::current() == nullptr);
+  ASSERT_TRUE(observer.count() == 2);
+  ASSERT_TRUE(observer.values()[0] == 800 && observer.values()[1] == 480);
+
+  width = 1024;
+  ASSERT_TRUE(observer.count() == 3);
+}
+
+/*
+ * A nested transaction joins the outermost one
+ */
+TEST_F(Test, nested)
+{
+  Property<int> value(0);
+  Observer observer;
+  value.changed().Connect(&observer, &Observer::OnChanged);
+
+  {
+    PropertyTransaction outer;
+    {
+      PropertyTransaction inner;
+      ASSERT_TRUE(PropertyTransaction::current() == &outer);
+      value = 1;
+      ASSERT_TRUE(inner.pending_count() == 1);
+    }
+    ASSERT_TRUE(observer.count() == 0);
+    value = 2;
+  }
+
+  ASSERT_TRUE(observer.count() == 1);
+  ASSERT_TRUE(observer.values()[0] == 2);
+}
+
+/*
+ * A property destroyed before the commit cancels its notification
+ */
+TEST_F(Test, destroy_in_transaction)
+{
+  Observer observer;
+  Property<int> kept(0);
+  kept.changed().Connect(&observer, &Observer::OnChanged);
+
+  {
+    PropertyTransaction transaction;
+    std::unique_ptr<Property<int> > destroyed(new Property<int>(0));
+    destroyed->changed().Connect(&observer, &Observer::OnChanged);
+
+    *destroyed = 1;
+    kept = 2;
+    destroyed.reset();
+    ASSERT_TRUE(transaction.pending_count() == 1);
+  }
+
+  ASSERT_TRUE(observer.count() == 1);
+  ASSERT_TRUE(observer.values()[0] == 2);
+}
+
+class Mirror: public sigcxx::Trackable
+{
+ public:
+
+  explicit Mirror (Property<int> *target)
+      : target_(target)
+  { }
+
+  void OnChanged (const int &value, __SLOT__)
+  {
+    target_->Set(value * 2);
+  }
+
+ private:
+
+  Property<int> *target_;
+};
+
+/*
+ * A property changed by a slot during the commit is notified in the same commit
+ */
+TEST_F(Test, change_in_commit)
+{
+  Property<int> source(0);
+  Property<int> target(0);
+  Mirror mirror(&target);
+  Observer observer;
+  source.changed().Connect(&mirror, &Mirror::OnChanged);
+  target.changed().Connect(&observer, &Observer::OnChanged);
+
+  {
+    PropertyTransaction transaction;
+    source = 1;
+    source = 2;
+  }
+
+  ASSERT_TRUE(observer.count() == 1);
+  ASSERT_TRUE(observer.values()[0] == 4);
+}
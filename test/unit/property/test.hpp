@@ -0,0 +1,46 @@
+// Unit test code for Property
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/property.hpp>
+
+#include <vector>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Observer: public sigcxx::Trackable
+{
+ public:
+
+  Observer ()
+      : count_(0)
+  { }
+
+  virtual ~Observer () { }
+
+  void OnChanged (const int &value, __SLOT__)
+  {
+    count_++;
+    values_.push_back(value);
+  }
+
+  inline int count () const { return count_; }
+
+  inline const std::vector<int> &values () const { return values_; }
+
+ private:
+
+  int count_;
+  std::vector<int> values_;
+};
@@ -0,0 +1,226 @@
+// Unit test code for EmissionRecorder and EmissionReplayer
+
+#include "test.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+using sigcxx::Signal;
+using sigcxx::EmissionRecorder;
+using sigcxx::EmissionReplayer;
+
+static std::string LogPath(const char *suffix)
+{
+  return "/tmp/sigcxx_test_" + std::to_string(getpid()) + "_" + suffix + ".log";
+}
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Record 2 signals and replay into other signals
+ */
+TEST_F(Test, record_and_replay)
+{
+  std::string path = LogPath("replay");
+  Signal<const Size &> resized;
+  Signal<int, int, bool> clicked;
+  Signal<> ignored;
+  Widget origin;
+
+  resized.Connect(&origin, &Widget::OnResized);
+  clicked.Connect(&origin, &Widget::OnClicked);
+
+  {
+    EmissionRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.c_str(), 64));   // force the log to grow
+    recorder.Record(resized, 1);
+    recorder.Record(clicked, 0xFFFFFFF0);
+    recorder.Record(ignored, 3);
+
+    for (int i = 0; i < 1000; i++) {
+      resized(Size{i, i + 1});
+      clicked(i, 2, (i % 2) == 0);
+      ignored();
+    }
+
+    ASSERT_TRUE(recorder.record_count() == 3000);
+  }
+
+  // Signals are disconnected from the closed recorder
+  ASSERT_TRUE(resized.CountConnections() == 1 && clicked.CountConnections() == 1);
+
+  Signal<const Size &> replayed_resized;
+  Signal<int, int, bool> replayed_clicked;
+  Widget copy;
+
+  replayed_resized.Connect(&copy, &Widget::OnResized);
+  replayed_clicked.Connect(&copy, &Widget::OnClicked);
+
+  EmissionReplayer replayer;
+  ASSERT_TRUE(replayer.Open(path.c_str()));
+  replayer.Bind(replayed_resized, 1);
+  replayer.Bind(replayed_clicked, 0xFFFFFFF0);   // ids are not indices
+
+  ASSERT_TRUE(replayer.CountRecords() == 3000);
+  ASSERT_TRUE(replayer.Replay() == 2000);
+  ASSERT_TRUE(copy.resize_count() == 1000 && copy.click_count() == 1000);
+  ASSERT_TRUE(copy.area() == origin.area());
+
+  remove(path.c_str());
+}
+
+/*
+ * Replay at original speed keeps the interval between emissions
+ */
+TEST_F(Test, replay_original_speed)
+{
+  std::string path = LogPath("speed");
+  Signal<int, int, bool> clicked;
+
+  {
+    EmissionRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.c_str()));
+    recorder.Record(clicked, 0);
+
+    clicked(1, 1, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    clicked(2, 2, false);
+  }
+
+  Widget widget;
+  EmissionReplayer replayer;
+  ASSERT_TRUE(replayer.Open(path.c_str()));
+
+  {
+    Signal<int, int, bool> replayed;
+    replayed.Connect(&widget, &Widget::OnClicked);
+    replayer.Bind(replayed, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(replayer.Replay(EmissionReplayer::kOriginalSpeed) == 2);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(elapsed >= std::chrono::milliseconds(50));
+  }
+
+  // The bound signal was destroyed, records are decoded but reach no receiver
+  ASSERT_TRUE(replayer.Replay() == 2);
+  ASSERT_TRUE(widget.click_count() == 2);
+
+  remove(path.c_str());
+}
+
+/*
+ * A log with a truncated or corrupted record is read up to the record before it
+ */
+TEST_F(Test, truncated_record)
+{
+  std::string path = LogPath("truncated");
+  Signal<int, int, bool> clicked;
+
+  {
+    EmissionRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.c_str()));
+    recorder.Record(clicked, 0);
+    for (int i = 0; i < 10; i++) clicked(i, i, false);
+  }
+
+  // The file header is 2 x uint32_t and the uint64_t data size, then the records:
+  FILE *file = fopen(path.c_str(), "r+b");
+  ASSERT_TRUE(nullptr != file);
+  uint64_t data_size = 0;
+  ASSERT_TRUE(0 == fseek(file, 8, SEEK_SET) && 1 == fread(&data_size, sizeof(data_size), 1, file));
+  const uint64_t record_size = data_size / 10;
+
+  // Cut the payload of the last record:
+  data_size -= 4;
+  ASSERT_TRUE(0 == fseek(file, 8, SEEK_SET) && 1 == fwrite(&data_size, sizeof(data_size), 1, file));
+  fflush(file);
+
+  Widget widget;
+  Signal<int, int, bool> replayed;
+  replayed.Connect(&widget, &Widget::OnClicked);
+  {
+    EmissionReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path.c_str()));
+    replayer.Bind(replayed, 0);
+    ASSERT_TRUE(replayer.CountRecords() == 9);
+    ASSERT_TRUE(replayer.Replay() == 9);
+  }
+
+  // A huge payload size in the header of the 6th record (timestamp, id, size):
+  uint32_t size = 0xFFFFFFF0;
+  ASSERT_TRUE(0 == fseek(file, static_cast<long>(16 + 5 * record_size + 12), SEEK_SET));
+  ASSERT_TRUE(1 == fwrite(&size, sizeof(size), 1, file));
+  fclose(file);
+  {
+    EmissionReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path.c_str()));
+    replayer.Bind(replayed, 0);
+    ASSERT_TRUE(replayer.CountRecords() == 5);
+    ASSERT_TRUE(replayer.Replay() == 5);
+  }
+  ASSERT_TRUE(widget.click_count() == 14);
+
+  remove(path.c_str());
+}
+
+/*
+ * The log of a recorder which was not closed (e.g. the process crashed) can be replayed
+ */
+TEST_F(Test, replay_unclosed_log)
+{
+  std::string path = LogPath("unclosed");
+  Signal<int, int, bool> clicked;
+  Widget widget;
+  Signal<int, int, bool> replayed;
+  replayed.Connect(&widget, &Widget::OnClicked);
+
+  EmissionRecorder recorder;
+  ASSERT_TRUE(recorder.Open(path.c_str(), 64));
+  recorder.Record(clicked, 0);
+  for (int i = 0; i < 100; i++) clicked(i, i, false);
+
+  EmissionReplayer replayer;
+  ASSERT_TRUE(replayer.Open(path.c_str()));
+  replayer.Bind(replayed, 0);
+  ASSERT_TRUE(replayer.CountRecords() == 100);
+  ASSERT_TRUE(replayer.Replay() == 100);
+  ASSERT_TRUE(widget.click_count() == 100);
+
+  recorder.Close();
+  remove(path.c_str());
+}
+
+/*
+ * Emissions recorded by a recorder which is not open are dropped
+ */
+TEST_F(Test, record_without_log)
+{
+  Signal<int, int, bool> clicked;
+  Widget widget;
+  clicked.Connect(&widget, &Widget::OnClicked);
+
+  EmissionRecorder recorder;
+  recorder.Record(clicked, 0);
+  clicked(1, 2, false);
+  ASSERT_TRUE(!recorder.is_open() && recorder.record_count() == 0);
+
+  // Nor after a failed Open():
+  ASSERT_FALSE(recorder.Open("/nonexistent/sigcxx_test.log"));
+  recorder.Record(clicked, 0);
+  clicked(3, 4, true);
+  ASSERT_TRUE(recorder.record_count() == 0);
+  ASSERT_TRUE(widget.click_count() == 2);
+}
@@ -0,0 +1,58 @@
+// Unit test code for EmissionRecorder and EmissionReplayer
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/recorder.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+struct Size {
+  int width;
+  int height;
+};
+
+class Widget: public sigcxx::Trackable
+{
+ public:
+
+  Widget ()
+      : resize_count_(0), click_count_(0), area_(0)
+  { }
+
+  virtual ~Widget () { }
+
+  void OnResized (const Size &size, __SLOT__)
+  {
+    resize_count_++;
+    area_ += size.width * size.height;
+  }
+
+  void OnClicked (int x, int y, bool right, __SLOT__)
+  {
+    click_count_++;
+    if (right) area_ -= x * y;
+  }
+
+  inline size_t resize_count () const { return resize_count_; }
+
+  inline size_t click_count () const { return click_count_; }
+
+  inline long area () const { return area_; }
+
+ private:
+
+  size_t resize_count_;
+  size_t click_count_;
+  long area_;
+};
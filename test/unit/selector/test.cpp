@@ -0,0 +1,165 @@
+// Unit test code for SignalSelector
+
+#include "test.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::SignalRef;
+using sigcxx::SignalSelector;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Take the ready signals in ascending order
+ */
+TEST_F(Test, take)
+{
+  Signal<> finished;
+  Signal<int, const std::string &> message;
+  Signal<double> progress;
+
+  SignalSelector selector(false);
+  int i0 = selector.Add(finished);
+  int i1 = selector.Add(SignalRef<int, const std::string &>(message));
+  int i2 = selector.Add(progress);
+
+  ASSERT_TRUE(i0 == 0 && i1 == 1 && i2 == 2);
+  ASSERT_TRUE(selector.size() == 3);
+  ASSERT_TRUE(!selector.Poll());
+  ASSERT_TRUE(selector.Take() == -1);
+
+  progress(0.5);
+  message(1, "hello");
+  progress(1.0);
+
+  ASSERT_TRUE(selector.Poll());
+  ASSERT_TRUE(selector.IsReady(i1) && selector.IsReady(i2) && !selector.IsReady(i0));
+  ASSERT_TRUE(selector.Take() == i1);
+  ASSERT_TRUE(selector.Take() == i2);
+  ASSERT_TRUE(selector.Take() == -1);
+  ASSERT_TRUE(!selector.Poll());
+}
+
+/*
+ * Thousands of signals in one selector
+ */
+TEST_F(Test, take_all)
+{
+  const int count = 10000;
+  std::vector<std::unique_ptr<Signal<int> > > signals;
+  SignalSelector selector(false);
+
+  for (int i = 0; i < count; i++) {
+    signals.emplace_back(new Signal<int>);
+    ASSERT_TRUE(selector.Add(*signals.back()) == i);
+  }
+
+  for (int i = count - 1; i >= 0; i -= 7) {
+    signals[i]->Emit(i);
+    signals[i]->Emit(i);
+  }
+
+  std::vector<int> ready;
+  size_t n = selector.TakeAll(&ready);
+
+  ASSERT_TRUE(n == ready.size() && n == (count + 6) / 7);
+  for (size_t i = 1; i < ready.size(); i++) {
+    ASSERT_TRUE(ready[i - 1] < ready[i]);
+    ASSERT_TRUE((count - 1 - ready[i]) % 7 == 0);
+  }
+  ASSERT_TRUE(!selector.Poll());
+  ASSERT_TRUE(selector.TakeAll(&ready) == 0);
+}
+
+/*
+ * Signals are disconnected when removed or when the selector is destroyed
+ */
+TEST_F(Test, auto_disconnect)
+{
+  Signal<int> a;
+  Signal<int> b;
+
+  {
+    SignalSelector selector(false);
+    int ia = selector.Add(a);
+    int ib = selector.Add(b);
+
+    ASSERT_TRUE(a.CountConnections() == 1 && b.CountConnections() == 1);
+
+    a(1);
+    selector.Remove(ia);
+    ASSERT_TRUE(a.CountConnections() == 0);
+    ASSERT_TRUE(selector.size() == 1);
+    ASSERT_TRUE(!selector.Poll());
+
+    // The index is reused:
+    ASSERT_TRUE(selector.Add(a) == ia);
+    ASSERT_TRUE(!selector.IsReady(ia));
+
+    b(2);
+    ASSERT_TRUE(selector.Take() == ib);
+  }
+
+  ASSERT_TRUE(a.CountConnections() == 0 && b.CountConnections() == 0);
+
+  // A destroyed signal just never becomes ready:
+  SignalSelector selector(false);
+  {
+    Signal<> temp;
+    selector.Add(temp);
+    temp();
+  }
+  ASSERT_TRUE(selector.Take() == 0);
+}
+
+/*
+ * Block on the event fd until a signal is emitted in another thread
+ */
+TEST_F(Test, wait)
+{
+  const int count = 64;
+  std::vector<std::unique_ptr<Signal<int> > > signals;
+  SignalSelector selector;
+
+  ASSERT_TRUE(selector.fd() >= 0);
+  for (int i = 0; i < count; i++) {
+    signals.emplace_back(new Signal<int>);
+    selector.Add(*signals.back());
+  }
+
+  ASSERT_TRUE(selector.Wait(10) == -1);
+
+  std::thread worker([&signals]() {
+    for (int i = 0; i < count; i++) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      signals[(i * 13) % count]->Emit(i);
+    }
+  });
+
+  std::vector<bool> seen(count, false);
+  int received = 0;
+  while (received < count) {
+    int index = selector.Wait(5000);
+    ASSERT_TRUE(index >= 0);
+    if (!seen[index]) {
+      seen[index] = true;
+      received++;
+    }
+  }
+
+  worker.join();
+  ASSERT_TRUE(selector.Wait(0) == -1);
+}
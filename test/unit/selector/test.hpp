@@ -0,0 +1,18 @@
+// Unit test code for SignalSelector
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/selector.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
@@ -0,0 +1,195 @@
+// Unit test code for ShardedSignal
+
+#include "test.hpp"
+
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using sigcxx::ShardedSignal;
+using sigcxx::internal::EpochDomain;
+
+std::atomic<int> Receiver::violations_(0);
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect, emit and disconnect in one thread
+ */
+TEST_F(Test, connect_and_disconnect)
+{
+  ShardedSignal<int> signal(4);
+  Receiver r1, r2;
+
+  ASSERT_TRUE(signal.shard_count() == 4);
+
+  signal.Connect(&r1, &Receiver::OnValue);
+  signal.Connect(&r2, &Receiver::OnValue);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  ASSERT_TRUE(signal.CountConnections() == 3);
+  ASSERT_TRUE(r2.CountSignalBindings() == 2);
+
+  signal(1);
+  ASSERT_TRUE(r1.count() == 1 && r2.count() == 2);
+
+  ASSERT_TRUE(signal.DisconnectAll(&r2, &Receiver::OnValue) == 2);
+  ASSERT_TRUE(r2.CountSignalBindings() == 0);
+
+  signal(2);
+  ASSERT_TRUE(r1.count() == 2 && r2.count() == 2);
+
+  {
+    Receiver r3;
+    signal.Connect(&r3, &Receiver::OnValue);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+  }
+  ASSERT_TRUE(signal.CountConnections() == 1);
+
+  ASSERT_TRUE(signal.DisconnectAll() == 1);
+  ASSERT_TRUE(r1.CountSignalBindings() == 0);
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * Every thread sees the connections made before it emits, whatever its shard
+ */
+TEST_F(Test, all_shards)
+{
+  ShardedSignal<int> signal(3);
+  Receiver r;
+
+  signal.Connect(&r, &Receiver::OnValue);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 6; i++) {
+    threads.emplace_back([&signal]() { signal.Emit(1); });
+  }
+  for (auto &t : threads) t.join();
+
+  ASSERT_TRUE(r.count() == 6);
+}
+
+/*
+ * Connections changed many times between two emissions, each shard rebuilds its replica from the last state
+ */
+TEST_F(Test, change_between_emissions)
+{
+  ShardedSignal<int> signal(3);
+  std::vector<Receiver> receivers(100);
+
+  auto emit_in_threads = [&signal]() {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 6; i++) {
+      threads.emplace_back([&signal]() { signal.Emit(1); });
+    }
+    for (auto &t : threads) t.join();
+  };
+
+  signal.Connect(&receivers[0], &Receiver::OnValue);
+  emit_in_threads();
+
+  for (size_t i = 1; i < receivers.size(); i++) signal.Connect(&receivers[i], &Receiver::OnValue);
+  for (size_t i = 0; i < receivers.size(); i += 2) signal.DisconnectAll(&receivers[i], &Receiver::OnValue);
+  ASSERT_TRUE(signal.CountConnections() == 50);
+
+  emit_in_threads();
+
+  ASSERT_TRUE(receivers[0].count() == 6);
+  for (size_t i = 1; i < receivers.size(); i++) {
+    ASSERT_TRUE(receivers[i].count() == ((i % 2) ? 6 : 0));
+  }
+
+  ASSERT_TRUE(signal.DisconnectAll() == 50);
+  emit_in_threads();
+  ASSERT_TRUE(receivers[1].count() == 6);
+}
+
+/*
+ * A receiver deleted in its own slot, the next one is still called
+ */
+TEST_F(Test, delete_in_slot)
+{
+  ShardedSignal<int> signal;
+  Receiver *r1 = new Receiver;
+  Receiver r2;
+
+  signal.Connect(r1, &Receiver::OnDeleteThis);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  signal(1);
+
+  ASSERT_TRUE(r2.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+  // The replica being read is freed when the emission left the epoch:
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * A receiver deleted in the slot of another one is not called by the emission in progress
+ */
+TEST_F(Test, delete_next_in_slot)
+{
+  ShardedSignal<int> signal(1);
+  Receiver r1;
+  Receiver *r2 = new Receiver;
+  Receiver r3;
+
+  signal.Connect(&r1, &Receiver::OnDeleteNext);
+  signal.Connect(r2, &Receiver::OnValue);
+  signal.Connect(&r3, &Receiver::OnValue);
+  r1.set_next(r2);
+
+  signal(1);
+
+  ASSERT_TRUE(r1.count() == 1 && r3.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
+
+/*
+ * Receivers destroyed while other threads keep emitting, no slot is called after its destructor returns
+ */
+TEST_F(Test, destroy_while_emitting)
+{
+  typedef std::aligned_storage<sizeof(Receiver), alignof(Receiver)>::type Storage;
+  const int count = 200;
+
+  ShardedSignal<int> signal(2);
+  std::vector<Storage> storage(count);  // kept alive to detect late calls
+  std::atomic<bool> stop(false);
+  Receiver::violations_.store(0);
+
+  std::vector<std::thread> emitters;
+  for (int i = 0; i < 3; i++) {
+    emitters.emplace_back([&signal, &stop]() {
+      while (!stop.load()) signal.Emit(1);
+    });
+  }
+
+  for (int i = 0; i < count; i++) {
+    Receiver *receiver = new(&storage[i]) Receiver;
+    signal.Connect(receiver, &Receiver::OnValue);
+    if (i % 16 == 0) std::this_thread::yield();
+    receiver->~Receiver();
+    receiver->set_destroyed();
+  }
+
+  stop.store(true);
+  for (auto &t : emitters) t.join();
+
+  ASSERT_TRUE(Receiver::violations_.load() == 0);
+  ASSERT_TRUE(signal.CountConnections() == 0);
+
+  EpochDomain::Reclaim();
+  ASSERT_TRUE(EpochDomain::retired_count() == 0);
+}
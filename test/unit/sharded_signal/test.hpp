@@ -0,0 +1,70 @@
+// Unit test code for ShardedSignal
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sharded_signal.hpp>
+
+#include <atomic>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  enum State {
+    kAlive = 1,
+    kDestroyed = 2
+  };
+
+  Receiver ()
+      : state_(kAlive), count_(0), next_(nullptr)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    if (state_.load() != kAlive) violations_++;
+    count_++;
+  }
+
+  void OnDeleteThis (int n, __SLOT__)
+  {
+    count_++;
+    delete this;
+  }
+
+  void OnDeleteNext (int n, __SLOT__)
+  {
+    count_++;
+    delete next_;
+    next_ = nullptr;
+  }
+
+  void set_next (sigcxx::Trackable *next) { next_ = next; }
+
+  void set_destroyed () { state_.store(kDestroyed); }
+
+  inline int count () const { return count_.load(); }
+
+  static std::atomic<int> violations_;
+
+ private:
+
+  std::atomic<int> state_;
+  std::atomic<int> count_;
+
+  sigcxx::Trackable *next_;
+};
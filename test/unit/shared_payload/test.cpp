@@ -0,0 +1,129 @@
+// Unit test code for SharedPayload and PayloadPool
+
+#include "test.hpp"
+
+#include <thread>
+
+using sigcxx::Signal;
+using sigcxx::PayloadPool;
+
+int Frame::alive = 0;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * One payload is shared by all slots
+ */
+TEST_F(Test, share_between_slots)
+{
+  PayloadPool<Frame> pool;
+  Signal<const FramePtr &> frame_ready;
+  Viewer viewers[8];
+
+  for (auto &viewer : viewers) {
+    frame_ready.Connect(&viewer, &Viewer::OnFrame);
+  }
+
+  frame_ready.Emit(pool.Make(640, 480));
+
+  ASSERT_TRUE(Frame::alive == 1 && pool.in_use_count() == 1);
+  for (auto &viewer : viewers) {
+    ASSERT_TRUE(viewer.count() == 1);
+    ASSERT_TRUE(viewer.last().get() == viewers[0].last().get());
+    ASSERT_TRUE(viewer.last()->width == 640);
+  }
+  ASSERT_TRUE(viewers[0].last().use_count() == 8);
+
+  for (auto &viewer : viewers) viewer.clear();
+
+  ASSERT_TRUE(Frame::alive == 0 && pool.in_use_count() == 0 && pool.free_count() == 1);
+}
+
+/*
+ * The memory block is recycled when the last handle is dropped
+ */
+TEST_F(Test, recycle_blocks)
+{
+  PayloadPool<Frame> pool;
+  const Frame *first = nullptr;
+
+  {
+    FramePtr frame = pool.Make(4, 4);
+    first = frame.get();
+  }
+
+  ASSERT_TRUE(pool.free_count() == 1);
+
+  FramePtr frame = pool.Make(8, 8);
+  ASSERT_TRUE(frame.get() == first && pool.free_count() == 0);
+
+  pool.Reserve(16);
+  ASSERT_TRUE(pool.free_count() == 16);
+}
+
+/*
+ * A payload may outlive its pool
+ */
+TEST_F(Test, outlive_pool)
+{
+  FramePtr frame;
+
+  {
+    PayloadPool<Frame> pool;
+    frame = pool.Make(2, 2);
+  }
+
+  ASSERT_TRUE(frame->width == 2 && Frame::alive == 1);
+  frame.Reset();
+  ASSERT_TRUE(Frame::alive == 0);
+}
+
+/*
+ * The block goes back to the pool if the payload constructor throws
+ */
+TEST_F(Test, constructor_throws)
+{
+  PayloadPool<Frame> pool;
+
+  ASSERT_THROW(pool.Make(0, 480), std::invalid_argument);
+  ASSERT_TRUE(Frame::alive == 0);
+  ASSERT_TRUE(pool.in_use_count() == 0 && pool.free_count() == 1);
+
+  FramePtr frame = pool.Make(640, 480);
+  ASSERT_TRUE(pool.in_use_count() == 1 && pool.free_count() == 0);
+}
+
+/*
+ * Release payloads in other threads
+ */
+TEST_F(Test, release_in_threads)
+{
+  PayloadPool<Frame> pool;
+  Signal<const FramePtr &> frame_ready;
+  Viewer viewer;
+  std::vector<FramePtr> queue[4];
+
+  frame_ready.Connect(&viewer, &Viewer::OnFrame);
+
+  for (int i = 0; i < 4000; i++) {
+    frame_ready.Emit(pool.Make(16, 16));
+    queue[i % 4].push_back(viewer.last());
+  }
+  viewer.clear();
+
+  std::thread threads[4];
+  for (int i = 0; i < 4; i++) {
+    threads[i] = std::thread([&queue, i]() { queue[i].clear(); });
+  }
+  for (auto &t : threads) t.join();
+
+  ASSERT_TRUE(Frame::alive == 0 && pool.in_use_count() == 0);
+}
@@ -0,0 +1,73 @@
+// Unit test code for SharedPayload and PayloadPool
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <sigcxx/sigcxx.hpp>
+#include <sigcxx/shared_payload.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+struct Frame {
+
+  static int alive;
+
+  Frame (int w, int h)
+      : width(w), height(h), pixels(static_cast<size_t>(w * h), 0xff)
+  {
+    if (w <= 0 || h <= 0) throw std::invalid_argument("Empty frame");
+    alive++;
+  }
+
+  ~Frame ()
+  {
+    alive--;
+  }
+
+  int width;
+  int height;
+  std::vector<unsigned char> pixels;
+};
+
+typedef sigcxx::SharedPayload<Frame> FramePtr;
+
+class Viewer: public sigcxx::Trackable
+{
+ public:
+
+  Viewer ()
+      : count_(0)
+  { }
+
+  virtual ~Viewer () { }
+
+  void OnFrame (const FramePtr &frame, __SLOT__)
+  {
+    count_++;
+    last_ = frame;   // keep it, e.g. to process later
+  }
+
+  inline size_t count () const { return count_; }
+
+  inline const FramePtr &last () const { return last_; }
+
+  inline void clear () { last_.Reset(); }
+
+ private:
+
+  size_t count_;
+  FramePtr last_;
+};
@@ -0,0 +1,207 @@
+// Unit test code for ShmPublisher and ShmSubscriber
+
+#include "test.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using sigcxx::Signal;
+using sigcxx::ShmRing;
+using sigcxx::ShmPublisher;
+using sigcxx::ShmSubscriber;
+
+typedef ShmPublisher<const Quote &, int> QuotePublisher;
+typedef ShmSubscriber<const Quote &, int> QuoteSubscriber;
+
+static std::string RingName(const char *suffix)
+{
+  return "/sigcxx_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Publish and receive in the same process
+ */
+TEST_F(Test, publish_and_pump)
+{
+  std::string name = RingName("pump");
+  Signal<const Quote &, int> quoted;
+  QuotePublisher publisher;
+  QuoteSubscriber subscriber;
+  Receiver receiver;
+
+  ASSERT_TRUE(publisher.Create(name.c_str(), 64));
+  ASSERT_TRUE(subscriber.Open(name.c_str()));
+
+  quoted.Connect(&publisher, &QuotePublisher::Publish);
+  subscriber.received().Connect(&receiver, &Receiver::OnQuote);
+
+  for (int i = 0; i < 50; i++) {
+    quoted.Emit(Quote{i, i * 0.5}, 42);
+  }
+
+  ASSERT_TRUE(subscriber.Pump() == 50);
+  ASSERT_TRUE(subscriber.Pump() == 0);
+  ASSERT_TRUE(receiver.count() == 50 && receiver.in_order() && subscriber.lost() == 0);
+}
+
+/*
+ * A slow subscriber skips the overwritten messages and counts them as lost
+ */
+TEST_F(Test, detect_loss)
+{
+  std::string name = RingName("loss");
+  QuotePublisher publisher;
+  QuoteSubscriber subscriber;
+  Receiver receiver;
+
+  ASSERT_TRUE(publisher.Create(name.c_str(), 16));
+  ASSERT_TRUE(subscriber.Open(name.c_str()));
+  subscriber.received().Connect(&receiver, &Receiver::OnQuote);
+
+  for (int i = 0; i < 26; i++) {
+    publisher.Publish(Quote{i, i * 0.5}, 42);
+  }
+
+  ASSERT_TRUE(subscriber.Pump() == 16);
+  ASSERT_TRUE(subscriber.lost() == 10);
+  ASSERT_TRUE(receiver.last_id() == 25);
+}
+
+/*
+ * A consumer rejects a ring header which does not fit in the shared memory
+ */
+TEST_F(Test, reject_bad_header)
+{
+  std::string name = RingName("header");
+  ShmRing producer;
+  ShmRing consumer;
+  ASSERT_TRUE(producer.Create(name.c_str(), 16, 24));
+  ASSERT_TRUE(consumer.Open(name.c_str(), 24));
+  consumer.Close();
+
+  // The header is magic, version, then the uint64_t capacity, payload size and stride:
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_TRUE(fd >= 0);
+  void *addr = mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_TRUE(MAP_FAILED != addr);
+  uint64_t *fields = reinterpret_cast<uint64_t *>(addr) + 1;
+  const uint64_t capacity = fields[0];
+  const uint64_t stride = fields[2];
+
+  const uint64_t bad[][2] = {
+      {0, stride},                  // no slot
+      {12, stride},                 // not a power of 2
+      {capacity * 2, stride},       // larger than the shared memory
+      {uint64_t(1) << 62, stride},  // overflows
+      {capacity, 16}                // the payload does not fit in a slot
+  };
+  for (const auto &values : bad) {
+    fields[0] = values[0];
+    fields[2] = values[1];
+    ASSERT_FALSE(consumer.Open(name.c_str(), 24));
+    ASSERT_TRUE(EINVAL == errno);
+  }
+
+  fields[0] = capacity;
+  fields[2] = stride;
+  ASSERT_TRUE(consumer.Open(name.c_str(), 24));
+  munmap(addr, 64);
+}
+
+/*
+ * Create() does not replace a ring in use, Unlink() removes a stale one
+ */
+TEST_F(Test, create_existing)
+{
+  std::string name = RingName("exist");
+  QuotePublisher other;
+
+  {
+    QuotePublisher publisher;
+    QuoteSubscriber subscriber;
+    Receiver receiver;
+
+    ASSERT_TRUE(publisher.Create(name.c_str(), 16));
+    ASSERT_FALSE(other.Create(name.c_str(), 16));
+    ASSERT_TRUE(EEXIST == errno);
+
+    // The first ring is still in use:
+    ASSERT_TRUE(subscriber.Open(name.c_str()));
+    subscriber.received().Connect(&receiver, &Receiver::OnQuote);
+    publisher.Publish(Quote{1, 0.5}, 42);
+    ASSERT_TRUE(subscriber.Pump() == 1);
+  }
+
+  // Left by a producer which crashed:
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  ASSERT_TRUE(fd >= 0);
+  close(fd);
+  ASSERT_FALSE(other.Create(name.c_str(), 16));
+  ASSERT_TRUE(ShmRing::Unlink(name.c_str()));
+  ASSERT_TRUE(other.Create(name.c_str(), 16));
+}
+
+/*
+ * Publish in parent process and receive in a child process
+ */
+TEST_F(Test, cross_process)
+{
+  const int total = 10000;
+  std::string name = RingName("fork");
+  QuotePublisher publisher;
+  int ready[2];
+
+  ASSERT_TRUE(publisher.Create(name.c_str(), 16384));
+  ASSERT_TRUE(pipe(ready) == 0);
+
+  pid_t pid = fork();
+  ASSERT_TRUE(pid >= 0);
+
+  if (pid == 0) {
+    QuoteSubscriber subscriber;
+    Receiver receiver;
+    char c = 1;
+
+    if (!subscriber.Open(name.c_str())) _exit(1);
+    subscriber.received().Connect(&receiver, &Receiver::OnQuote);
+    if (write(ready[1], &c, 1) != 1) _exit(2);
+
+    while (receiver.count() < total) {
+      if (0 == subscriber.Pump()) usleep(100);
+    }
+    _exit((receiver.in_order() && subscriber.lost() == 0) ? 0 : 3);
+  }
+
+  char c = 0;
+  ASSERT_TRUE(read(ready[0], &c, 1) == 1);
+
+  Signal<const Quote &, int> quoted;
+  quoted.Connect(&publisher, &QuotePublisher::Publish);
+  for (int i = 0; i < total; i++) {
+    quoted.Emit(Quote{i, i * 0.5}, 42);
+  }
+
+  int status = 0;
+  ASSERT_TRUE(waitpid(pid, &status, 0) == pid);
+  close(ready[0]);
+  close(ready[1]);
+
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
@@ -0,0 +1,54 @@
+// Unit test code for ShmPublisher and ShmSubscriber
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/shm_channel.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+struct Quote {
+  int id;
+  double price;
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), last_id_(-1), in_order_(true)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnQuote (const Quote &quote, int tag, __SLOT__)
+  {
+    if (quote.id != last_id_ + 1 || quote.price != quote.id * 0.5 || tag != 42)
+      in_order_ = false;
+    last_id_ = quote.id;
+    count_++;
+  }
+
+  inline size_t count () const { return count_; }
+
+  inline int last_id () const { return last_id_; }
+
+  inline bool in_order () const { return in_order_; }
+
+ private:
+
+  size_t count_;
+  int last_id_;
+  bool in_order_;
+};
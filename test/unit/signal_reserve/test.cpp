@@ -0,0 +1,127 @@
+// Unit test code for Signal::Reserve()
+
+#include "test.hpp"
+
+#include <memory>
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::NodeArena;
+using sigcxx::SignalMemoryUsage;
+using sigcxx::TrackableTeardownScope;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connections after Reserve() take their nodes from the block of the signal
+ */
+TEST_F(Test, reserve)
+{
+  const size_t count = 50000;
+
+  Signal<int> signal;
+  SignalMemoryUsage usage = signal.MemoryUsage();
+  ASSERT_TRUE(usage.connection_count == 0 && usage.reserved_count == 0);
+  ASSERT_TRUE(usage.bytes == sizeof(signal));
+
+  signal.Reserve(count);
+  usage = signal.MemoryUsage();
+  ASSERT_TRUE(usage.reserved_count >= count);
+  size_t reserved_bytes = usage.bytes;
+
+  std::vector<Receiver> receivers(count);
+  size_t arena_nodes = NodeArena::GetStats().node_count;
+  for (auto &receiver : receivers) signal.Connect(&receiver, &Receiver::OnValue);
+
+  // Nothing from the arena, nothing more mapped:
+  ASSERT_TRUE(NodeArena::GetStats().node_count == arena_nodes);
+  SignalMemoryUsage full = signal.MemoryUsage();
+  ASSERT_TRUE(full.connection_count == count);
+  ASSERT_TRUE(full.reserved_count == usage.reserved_count - count);
+  ASSERT_TRUE(full.bytes == reserved_bytes);
+
+  signal.Emit(2);
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver.sum() == 2);
+
+  // Once the reserved nodes are used, the block grows by pages:
+  Receiver extra[2];
+  for (size_t i = 0; i < full.reserved_count; i++) signal.Connect(&extra[0], &Receiver::OnValue);
+  ASSERT_TRUE(signal.MemoryUsage().reserved_count == 0);
+  signal.Connect(&extra[1], &Receiver::OnValue);
+  ASSERT_TRUE(NodeArena::GetStats().node_count == arena_nodes);
+  ASSERT_TRUE(signal.MemoryUsage().bytes > reserved_bytes);
+
+  for (size_t i = 0; i < count; i += 2) receivers[i].Unbind();
+  ASSERT_TRUE(signal.CountConnections() == static_cast<int>(count / 2 + full.reserved_count + 1));
+}
+
+/*
+ * ShrinkToFit() returns the unused pages, then the block once empty
+ */
+TEST_F(Test, shrink_to_fit)
+{
+  const size_t count = 50000;
+
+  Signal<int> signal;
+  signal.Reserve(count);
+  std::vector<Receiver> receivers(count / 10);
+  for (auto &receiver : receivers) signal.Connect(&receiver, &Receiver::OnValue);
+
+  size_t before = signal.MemoryUsage().bytes;
+  signal.ShrinkToFit();
+  SignalMemoryUsage usage = signal.MemoryUsage();
+  ASSERT_TRUE(usage.bytes < before);
+  ASSERT_TRUE(usage.connection_count == count / 10);
+  ASSERT_TRUE(usage.reserved_count < sigcxx::internal::NodePool::kPageSize / sizeof(sigcxx::internal::TrackableBindingNode));
+
+  signal.DisconnectAll();
+  signal.ShrinkToFit();
+  usage = signal.MemoryUsage();
+  ASSERT_TRUE(usage.connection_count == 0 && usage.reserved_count == 0);
+  ASSERT_TRUE(usage.bytes == sizeof(signal));
+}
+
+/*
+ * The block outlives its signal until the last node is freed
+ */
+TEST_F(Test, lifetime)
+{
+  std::unique_ptr<Receiver> receivers[8];
+  for (auto &receiver : receivers) receiver.reset(new Receiver);
+
+  // Signal destroyed first:
+  {
+    Signal<int> signal;
+    signal.Reserve(8);
+    for (auto &receiver : receivers) signal.Connect(receiver.get(), &Receiver::OnValue);
+  }
+  for (auto &receiver : receivers) ASSERT_TRUE(receiver->CountSignalBindings() == 0);
+
+  // Receivers destroyed in a teardown scope, which frees their bindings after the signal:
+  {
+    TrackableTeardownScope scope;
+    Signal<int> *signal = new Signal<int>;
+    signal->Reserve(8);
+    for (auto &receiver : receivers) signal->Connect(receiver.get(), &Receiver::OnValue);
+    for (auto &receiver : receivers) receiver.reset();
+    delete signal;
+  }
+
+  // Signal to signal connections use the block too:
+  Signal<int> source;
+  Signal<int> target;
+  source.Reserve(1);
+  source.Connect(target);
+  Receiver receiver;
+  target.Connect(&receiver, &Receiver::OnValue);
+  source.Emit(5);
+  ASSERT_TRUE(receiver.sum() == 5);
+}
@@ -0,0 +1,49 @@
+// Unit test code for Signal::Reserve()
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void Unbind ()
+  {
+    UnbindAllSignals();
+  }
+
+  inline int count () const { return count_; }
+
+  inline long sum () const { return sum_; }
+
+ private:
+
+  int count_;
+  long sum_;
+};
@@ -0,0 +1,126 @@
+// Unit test code for slot methods without the SLOT parameter
+
+#include "test.hpp"
+
+using sigcxx::Signal;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Connect slot methods with or without the SLOT parameter, const or not
+ */
+TEST_F(Test, connect)
+{
+  Signal<int> signal;
+  Receiver r;
+
+  signal.Connect(&r, &Receiver::OnValue);
+  signal.Connect(&r, &Receiver::OnValueConst);
+  signal.Connect(&r, &Receiver::OnValueWithSlot);
+  signal.Connect(&r, &Receiver::OnValueWithSlotConst);
+  signal.Connect(&r, &Receiver::OnValue, 0);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r.count() == 5 && r.sum() == 5);
+
+  ASSERT_TRUE(signal.CountConnections(&r, &Receiver::OnValue) == 2);
+  ASSERT_TRUE(signal.CountConnections(&r, &Receiver::OnValueConst) == 1);
+  ASSERT_TRUE(signal.CountConnections(&r, &Receiver::OnValueWithSlot) == 1);
+  ASSERT_TRUE(signal.IsConnectedTo(&r, &Receiver::OnValueWithSlotConst));
+  ASSERT_TRUE(r.CountSignalBindings(&Receiver::OnValue) == 2);
+  ASSERT_TRUE(r.CountSignalBindings(&Receiver::OnValueWithSlot) == 1);
+
+  ASSERT_TRUE(signal.Disconnect(&r, &Receiver::OnValueConst) == 1);
+  ASSERT_TRUE(!signal.IsConnectedTo(&r, &Receiver::OnValueConst));
+  signal.DisconnectAll(&r, &Receiver::OnValue);
+  ASSERT_TRUE(!signal.IsConnectedTo(&r, &Receiver::OnValue));
+  ASSERT_TRUE(signal.CountConnections() == 2);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r.count() == 7);
+
+  // A signal without parameters:
+  Signal<> event;
+  event.Connect(&r, &Receiver::OnEvent);
+  event.Emit();
+  ASSERT_TRUE(r.count() == 8);
+  ASSERT_TRUE(event.IsConnectedTo(&r, &Receiver::OnEvent));
+}
+
+/*
+ * Delete the receiver being called, or the next one
+ */
+TEST_F(Test, delete_in_slot)
+{
+  Signal<int> signal;
+  Receiver *r1 = new Receiver;
+  Receiver r2;
+  Receiver r3;
+  Receiver *r4 = new Receiver;
+  Receiver r5;
+
+  signal.Connect(r1, &Receiver::OnValueAndDelete);
+  signal.Connect(&r2, &Receiver::OnValue);
+  signal.Connect(&r3, &Receiver::OnValueAndDeleteNext);
+  signal.Connect(r4, &Receiver::OnValue);
+  signal.Connect(&r5, &Receiver::OnValue);
+  r3.set_next(r4);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r2.count() == 1 && r3.count() == 1 && r5.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 3);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r2.count() == 2 && r5.count() == 2);
+}
+
+/*
+ * Disconnect the slot method being called, or delete the signal
+ */
+TEST_F(Test, disconnect_in_slot)
+{
+  Signal<int> *signal = new Signal<int>;
+  Killer k1, k2;
+  Receiver r;
+
+  k1.set_signal(signal);
+  k2.set_signal(signal);
+  signal->Connect(&k1, &Killer::OnValueAndDisconnect);
+  signal->Connect(&r, &Receiver::OnValue);
+  signal->Connect(&k2, &Killer::OnValueAndDeleteSignal);
+  signal->Connect(&r, &Receiver::OnValue);
+
+  signal->Emit(1);
+  ASSERT_TRUE(k1.count() == 1 && k2.count() == 1);
+  ASSERT_TRUE(r.count() == 1);
+  ASSERT_TRUE(r.CountSignalBindings() == 0);
+}
+
+/*
+ * An emission in a slot deletes the receiver the outer emission is on
+ */
+TEST_F(Test, nested_emit)
+{
+  Signal<int> signal;
+  Killer *k = new Killer;
+  Receiver r1, r2;
+
+  k->set_signal(&signal);
+  signal.Connect(k, &Killer::OnValueAndEmit);
+  signal.Connect(&r1, &Receiver::OnValueAndDeleteNext);
+  signal.Connect(&r2, &Receiver::OnValue);
+  r1.set_next(k);
+
+  signal.Emit(1);
+  ASSERT_TRUE(r1.count() == 2);
+  ASSERT_TRUE(r2.count() == 2 && r2.sum() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+}
@@ -0,0 +1,130 @@
+// Unit test code for slot methods without the SLOT parameter
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+/**
+ * @brief A receiver with slot methods of all kinds
+ */
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0), next_(nullptr)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnValueConst (int n) const
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnValueWithSlot (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnValueWithSlotConst (int n, __SLOT__) const
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnEvent ()
+  {
+    count_++;
+  }
+
+  void OnValueAndDelete (int n)
+  {
+    count_++;
+    delete this;
+  }
+
+  void OnValueAndDeleteNext (int n)
+  {
+    count_++;
+    delete next_;
+    next_ = nullptr;
+  }
+
+  void set_next (sigcxx::Trackable *next) { next_ = next; }
+
+  int count () const { return count_; }
+
+  int sum () const { return sum_; }
+
+ private:
+
+  mutable int count_;
+  mutable int sum_;
+
+  sigcxx::Trackable *next_;
+};
+
+/**
+ * @brief A receiver disconnecting or deleting a signal in its slot method
+ */
+class Killer: public sigcxx::Trackable
+{
+ public:
+
+  Killer ()
+      : count_(0), signal_(nullptr)
+  { }
+
+  virtual ~Killer () { }
+
+  void set_signal (sigcxx::Signal<int> *signal) { signal_ = signal; }
+
+  void OnValueAndDisconnect (int n)
+  {
+    count_++;
+    signal_->Disconnect(this, &Killer::OnValueAndDisconnect);
+  }
+
+  void OnValueAndDeleteSignal (int n)
+  {
+    count_++;
+    delete signal_;
+    signal_ = nullptr;
+  }
+
+  void OnValueAndEmit (int n)
+  {
+    count_++;
+    if (n > 0) signal_->Emit(n - 1);
+  }
+
+  int count () const { return count_; }
+
+ private:
+
+  int count_;
+
+  sigcxx::Signal<int> *signal_;
+};
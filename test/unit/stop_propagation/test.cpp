@@ -0,0 +1,79 @@
+// Unit test code for Slot::StopPropagation()
+
+#include "test.hpp"
+
+using sigcxx::Signal;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * The slots after the one which handles the event are skipped
+ */
+TEST_F(Test, stop)
+{
+  Signal<int> key_pressed;
+  Handler first(1), second(2), third;
+  key_pressed.Connect(&first, &Handler::OnKey);
+  key_pressed.Connect(&second, &Handler::OnKey);
+  key_pressed.Connect(&third, &Handler::OnKey);
+
+  key_pressed(1);
+  ASSERT_TRUE(first.count() == 1 && second.count() == 0 && third.count() == 0);
+
+  key_pressed(2);
+  ASSERT_TRUE(first.count() == 2 && second.count() == 1 && third.count() == 0);
+
+  // Each emission starts again:
+  key_pressed(3);
+  ASSERT_TRUE(first.count() == 3 && second.count() == 2 && third.count() == 1);
+}
+
+/*
+ * Stopping in a chained signal stops the signals it's connected from
+ */
+TEST_F(Test, chained)
+{
+  Signal<int> window;
+  Signal<int> widget;
+  Handler button(1), after_widget, after_window;
+
+  window.Connect(widget);
+  window.Connect(&after_window, &Handler::OnKey);
+  widget.Connect(&button, &Handler::OnKey);
+  widget.Connect(&after_widget, &Handler::OnKey);
+
+  window(1);
+  ASSERT_TRUE(button.count() == 1);
+  ASSERT_TRUE(after_widget.count() == 0 && after_window.count() == 0);
+
+  window(2);
+  ASSERT_TRUE(button.count() == 2);
+  ASSERT_TRUE(after_widget.count() == 1 && after_window.count() == 1);
+}
+
+/*
+ * A slot can stop the propagation and delete its receiver
+ */
+TEST_F(Test, delete_this)
+{
+  Signal<int> key_pressed;
+  Handler *handler = new Handler;
+  Handler after;
+  key_pressed.Connect(handler, &Handler::OnKeyDeleteThis);
+  key_pressed.Connect(&after, &Handler::OnKey);
+
+  key_pressed(1);
+  ASSERT_TRUE(after.count() == 0);
+  ASSERT_TRUE(key_pressed.CountConnections() == 1);
+
+  key_pressed(1);
+  ASSERT_TRUE(after.count() == 1);
+}
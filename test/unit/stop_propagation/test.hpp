@@ -0,0 +1,48 @@
+// Unit test code for Slot::StopPropagation()
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Handler: public sigcxx::Trackable
+{
+ public:
+
+  explicit Handler (int key = -1)
+      : key_(key), count_(0)
+  { }
+
+  virtual ~Handler () { }
+
+  void OnKey (int key, __SLOT__)
+  {
+    count_++;
+    if (key == key_) slot->StopPropagation();
+  }
+
+  void OnKeyDeleteThis (int key, __SLOT__)
+  {
+    slot->StopPropagation();
+    delete this;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int key_;
+  int count_;
+};
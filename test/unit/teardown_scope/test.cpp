@@ -0,0 +1,216 @@
+// Unit test code for TrackableTeardownScope
+
+#include "test.hpp"
+
+#include <sigcxx/concurrent_signal.hpp>
+
+#include <vector>
+
+using sigcxx::Signal;
+using sigcxx::ConcurrentSignal;
+using sigcxx::TrackableTeardownScope;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Dead tokens are invisible while the scope is alive, and released when it ends
+ */
+TEST_F(Test, defer)
+{
+  Signal<int> signal;
+  std::vector<Receiver *> receivers;
+  for (int i = 0; i < 10; i++) {
+    receivers.push_back(new Receiver);
+    signal.Connect(receivers.back(), &Receiver::OnValue);
+  }
+
+  {
+    TrackableTeardownScope scope;
+    ASSERT_TRUE(TrackableTeardownScope::current() == &scope);
+
+    // Adjacent runs and single tokens:
+    for (int i : {0, 1, 2, 5, 7, 8}) delete receivers[i];
+    ASSERT_TRUE(scope.pending_count() == 6);
+    ASSERT_TRUE(signal.CountConnections() == 4);
+
+    signal(1);
+    for (int i : {3, 4, 6, 9}) ASSERT_TRUE(receivers[i]->count() == 1);
+
+    signal.DisconnectAll(receivers[4], &Receiver::OnValue);
+    ASSERT_TRUE(signal.CountConnections() == 3);
+  }
+
+  ASSERT_TRUE(TrackableTeardownScope::current() == nullptr);
+  ASSERT_TRUE(signal.CountConnections() == 3);
+  ASSERT_TRUE(signal.Disconnect(-1, 10) == 3);
+
+  for (int i : {3, 4, 6, 9}) delete receivers[i];
+}
+
+/*
+ * A signal destroyed in the scope frees its dead tokens itself
+ */
+TEST_F(Test, destroy_signal)
+{
+  Signal<int> *signal = new Signal<int>;
+  Signal<int> other;
+  Receiver r1;
+
+  {
+    TrackableTeardownScope scope;
+    Receiver *r2 = new Receiver;
+    signal->Connect(r2, &Receiver::OnValue);
+    signal->Connect(&r1, &Receiver::OnValue);
+    other.Connect(*signal);
+
+    delete r2;
+    ASSERT_TRUE(scope.pending_count() == 1);
+
+    // Its token in the other signal is left dead:
+    delete signal;
+    ASSERT_TRUE(scope.pending_count() == 2);
+    ASSERT_TRUE(other.CountConnections() == 0);
+
+    other(1);
+    ASSERT_TRUE(r1.count() == 0);
+  }
+
+  ASSERT_TRUE(r1.CountSignalBindings() == 0);
+}
+
+/*
+ * Receivers deleted in their slots, with a scope around or in the slot
+ */
+TEST_F(Test, delete_in_slot)
+{
+  Signal<int> signal;
+  Receiver r1, r2;
+
+  signal.Connect(new Receiver, &Receiver::OnDeleteThis);
+  signal.Connect(&r1, &Receiver::OnValue);
+  signal.Connect(new Receiver, &Receiver::OnDeleteThisInScope);
+  signal.Connect(new Receiver, &Receiver::OnDeleteThisInScope);
+  signal.Connect(&r2, &Receiver::OnValue);
+
+  {
+    TrackableTeardownScope scope;
+    signal(1);
+    ASSERT_TRUE(signal.CountConnections() == 2);
+  }
+
+  ASSERT_TRUE(r1.count() == 1 && r2.count() == 1);
+
+  // The scope ends while its token is being emitted:
+  signal.Connect(new Receiver, &Receiver::OnDeleteThisInScope);
+  signal.Connect(new Receiver, &Receiver::OnDeleteThisInScope);
+  signal(2);
+
+  ASSERT_TRUE(r1.count() == 2 && r2.count() == 2);
+  ASSERT_TRUE(signal.CountConnections() == 2);
+}
+
+/*
+ * Only the outermost scope releases tokens
+ */
+TEST_F(Test, nested)
+{
+  Signal<int> signal;
+  Receiver r;
+  signal.Connect(&r, &Receiver::OnValue);
+
+  {
+    TrackableTeardownScope outer;
+    {
+      TrackableTeardownScope inner;
+      ASSERT_TRUE(TrackableTeardownScope::current() == &outer);
+      Receiver *tmp = new Receiver;
+      signal.Connect(tmp, &Receiver::OnValue);
+      delete tmp;
+    }
+    ASSERT_TRUE(outer.pending_count() == 1);
+    signal(1);
+  }
+
+  ASSERT_TRUE(r.count() == 1);
+  ASSERT_TRUE(signal.CountConnections() == 1);
+}
+
+/*
+ * Positions given to Connect() and Disconnect() don't count the dead tokens
+ */
+TEST_F(Test, positions)
+{
+  Receiver r1, r2, r3, r4;
+  Signal<int> signal;
+
+  {
+    TrackableTeardownScope scope;
+    Receiver *dead1 = new Receiver;
+    Receiver *dead2 = new Receiver;
+    signal.Connect(dead1, &Receiver::OnValue);
+    signal.Connect(&r1, &Receiver::OnValue);
+    signal.Connect(dead2, &Receiver::OnValue);
+    signal.Connect(&r2, &Receiver::OnValue);
+    delete dead1;
+    delete dead2;
+
+    // Between r1 and r2:
+    signal.Connect(&r3, &Receiver::OnValue, 1);
+    ASSERT_TRUE(signal.Disconnect(0, 1) == 1);
+    ASSERT_FALSE(signal.IsConnectedTo(&r1));
+    ASSERT_TRUE(signal.IsConnectedTo(&r3));
+
+    // r3 and r2 are left, the second one is r2:
+    ASSERT_TRUE(signal.Disconnect(1, 1) == 1);
+    ASSERT_FALSE(signal.IsConnectedTo(&r2));
+    ASSERT_TRUE(signal.IsConnectedTo(&r3));
+  }
+
+  {
+    TrackableTeardownScope scope;
+    Receiver *dead1 = new Receiver;
+    Receiver *dead2 = new Receiver;
+    signal.Connect(dead1, &Receiver::OnValue);
+    signal.Connect(&r1, &Receiver::OnValue);
+    signal.Connect(dead2, &Receiver::OnValue);
+    delete dead1;
+    delete dead2;
+
+    // Between r3 and r1:
+    signal.Connect(&r4, &Receiver::OnValue, -2);
+    ASSERT_TRUE(signal.Disconnect(-1, 1) == 1);
+    ASSERT_FALSE(signal.IsConnectedTo(&r1));
+    ASSERT_TRUE(signal.IsConnectedTo(&r4));
+
+    ASSERT_TRUE(signal.Disconnect(-2, 1) == 1);
+    ASSERT_FALSE(signal.IsConnectedTo(&r3));
+    ASSERT_TRUE(signal.IsConnectedTo(&r4));
+  }
+
+  ASSERT_TRUE(signal.CountConnections() == 1);
+}
+
+/*
+ * Connections of a ConcurrentSignal are still broken immediately
+ */
+TEST_F(Test, concurrent_signal)
+{
+  ConcurrentSignal<int> signal;
+
+  {
+    TrackableTeardownScope scope;
+    Receiver *r = new Receiver;
+    signal.Connect(r, &Receiver::OnValue);
+    delete r;
+    ASSERT_TRUE(scope.pending_count() == 0);
+    ASSERT_TRUE(signal.CountConnections() == 0);
+  }
+}
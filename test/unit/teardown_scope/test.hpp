@@ -0,0 +1,52 @@
+// Unit test code for TrackableTeardownScope
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/sigcxx.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+  }
+
+  void OnDeleteThis (int n, __SLOT__)
+  {
+    count_++;
+    delete this;
+  }
+
+  void OnDeleteThisInScope (int n, __SLOT__)
+  {
+    sigcxx::TrackableTeardownScope scope;
+    delete this;
+  }
+
+  inline int count () const { return count_; }
+
+ private:
+
+  int count_;
+};
@@ -0,0 +1,91 @@
+// Unit test code for thread affinity
+
+#include "test.hpp"
+
+#include <thread>
+
+using sigcxx::Signal;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+/*
+ * Confined objects used in the owner thread, then handed over to a worker and back
+ */
+TEST_F(Test, move_to_thread)
+{
+  Signal<int> signal;
+  Receiver receiver;
+
+  signal.SetThreadAffinity();
+  receiver.SetThreadAffinity();
+  ASSERT_TRUE(signal.IsOnOwnerThread() && receiver.IsOnOwnerThread());
+
+  signal.Connect(&receiver, &Receiver::OnValue);
+  signal(1);
+
+  // Let the worker take them:
+  signal.ClearThreadAffinity();
+  receiver.ClearThreadAffinity();
+
+  std::thread::id main_thread = std::this_thread::get_id();
+  std::thread worker([&signal, &receiver, main_thread]() {
+    signal.SetThreadAffinity();
+    receiver.SetThreadAffinity();
+
+    signal(2);
+    signal.Disconnect();
+    signal.Connect(&receiver, &Receiver::OnValue);
+
+    signal.MoveToThread(main_thread);
+    receiver.MoveToThread(main_thread);
+  });
+  worker.join();
+
+  ASSERT_TRUE(signal.IsOnOwnerThread() && receiver.IsOnOwnerThread());
+  signal(3);
+  ASSERT_TRUE(receiver.count() == 3);
+}
+
+#ifdef __DEBUG__
+
+/*
+ * Emitting a confined signal in another thread asserts in a debug build
+ */
+TEST_F(Test, emit_in_other_thread)
+{
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+  ASSERT_DEATH({
+    Signal<int> signal;
+    signal.SetThreadAffinity();
+    std::thread worker([&signal]() { signal(1); });
+    worker.join();
+  }, "");
+}
+
+/*
+ * Destroying a confined receiver in another thread asserts in a debug build
+ */
+TEST_F(Test, destroy_in_other_thread)
+{
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+  ASSERT_DEATH({
+    Signal<int> signal;
+    Receiver *receiver = new Receiver;
+    signal.Connect(receiver, &Receiver::OnValue);
+    receiver->SetThreadAffinity();
+    std::thread worker([receiver]() { delete receiver; });
+    worker.join();
+  }, "");
+}
+
+#endif // __DEBUG__
@@ -0,0 +1,111 @@
+// Unit test code for wiring tables
+
+#include "test.hpp"
+
+#include <vector>
+
+using sigcxx::ApplyWiring;
+using sigcxx::NodeArena;
+using sigcxx::WiringEntry;
+
+Test::Test()
+    : testing::Test()
+{
+}
+
+Test::~Test()
+{
+
+}
+
+namespace {
+
+sigcxx::Signal<> &GetNotify(Context &context)
+{
+  return context.notify;
+}
+
+Receiver *GetExternal(Context &context)
+{
+  return context.external;
+}
+
+constexpr WiringEntry<Context> kWiring[] = {
+    WIZTK_WIRE(&Context::value, &Context::first, &Receiver::OnValue),
+    WIZTK_WIRE(&Context::value, &Context::second, &Receiver::OnValue),
+    WIZTK_WIRE(&Context::pair, &Context::first, &Receiver::OnPair),
+    WIZTK_WIRE(&GetNotify, &Context::external, &Receiver::OnNotify),
+    WIZTK_WIRE(&Context::value, &GetExternal, &Receiver::OnValue),
+};
+
+static_assert(sizeof(kWiring) / sizeof(kWiring[0]) == 5, "The table is built at compile time");
+
+}  // namespace
+
+/*
+ * Apply a table to one context, with every kind of accessor
+ */
+TEST_F(Test, apply)
+{
+  Receiver external;
+  Context context;
+  context.external = &external;
+
+  ApplyWiring(context, kWiring);
+
+  ASSERT_TRUE(context.value.CountConnections() == 3);
+  ASSERT_TRUE(context.pair.CountConnections() == 1);
+  ASSERT_TRUE(context.notify.CountConnections() == 1);
+  ASSERT_TRUE(external.CountSignalBindings() == 2);
+
+  context.value.Emit(2);
+  context.pair.Emit(1, 3.0);
+  context.notify.Emit();
+
+  ASSERT_TRUE(context.first.count() == 2 && context.first.sum() == 6);
+  ASSERT_TRUE(context.second.count() == 1 && context.second.sum() == 2);
+  ASSERT_TRUE(external.count() == 2 && external.sum() == 2);
+}
+
+/*
+ * Connections are made in the order of the table and disconnect as usual
+ */
+TEST_F(Test, order)
+{
+  Receiver external;
+  Context context;
+  context.external = &external;
+
+  ApplyWiring(context, kWiring);
+
+  ASSERT_TRUE(context.value.IsConnectedTo(&context.first, &Receiver::OnValue) &&
+      context.value.IsConnectedTo(&external, &Receiver::OnValue));
+
+  context.value.Disconnect(static_cast<Receiver *>(&context.second), &Receiver::OnValue);
+  ASSERT_TRUE(context.value.CountConnections() == 2);
+  ASSERT_TRUE(context.second.CountSignalBindings() == 0);
+}
+
+/*
+ * Apply a table to a range of contexts, with the pages reserved at once
+ */
+TEST_F(Test, range)
+{
+  const size_t count = 1000;
+
+  std::vector<Receiver> externals(count);
+  std::vector<Context> contexts(count);
+  for (size_t i = 0; i < count; i++) contexts[i].external = &externals[i];
+
+  NodeArena::TrimMemory();
+  ApplyWiring(contexts.begin(), contexts.end(), kWiring);
+
+  sigcxx::NodeArenaStats stats = NodeArena::GetStats();
+  ASSERT_TRUE(stats.node_count >= 2 * 5 * count);
+
+  for (size_t i = 0; i < count; i++) {
+    contexts[i].value.Emit(1);
+    ASSERT_TRUE(externals[i].count() == 1);
+    ASSERT_TRUE(contexts[i].first.count() == 1 && contexts[i].second.count() == 1);
+  }
+}
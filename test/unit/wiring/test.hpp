@@ -0,0 +1,78 @@
+// Unit test code for wiring tables
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <sigcxx/wiring.hpp>
+
+class Test: public testing::Test
+{
+ public:
+  Test ();
+  virtual ~Test();
+
+ protected:
+  virtual void SetUp() {  }
+  virtual void TearDown() {  }
+};
+
+class Receiver: public sigcxx::Trackable
+{
+ public:
+
+  Receiver ()
+      : count_(0), sum_(0)
+  { }
+
+  virtual ~Receiver () { }
+
+  void OnValue (int n, __SLOT__)
+  {
+    count_++;
+    sum_ += n;
+  }
+
+  void OnPair (int a, double b, __SLOT__)
+  {
+    count_++;
+    sum_ += a + static_cast<long>(b);
+  }
+
+  void OnNotify (__SLOT__)
+  {
+    count_++;
+  }
+
+  inline int count () const { return count_; }
+
+  inline long sum () const { return sum_; }
+
+ private:
+
+  int count_;
+  long sum_;
+};
+
+class SubReceiver: public Receiver
+{
+ public:
+
+  SubReceiver () { }
+
+  virtual ~SubReceiver () { }
+};
+
+/*
+ * The context of a wiring table: owns the signals and the receivers
+ */
+struct Context
+{
+  sigcxx::Signal<int> value;
+  sigcxx::Signal<int, double> pair;
+  sigcxx::Signal<> notify;
+
+  Receiver first;
+  SubReceiver second;
+  Receiver *external = nullptr;
+};